@@ -0,0 +1,263 @@
+#include "CheckpointStore.hpp"
+#include "Game.hpp"
+#include "../utils/Random.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+// Entries a live history writes into after a snapshot; the first write copies
+// one chunk of each shared history.
+constexpr size_t HISTORY_CHUNK_ENTRIES = 64;
+
+void mix(uint64_t& hash, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (bits >> (i * 8)) & 0xff;
+        hash *= 1099511628211ULL;
+    }
+}
+
+}
+
+CheckpointStore::CheckpointStore(CheckpointOptions options)
+    : options(options),
+      memoryUsage(0),
+      pendingExternalChange(false),
+      lastFingerprint(0)
+{
+    this->options.interval = std::max(1, this->options.interval);
+}
+
+uint64_t CheckpointStore::fingerprint(const Game& game) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    auto market = game.getMarket();
+    if (market) {
+        const MarketState& state = market->getState();
+        mix(hash, state.indexValue);
+        mix(hash, state.dailyChange);
+        mix(hash, static_cast<double>(state.currentTrend));
+        mix(hash, state.trendDuration);
+        mix(hash, state.interestRate);
+        mix(hash, state.inflationRate);
+        mix(hash, state.unemploymentRate);
+        mix(hash, market->getCurrentDay());
+
+        for (double trend : market->getSectorTrends()) {
+            mix(hash, trend);
+        }
+
+        for (const auto& company : market->getCompanies()) {
+            const Stock* stock = company->getStock();
+            mix(hash, stock->getCurrentPrice());
+            mix(hash, stock->getHighestPrice());
+            mix(hash, stock->getLowestPrice());
+        }
+    }
+
+    auto newsService = game.getNewsService();
+    if (newsService) {
+        mix(hash, static_cast<double>(newsService->getNewsHistory().size()));
+    }
+
+    auto priceService = game.getPriceService();
+    if (priceService) {
+        mix(hash, priceService->getMarketVolatilityFactor());
+        mix(hash, priceService->getTrendStrength());
+        mix(hash, priceService->getMomentumFactor());
+        mix(hash, priceService->getRandomnessFactor());
+    }
+
+    return hash;
+}
+
+size_t CheckpointStore::estimateBytes(const Player& player) {
+    size_t bytes = sizeof(Player) + sizeof(Portfolio);
+    bytes += player.getLoans().size() * sizeof(Loan);
+
+    const Portfolio* portfolio = player.getPortfolio();
+    for (const auto& entry : portfolio->getPositions()) {
+        bytes += sizeof(entry) + entry.first.capacity();
+    }
+    bytes += HISTORY_CHUNK_ENTRIES * (sizeof(PortfolioHistory) + sizeof(Transaction));
+    return bytes;
+}
+
+size_t CheckpointStore::estimateBytes(const std::vector<StrategyAccountSnapshot>& accounts) {
+    size_t bytes = accounts.capacity() * sizeof(StrategyAccountSnapshot);
+    for (const auto& account : accounts) {
+        bytes += estimateBytes(*account.player);
+    }
+    return bytes;
+}
+
+size_t CheckpointStore::estimateBytes(const Game& game) {
+    size_t bytes = sizeof(Game) + sizeof(Market) + sizeof(NewsService) + sizeof(PriceService);
+
+    auto market = game.getMarket();
+    if (market) {
+        size_t perCompany = sizeof(Company) + sizeof(Stock) + HISTORY_CHUNK_ENTRIES * sizeof(double);
+        bytes += market->getCompanies().size() * perCompany;
+    }
+
+    bytes += HISTORY_CHUNK_ENTRIES * sizeof(News);
+
+    auto player = game.getPlayer();
+    if (player) {
+        bytes += estimateBytes(*player);
+    }
+    return bytes;
+}
+
+void CheckpointStore::beginDay(const Game& game) {
+    pendingRandomState = Random::getState();
+    pendingExternalChange = !segments.empty() && fingerprint(game) != lastFingerprint;
+}
+
+void CheckpointStore::endDay(const Game& game) {
+    int day = game.getSimulatedDays();
+    if (!segments.empty() && day <= getLatestDay()) {
+        truncateAfter(day - 1);
+    }
+
+    uint64_t currentFingerprint = fingerprint(game);
+
+    bool full = segments.empty() || pendingExternalChange || pendingRandomState.empty() ||
+                getLatestDay() != day - 1 || day - segments.back().day >= options.interval;
+
+    if (full) {
+        CheckpointSegment segment;
+        segment.day = day;
+        segment.randomState = pendingRandomState;
+        segment.snapshot = game.branch();
+        segment.accounts = game.getStrategyEngine().snapshot();
+        segment.bytes = estimateBytes(game) + estimateBytes(segment.accounts) + pendingRandomState.capacity();
+        memoryUsage += segment.bytes;
+        segments.push_back(std::move(segment));
+    } else {
+        auto player = std::make_shared<Player>(*game.getPlayer());
+        auto accounts = game.getStrategyEngine().snapshot();
+        size_t bytes = estimateBytes(*player) + estimateBytes(accounts) + pendingRandomState.capacity();
+
+        CheckpointSegment& segment = segments.back();
+        segment.deltas.push_back({day, std::move(pendingRandomState), player, std::move(accounts),
+                                  currentFingerprint});
+        segment.bytes += bytes;
+        memoryUsage += bytes;
+    }
+
+    pendingRandomState.clear();
+    pendingExternalChange = false;
+    lastFingerprint = currentFingerprint;
+
+    enforceBudget();
+}
+
+void CheckpointStore::enforceBudget() {
+    while (memoryUsage > options.memoryBudget && segments.size() > 1) {
+        memoryUsage -= segments.front().bytes;
+        segments.pop_front();
+    }
+}
+
+const CheckpointSegment* CheckpointStore::findSegment(int day) const {
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        if (it->day > day) {
+            continue;
+        }
+        int lastDay = it->deltas.empty() ? it->day : it->deltas.back().day;
+        return day <= lastDay ? &*it : nullptr;
+    }
+    return nullptr;
+}
+
+bool CheckpointStore::contains(int day) const {
+    return findSegment(day) != nullptr;
+}
+
+bool CheckpointStore::findRandomState(int day, std::string& state) const {
+    const CheckpointSegment* segment = findSegment(day);
+    if (!segment) {
+        return false;
+    }
+
+    if (segment->day == day) {
+        state = segment->randomState;
+    } else {
+        state = segment->deltas[day - segment->day - 1].randomState;
+    }
+    return !state.empty();
+}
+
+void CheckpointStore::truncateAfter(int day) {
+    while (!segments.empty() && segments.back().day > day) {
+        memoryUsage -= segments.back().bytes;
+        segments.pop_back();
+    }
+
+    if (segments.empty()) {
+        lastFingerprint = 0;
+    } else {
+        CheckpointSegment& segment = segments.back();
+        while (!segment.deltas.empty() && segment.deltas.back().day > day) {
+            size_t bytes = estimateBytes(*segment.deltas.back().player) +
+                           estimateBytes(segment.deltas.back().accounts) +
+                           segment.deltas.back().randomState.capacity();
+            segment.bytes -= std::min(bytes, segment.bytes);
+            memoryUsage -= std::min(bytes, memoryUsage);
+            segment.deltas.pop_back();
+        }
+
+        lastFingerprint = segment.deltas.empty() ? fingerprint(*segment.snapshot)
+                                                 : segment.deltas.back().fingerprint;
+    }
+
+    pendingRandomState.clear();
+    pendingExternalChange = false;
+}
+
+void CheckpointStore::clear() {
+    segments.clear();
+    memoryUsage = 0;
+    pendingRandomState.clear();
+    pendingExternalChange = false;
+    lastFingerprint = 0;
+}
+
+int CheckpointStore::getEarliestDay() const {
+    return segments.empty() ? -1 : segments.front().day;
+}
+
+int CheckpointStore::getLatestDay() const {
+    if (segments.empty()) {
+        return -1;
+    }
+    const CheckpointSegment& segment = segments.back();
+    return segment.deltas.empty() ? segment.day : segment.deltas.back().day;
+}
+
+size_t CheckpointStore::getCheckpointCount() const {
+    return segments.size();
+}
+
+size_t CheckpointStore::getDeltaCount() const {
+    size_t count = 0;
+    for (const auto& segment : segments) {
+        count += segment.deltas.size();
+    }
+    return count;
+}
+
+size_t CheckpointStore::getMemoryUsage() const {
+    return memoryUsage;
+}
+
+const CheckpointOptions& CheckpointStore::getOptions() const {
+    return options;
+}
+
+}
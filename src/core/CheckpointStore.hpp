@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include "StrategyEngine.hpp"
+
+namespace StockMarketSimulator {
+
+class Game;
+class Player;
+
+struct CheckpointOptions {
+    int interval = 10;
+    size_t memoryBudget = 64 * 1024 * 1024;
+};
+
+// One simulated day between full checkpoints. Market, news and price-service
+// state are regenerated by replaying the day from the recorded generator
+// state; the player, whose state also depends on user actions, is kept as a
+// copy that shares its ledgers with the previous day, and so are the
+// strategy accounts.
+struct DayDelta {
+    int day;
+    std::string randomState;
+    std::shared_ptr<const Player> player;
+    std::vector<StrategyAccountSnapshot> accounts;
+    uint64_t fingerprint;
+};
+
+// A full branch of the game at the end of `day` plus the deltas that follow.
+struct CheckpointSegment {
+    int day;
+    std::string randomState;
+    std::shared_ptr<Game> snapshot;
+    std::vector<StrategyAccountSnapshot> accounts;
+    std::vector<DayDelta> deltas;
+    size_t bytes;
+};
+
+// In-memory rewind history recorded around Game::simulateDay(). A full
+// checkpoint is taken every `interval` days, or sooner when the market was
+// changed between days in a way a replay could not reproduce. The oldest
+// segments are dropped once the estimated footprint exceeds the budget.
+class CheckpointStore {
+private:
+    CheckpointOptions options;
+    std::deque<CheckpointSegment> segments;
+    size_t memoryUsage;
+
+    std::string pendingRandomState;
+    bool pendingExternalChange;
+    uint64_t lastFingerprint;
+
+    static size_t estimateBytes(const Player& player);
+    static size_t estimateBytes(const std::vector<StrategyAccountSnapshot>& accounts);
+    static size_t estimateBytes(const Game& game);
+    void enforceBudget();
+
+public:
+    explicit CheckpointStore(CheckpointOptions options = CheckpointOptions());
+
+    void beginDay(const Game& game);
+    void endDay(const Game& game);
+
+    const CheckpointSegment* findSegment(int day) const;
+    bool contains(int day) const;
+    bool findRandomState(int day, std::string& state) const;
+    void truncateAfter(int day);
+    void clear();
+
+    int getEarliestDay() const;
+    int getLatestDay() const;
+    size_t getCheckpointCount() const;
+    size_t getDeltaCount() const;
+    size_t getMemoryUsage() const;
+    const CheckpointOptions& getOptions() const;
+
+    // Hash of the replayable state: prices, market scalars, news count and
+    // price-service settings. Price histories are left out so the hash never
+    // pages in a lazily loaded history.
+    static uint64_t fingerprint(const Game& game);
+};
+
+}
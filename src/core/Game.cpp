@@ -1,6 +1,9 @@
 #include "Game.hpp"
+#include "../utils/Profiler.hpp"
+#include "../utils/Random.hpp"
 #include <algorithm>
 #include <stdexcept>
+#include <thread>
 
 namespace StockMarketSimulator {
 
@@ -8,7 +11,9 @@ Game::Game()
     : status(GameStatus::NotStarted),
       gameSpeed(1),
       simulatedDays(0),
-      startDate(Date(1, 3, 2023))
+      startDate(Date(1, 3, 2023)),
+      fusedPipeline(false),
+      parallelSeed(0)
 {
 }
 
@@ -16,6 +21,10 @@ void Game::initialize(const std::string& playerName, double initialBalance) {
     try {
         FileIO::clearLog();
         FileIO::appendToLog("Game initialization started");
+        strategyEngine.clear();
+        if (checkpoints) {
+            checkpoints->clear();
+        }
         market = std::make_shared<Market>();
         market->addDefaultCompanies();
 
@@ -25,6 +34,8 @@ void Game::initialize(const std::string& playerName, double initialBalance) {
 
         priceService = std::make_shared<PriceService>(market);
         priceService->initialize();
+        applyParallelMode();
+        market->setSharedFeed(sharedFeed);
 
         for (const auto& company : market->getCompanies()) {
             company->initializeDividendSchedule(startDate);
@@ -42,6 +53,7 @@ void Game::initialize(const std::string& playerName, double initialBalance) {
 
         saveService = std::make_shared<SaveService>(market, player, newsService, priceService);
         saveService->initialize();
+        saveService->removeUnfinishedSaves();
 
         status = GameStatus::NotStarted;
         simulatedDays = 0;
@@ -84,33 +96,122 @@ bool Game::simulateDay() {
     }
 
     try {
-        auto dailyNews = newsService->generateDailyNews();
+        SMP_PROFILE_SCOPE("day.total");
 
-        if (priceService) {
-            priceService->updatePrices();
+        if (checkpoints) {
+            checkpoints->beginDay(*this);
         }
 
-        market->simulateDay();
-
-        newsService->applyNewsEffects(dailyNews);
+        if (orderGateway) {
+            SMP_PROFILE_SCOPE("day.orders");
+            orderGateway->executePendingOrders(*this);
+        }
 
-        market->processCompanyDividends();
+        std::vector<News> dailyNews;
+        std::vector<double> movements;
 
+        TaskGraph graph;
+        buildDailyPipeline(graph, dailyNews, movements);
 
-        player->updateDailyState();
-        player->closeDay();
-
-        if (saveService) {
-            saveService->checkAndCreateAutosave();
+        if (workerPool) {
+            graph.run(*workerPool);
+        } else {
+            graph.runSequential();
         }
 
+        stageTimings = graph.getTimings();
+
         simulatedDays++;
+
+        if (checkpoints) {
+            SMP_PROFILE_SCOPE("day.checkpoint");
+            checkpoints->endDay(*this);
+        }
         return true;
     } catch (const std::exception& e) {
         lastError = "Error during day simulation: " + std::string(e.what());
         return false;
     }
 }
+
+void Game::buildDailyPipeline(TaskGraph& graph, std::vector<News>& dailyNews, std::vector<double>& movements) {
+    size_t news = graph.addTask("news", [this, &dailyNews] {
+        SMP_PROFILE_SCOPE("day.news");
+        dailyNews = newsService->generateDailyNews();
+    });
+
+    std::vector<size_t> priceDependencies;
+    if (!workerPool) {
+        priceDependencies.push_back(news);
+    }
+
+    size_t prices = graph.addTask("prices", [this, &movements] {
+        SMP_PROFILE_SCOPE("day.prices");
+        if (priceService) {
+            movements = priceService->generateDailyMovements();
+        }
+    }, priceDependencies);
+
+    size_t marketDay = graph.addTask("market", [this, &dailyNews, &movements] {
+        SMP_PROFILE_SCOPE("day.market");
+        if (fusedPipeline) {
+            DailyCompanyEffects effects;
+            effects.priceMovements = std::move(movements);
+
+            newsService->collectNewsEffects(dailyNews, effects);
+
+            market->simulateFusedDay(effects);
+        } else {
+            if (priceService) {
+                priceService->applyDailyMovements(movements);
+            }
+
+            market->simulateDay();
+
+            newsService->applyNewsEffects(dailyNews);
+        }
+    }, {news, prices});
+
+    size_t dividends = graph.addTask("dividends", [this] {
+        SMP_PROFILE_SCOPE("day.dividends");
+        if (!fusedPipeline) {
+            market->processCompanyDividends();
+        }
+    }, {marketDay});
+
+    size_t valuation = graph.addTask("valuation", [this] {
+        SMP_PROFILE_SCOPE("day.valuation");
+        player->updateValuations();
+        player->processDividendIncome();
+    }, {dividends});
+
+    size_t loans = graph.addTask("loans", [this] {
+        SMP_PROFILE_SCOPE("day.loans");
+        player->processLoans();
+        player->processMarginRequirements();
+        player->closeDay();
+    }, {valuation});
+
+    graph.addTask("publish", [this, &dailyNews] {
+        SMP_PROFILE_SCOPE("day.publish");
+        if (marketDataServer) {
+            marketDataServer->publish(MarketSnapshot::capture(*market, newsService.get(), dailyNews));
+        }
+    }, {dividends});
+
+    graph.addTask("strategies", [this] {
+        SMP_PROFILE_SCOPE("day.strategies");
+        strategyEngine.runDay(*market);
+    }, {dividends});
+
+    graph.addTask("autosave", [this] {
+        SMP_PROFILE_SCOPE("day.autosave");
+        if (saveService) {
+            saveService->checkAndCreateAutosave();
+        }
+    }, {loans});
+}
+
 bool Game::simulateDays(int days) {
     if (days <= 0) {
         return true;
@@ -125,6 +226,80 @@ bool Game::simulateDays(int days) {
     return true;
 }
 
+// Forks the game for what-if analysis. Histories are shared copy-on-write, so
+// the cost is proportional to the number of companies and open positions,
+// plus a scan of the shared history in retainReferencedCompanies().
+// Strategy accounts, autosaves and external endpoints stay with the original,
+// and the branch runs sequentially until enableParallelMode() is called on it.
+std::shared_ptr<Game> Game::branch() const {
+    auto copy = std::make_shared<Game>();
+    if (!market || !player) {
+        copy->lastError = "Cannot branch an uninitialized game";
+        return copy;
+    }
+
+    copy->market = market->branch();
+
+    copy->player = std::make_shared<Player>(*player);
+    copy->player->setMarket(copy->market);
+    copy->player->getPortfolio()->rebindCompanies(copy->market->getCompanies());
+
+    if (newsService) {
+        copy->newsService = std::make_shared<NewsService>(*newsService);
+        copy->newsService->setMarket(copy->market);
+    }
+    if (priceService) {
+        copy->priceService = std::make_shared<PriceService>(*priceService);
+        copy->priceService->setMarket(copy->market);
+    }
+
+    copy->saveService = std::make_shared<SaveService>(copy->market, copy->player,
+                                                      copy->newsService, copy->priceService);
+    if (saveService) {
+        copy->saveService->initialize(saveService->getSavesDirectory());
+    }
+    copy->saveService->setAutosave(false);
+
+    copy->status = status;
+    copy->gameSpeed = gameSpeed;
+    copy->simulatedDays = simulatedDays;
+    copy->startDate = startDate;
+    copy->fusedPipeline = fusedPipeline;
+    copy->parallelSeed = parallelSeed;
+    copy->inheritedCompanies = inheritedCompanies;
+    copy->inheritedCompanies.insert(copy->inheritedCompanies.end(),
+                                    market->getCompanies().begin(), market->getCompanies().end());
+    copy->retainReferencedCompanies();
+    copy->applyParallelMode();
+
+    return copy;
+}
+
+// Advances every branch by the same number of days, one thread per branch.
+// Each thread draws from its own generator seeded with seed + branch index.
+bool Game::simulateBranches(const std::vector<std::shared_ptr<Game>>& branches, int days,
+                            unsigned int seed) {
+    std::vector<char> succeeded(branches.size(), 0);
+    std::vector<std::thread> threads;
+    threads.reserve(branches.size());
+
+    for (size_t i = 0; i < branches.size(); ++i) {
+        threads.emplace_back([&branches, &succeeded, days, seed, i] {
+            if (!branches[i]) {
+                return;
+            }
+            Random::ScopedGenerator generator(seed + static_cast<unsigned int>(i));
+            succeeded[i] = branches[i]->simulateDays(days) ? 1 : 0;
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return std::all_of(succeeded.begin(), succeeded.end(), [](char ok) { return ok != 0; });
+}
+
 std::shared_ptr<Market> Game::getMarket() const {
     return market;
 }
@@ -145,6 +320,209 @@ std::shared_ptr<SaveService> Game::getSaveService() const {
     return saveService;
 }
 
+std::shared_ptr<MarketDataServer> Game::getMarketDataServer() const {
+    return marketDataServer;
+}
+
+void Game::setMarketDataServer(std::shared_ptr<MarketDataServer> server) {
+    marketDataServer = server;
+}
+
+std::shared_ptr<SharedMarketFeed> Game::getSharedFeed() const {
+    return sharedFeed;
+}
+
+void Game::setSharedFeed(std::shared_ptr<SharedMarketFeed> feed) {
+    sharedFeed = feed;
+    if (market) {
+        market->setSharedFeed(sharedFeed);
+    }
+}
+
+std::shared_ptr<OrderGateway> Game::getOrderGateway() const {
+    return orderGateway;
+}
+
+void Game::setOrderGateway(std::shared_ptr<OrderGateway> gateway) {
+    orderGateway = gateway;
+}
+
+bool Game::addStrategyAccount(const std::string& strategyName, const std::string& accountName,
+                              double initialBalance) {
+    auto strategy = StrategyRegistry::create(strategyName);
+    if (!strategy) {
+        lastError = "Unknown strategy: " + strategyName;
+        return false;
+    }
+
+    return addStrategyAccount(std::move(strategy), accountName, initialBalance);
+}
+
+bool Game::addStrategyAccount(std::unique_ptr<Strategy> strategy, const std::string& accountName,
+                              double initialBalance) {
+    if (!market) {
+        lastError = "Market not initialized";
+        return false;
+    }
+
+    if (!strategy || initialBalance <= 0.0) {
+        lastError = "Invalid strategy account";
+        return false;
+    }
+
+    auto account = std::make_shared<Player>(accountName, initialBalance);
+    account->setMarket(market);
+    account->setCurrentDate(market->getCurrentDate());
+    strategyEngine.addAccount(account, std::move(strategy));
+    return true;
+}
+
+std::shared_ptr<CheckpointStore> Game::getCheckpointStore() const {
+    return checkpoints;
+}
+
+void Game::setCheckpointStore(std::shared_ptr<CheckpointStore> store) {
+    checkpoints = store;
+    if (checkpoints) {
+        checkpoints->clear();
+    }
+}
+
+// Restores the state at the end of the given day from the nearest earlier
+// checkpoint, replaying the recorded days in between. Later checkpoints are
+// discarded, and the generator is left where it was when that day ended, so
+// simulating forward again repeats the original timeline.
+// Strategy accounts go back to their recorded state as well.
+bool Game::rewindTo(int day) {
+    if (!checkpoints) {
+        lastError = "Checkpoints are not enabled";
+        return false;
+    }
+
+    const CheckpointSegment* segment = checkpoints->findSegment(day);
+    if (!segment) {
+        lastError = "No checkpoint covers day " + std::to_string(day);
+        return false;
+    }
+
+    SMP_PROFILE_SCOPE("game.rewind");
+    std::string liveState = Random::getState();
+
+    try {
+        auto replay = segment->snapshot->branch();
+        replay->workerPool = workerPool;
+        replay->applyParallelMode();
+        const std::vector<StrategyAccountSnapshot>* accounts = &segment->accounts;
+
+        for (const auto& delta : segment->deltas) {
+            if (delta.day > day) {
+                break;
+            }
+
+            Random::setState(delta.randomState);
+            if (!replay->simulateDay() || CheckpointStore::fingerprint(*replay) != delta.fingerprint) {
+                Random::setState(liveState);
+                lastError = "Replay of day " + std::to_string(delta.day) + " diverged from the recording";
+                return false;
+            }
+
+            *replay->player = *delta.player;
+            replay->player->setMarket(replay->market);
+            replay->player->getPortfolio()->rebindCompanies(replay->market->getCompanies());
+            accounts = &delta.accounts;
+        }
+
+        std::string nextState;
+        Random::setState(checkpoints->findRandomState(day + 1, nextState) ? nextState : liveState);
+
+        adoptState(*replay);
+        strategyEngine.restore(*accounts, market);
+        checkpoints->truncateAfter(day);
+        return true;
+    } catch (const std::exception& e) {
+        Random::setState(liveState);
+        lastError = "Error during rewind: " + std::string(e.what());
+        return false;
+    }
+}
+
+// Moves another game's state into this one in place, so the services, screens
+// and endpoints holding this game's objects keep working.
+void Game::adoptState(Game& source) {
+    *market = std::move(*source.market);
+
+    *player = *source.player;
+    player->setMarket(market);
+    player->getPortfolio()->rebindCompanies(market->getCompanies());
+
+    if (newsService && source.newsService) {
+        *newsService = *source.newsService;
+        newsService->setMarket(market);
+    }
+    if (priceService && source.priceService) {
+        *priceService = *source.priceService;
+        priceService->setMarket(market);
+    }
+
+    inheritedCompanies = source.inheritedCompanies;
+    retainReferencedCompanies();
+    simulatedDays = source.simulatedDays;
+    applyParallelMode();
+
+    if (sharedFeed) {
+        market->setSharedFeed(sharedFeed);
+    }
+}
+
+// Drops inherited companies that no shared news or transaction refers to
+// any more, so repeated branching and rewinding cannot accumulate them.
+// Histories are scanned newest first and the scan stops once every
+// candidate has been seen.
+void Game::retainReferencedCompanies() {
+    std::vector<bool> referenced(inheritedCompanies.size(), false);
+    size_t remaining = inheritedCompanies.size();
+
+    auto mark = [this, &referenced, &remaining](const std::weak_ptr<Company>& company) {
+        for (size_t i = 0; i < inheritedCompanies.size(); ++i) {
+            if (!referenced[i] && !company.owner_before(inheritedCompanies[i]) &&
+                !inheritedCompanies[i].owner_before(company)) {
+                referenced[i] = true;
+                --remaining;
+                return;
+            }
+        }
+    };
+
+    if (newsService) {
+        const auto& news = newsService->getNewsHistory();
+        for (size_t i = news.size(); i-- > 0 && remaining > 0;) {
+            mark(news[i].getTargetCompany());
+        }
+    }
+    if (player) {
+        const auto& transactions = player->getPortfolio()->getTransactions();
+        for (size_t i = transactions.size(); i-- > 0 && remaining > 0;) {
+            mark(transactions[i].getCompany());
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < inheritedCompanies.size(); ++i) {
+        if (referenced[i]) {
+            inheritedCompanies[kept++] = std::move(inheritedCompanies[i]);
+        }
+    }
+    inheritedCompanies.resize(kept);
+}
+
+StrategyEngine& Game::getStrategyEngine() {
+    return strategyEngine;
+}
+
+const StrategyEngine& Game::getStrategyEngine() const {
+    return strategyEngine;
+}
+
 GameStatus Game::getStatus() const {
     return status;
 }
@@ -163,6 +541,43 @@ int Game::getSimulatedDays() const {
     return simulatedDays;
 }
 
+bool Game::isFusedPipeline() const {
+    return fusedPipeline;
+}
+
+void Game::setFusedPipeline(bool enabled) {
+    fusedPipeline = enabled;
+}
+
+void Game::enableParallelMode(size_t threadCount, uint64_t seed) {
+    workerPool = std::make_shared<WorkStealingPool>(threadCount);
+    parallelSeed = seed;
+    applyParallelMode();
+}
+
+void Game::disableParallelMode() {
+    workerPool.reset();
+    applyParallelMode();
+}
+
+bool Game::isParallelMode() const {
+    return workerPool != nullptr;
+}
+
+const std::vector<StageTiming>& Game::getStageTimings() const {
+    return stageTimings;
+}
+
+void Game::applyParallelMode() {
+    if (market) {
+        market->setParallelMode(workerPool, parallelSeed);
+    }
+    if (priceService) {
+        priceService->setParallelMode(workerPool, parallelSeed);
+    }
+    strategyEngine.setParallelMode(workerPool);
+}
+
 Date Game::getStartDate() const {
     return startDate;
 }
@@ -184,10 +599,16 @@ bool Game::loadGame(const std::string& filename) {
     
     bool result = saveService->loadGame(filename);
     if (result) {
+        if (checkpoints) {
+            checkpoints->clear();
+        }
+
         Date currentDate = player->getCurrentDate();
         if (newsService) {
             newsService->setCurrentDate(currentDate);
         }
+
+        applyParallelMode();
     }
     
     return result;
@@ -5,9 +5,16 @@
 #include <vector>
 #include "Market.hpp"
 #include "Player.hpp"
+#include "StrategyEngine.hpp"
+#include "CheckpointStore.hpp"
 #include "../services/NewsService.hpp"
 #include "../services/PriceService.hpp"
 #include "../services/SaveService.hpp"
+#include "../services/MarketDataServer.hpp"
+#include "../services/SharedMarketFeed.hpp"
+#include "../services/OrderGateway.hpp"
+#include "../utils/WorkStealingPool.hpp"
+#include "../utils/TaskGraph.hpp"
 
 namespace StockMarketSimulator {
 
@@ -25,12 +32,32 @@ private:
     std::shared_ptr<NewsService> newsService;
     std::shared_ptr<PriceService> priceService;
     std::shared_ptr<SaveService> saveService;
+    std::shared_ptr<MarketDataServer> marketDataServer;
+    std::shared_ptr<SharedMarketFeed> sharedFeed;
+    std::shared_ptr<OrderGateway> orderGateway;
+    std::shared_ptr<CheckpointStore> checkpoints;
+    StrategyEngine strategyEngine;
 
     GameStatus status;
     int gameSpeed;
     int simulatedDays;
     Date startDate;
     std::string lastError;
+    bool fusedPipeline;
+
+    std::shared_ptr<WorkStealingPool> workerPool;
+    uint64_t parallelSeed;
+
+    std::vector<StageTiming> stageTimings;
+
+    // Companies of the games this one was branched or restored from.
+    // Inherited news and transaction history still point at them.
+    std::vector<std::shared_ptr<Company>> inheritedCompanies;
+
+    void applyParallelMode();
+    void adoptState(Game& source);
+    void retainReferencedCompanies();
+    void buildDailyPipeline(TaskGraph& graph, std::vector<News>& dailyNews, std::vector<double>& movements);
 
 public:
     Game();
@@ -45,16 +72,45 @@ public:
     bool simulateDay();
     bool simulateDays(int days);
 
+    std::shared_ptr<Game> branch() const;
+    static bool simulateBranches(const std::vector<std::shared_ptr<Game>>& branches, int days,
+                                 unsigned int seed);
+
     std::shared_ptr<Market> getMarket() const;
     std::shared_ptr<Player> getPlayer() const;
     std::shared_ptr<NewsService> getNewsService() const;
     std::shared_ptr<PriceService> getPriceService() const;
     std::shared_ptr<SaveService> getSaveService() const;
+    std::shared_ptr<MarketDataServer> getMarketDataServer() const;
+    void setMarketDataServer(std::shared_ptr<MarketDataServer> server);
+    std::shared_ptr<SharedMarketFeed> getSharedFeed() const;
+    void setSharedFeed(std::shared_ptr<SharedMarketFeed> feed);
+    std::shared_ptr<OrderGateway> getOrderGateway() const;
+    void setOrderGateway(std::shared_ptr<OrderGateway> gateway);
+    std::shared_ptr<CheckpointStore> getCheckpointStore() const;
+    void setCheckpointStore(std::shared_ptr<CheckpointStore> store);
+
+    bool rewindTo(int day);
+
+    bool addStrategyAccount(const std::string& strategyName, const std::string& accountName,
+                            double initialBalance);
+    bool addStrategyAccount(std::unique_ptr<Strategy> strategy, const std::string& accountName,
+                            double initialBalance);
+    StrategyEngine& getStrategyEngine();
+    const StrategyEngine& getStrategyEngine() const;
 
     GameStatus getStatus() const;
     int getGameSpeed() const;
     void setGameSpeed(int speed);
     int getSimulatedDays() const;
+    bool isFusedPipeline() const;
+    void setFusedPipeline(bool enabled);
+
+    void enableParallelMode(size_t threadCount, uint64_t seed);
+    void disableParallelMode();
+    bool isParallelMode() const;
+
+    const std::vector<StageTiming>& getStageTimings() const;
     Date getStartDate() const;
 
     bool saveGame(const std::string& displayName);
@@ -1,18 +1,23 @@
 #include "Market.hpp"
 #include "../utils/Random.hpp"
 #include "../utils/FileIO.hpp"
+#include "../services/SharedMarketFeed.hpp"
 #include <algorithm>
 #include <cmath>
 
 namespace StockMarketSimulator {
 
 Market::Market()
-    : currentDate(1, 3, 2023),
+    : indexEngine(1000.0),
+      daysSinceRebase(0),
+      rebaseInterval(30),
+      currentDate(1, 3, 2023),
       cycleLength(365),
       currentCycleDay(0),
       marketVolatility(0.01),
       marketMomentum(0.3),
-      trendStrength(0.7)
+      trendStrength(0.7),
+      parallelSeed(0)
 {
     state.indexValue = 1000.0;
     state.dailyChange = 0.0;
@@ -23,11 +28,112 @@ Market::Market()
     state.inflationRate = 0.02;
     state.unemploymentRate = 0.045;
 
-    sectorTrends[Sector::Technology] = 0.0;
-    sectorTrends[Sector::Energy] = 0.0;
-    sectorTrends[Sector::Finance] = 0.0;
-    sectorTrends[Sector::Consumer] = 0.0;
-    sectorTrends[Sector::Manufacturing] = 0.0;
+    sectorTrends.fill(0.0);
+}
+
+// Copies clone the companies: a Company reports price changes to a single
+// index, so sharing them would move the original's hooks to the copy.
+Market::Market(const Market& other)
+    : Market(other, other.cloneCompanies())
+{
+}
+
+Market::Market(const Market& other, std::vector<std::shared_ptr<Company>> companies)
+    : companies(std::move(companies)),
+      state(other.state),
+      sectorTrends(other.sectorTrends),
+      sectorAggregates(other.sectorAggregates),
+      indexEngine(other.indexEngine),
+      daysSinceRebase(other.daysSinceRebase),
+      rebaseInterval(other.rebaseInterval),
+      currentDate(other.currentDate),
+      cycleLength(other.cycleLength),
+      currentCycleDay(other.currentCycleDay),
+      marketVolatility(other.marketVolatility),
+      marketMomentum(other.marketMomentum),
+      trendStrength(other.trendStrength),
+      pool(other.pool),
+      parallelSeed(other.parallelSeed)
+{
+    attachCompaniesToIndex();
+}
+
+// Moves hand the companies over, so objects already bound to them (a loaded
+// player's positions, for example) follow them into this market.
+Market::Market(Market&& other)
+    : Market(other, std::move(other.companies))
+{
+    other.companies.clear();
+}
+
+Market& Market::operator=(const Market& other) {
+    if (this != &other) {
+        *this = Market(other);
+    }
+    return *this;
+}
+
+Market& Market::operator=(Market&& other) {
+    if (this != &other) {
+        detachCompaniesFromIndex();
+
+        companies = std::move(other.companies);
+        other.companies.clear();
+        state = other.state;
+        sectorTrends = other.sectorTrends;
+        sectorAggregates = other.sectorAggregates;
+        indexEngine = other.indexEngine;
+        daysSinceRebase = other.daysSinceRebase;
+        rebaseInterval = other.rebaseInterval;
+        currentDate = other.currentDate;
+        cycleLength = other.cycleLength;
+        currentCycleDay = other.currentCycleDay;
+        marketVolatility = other.marketVolatility;
+        marketMomentum = other.marketMomentum;
+        trendStrength = other.trendStrength;
+        pool = other.pool;
+        parallelSeed = other.parallelSeed;
+
+        attachCompaniesToIndex();
+        markChanged();
+    }
+    return *this;
+}
+
+Market::~Market() {
+    detachCompaniesFromIndex();
+}
+
+// Companies are cloned so prices can diverge, while their price histories
+// keep sharing storage until written.
+std::vector<std::shared_ptr<Company>> Market::cloneCompanies() const {
+    std::vector<std::shared_ptr<Company>> clonedCompanies;
+    clonedCompanies.reserve(companies.size());
+    for (const auto& company : companies) {
+        auto clone = std::make_shared<Company>(*company);
+        clone->getStock()->setCompany(clone);
+        clonedCompanies.push_back(std::move(clone));
+    }
+    return clonedCompanies;
+}
+
+// Independent copy for what-if scenarios.
+std::shared_ptr<Market> Market::branch() const {
+    return std::make_shared<Market>(*this);
+}
+
+void Market::attachCompaniesToIndex() {
+    for (size_t i = 0; i < companies.size(); ++i) {
+        companies[i]->attachToIndex(&indexEngine, i);
+    }
+}
+
+void Market::detachCompaniesFromIndex() {
+    for (auto& company : companies) {
+        if (company->isAttachedTo(&indexEngine)) {
+            company->detachFromIndex();
+        }
+    }
 }
 
 const MarketState& Market::getState() const {
@@ -38,10 +144,18 @@ const std::vector<std::shared_ptr<Company>>& Market::getCompanies() const {
     return companies;
 }
 
-const std::map<Sector, double>& Market::getSectorTrends() const {
+const std::array<double, SECTOR_COUNT>& Market::getSectorTrends() const {
     return sectorTrends;
 }
 
+double Market::getSectorTrend(Sector sector) const {
+    return sectorTrends[sectorIndex(sector)];
+}
+
+const SectorAggregates& Market::getSectorAggregates() const {
+    return sectorAggregates;
+}
+
 Date Market::getCurrentDate() const {
     return currentDate;
 }
@@ -55,10 +169,40 @@ double Market::getMarketIndex() const {
     return state.indexValue;
 }
 
+double Market::getEqualWeightedIndex() const {
+    return indexEngine.getEqualWeightedIndex();
+}
+
+double Market::getSectorIndex(Sector sector) const {
+    return indexEngine.getSectorIndex(sector);
+}
+
+const MarketIndex& Market::getIndexEngine() const {
+    return indexEngine;
+}
+
+int Market::getRebaseInterval() const {
+    return rebaseInterval;
+}
+
+void Market::setRebaseInterval(int days) {
+    if (days > 0) {
+        rebaseInterval = days;
+    }
+}
+
 MarketTrend Market::getCurrentTrend() const {
     return state.currentTrend;
 }
 
+uint64_t Market::getVersion() const {
+    return version.get();
+}
+
+void Market::markChanged() {
+    version.bump();
+}
+
 std::string Market::getTrendName() const {
     return marketTrendToString(state.currentTrend);
 }
@@ -76,17 +220,44 @@ double Market::getUnemploymentRate() const {
 }
 
 void Market::addCompany(std::shared_ptr<Company> company) {
+    double price = company->getStock() ? company->getStock()->getCurrentPrice() : 0.0;
+    size_t slot = indexEngine.addConstituent(company->getSector(), price, company->getMarketCap());
+
+    company->attachToIndex(&indexEngine, slot);
     companies.push_back(company);
+
+    // Sector counts stay current between days so callers can rely on them.
+    sectorAggregates.accumulate(*company);
+    sectorAggregates.finishDay();
+
+    updateMarketIndex();
+    markChanged();
 }
 
 void Market::removeCompany(const std::string& ticker) {
+    bool removed = false;
+
     companies.erase(
         std::remove_if(companies.begin(), companies.end(),
             [&](const std::shared_ptr<Company>& company) {
-                return company->getTicker() == ticker;
+                if (company->getTicker() != ticker) {
+                    return false;
+                }
+
+                if (company->isAttachedTo(&indexEngine)) {
+                    company->detachFromIndex();
+                }
+                removed = true;
+                return true;
             }),
         companies.end()
     );
+
+    if (removed) {
+        indexEngine.rebuild(companies);
+        attachCompaniesToIndex();
+        refreshAggregates();
+    }
 }
 
 std::shared_ptr<Company> Market::getCompanyByTicker(const std::string& ticker) const {
@@ -100,6 +271,11 @@ std::shared_ptr<Company> Market::getCompanyByTicker(const std::string& ticker) c
 
 std::vector<std::shared_ptr<Company>> Market::getCompaniesBySector(Sector sector) const {
     std::vector<std::shared_ptr<Company>> sectorCompanies;
+    int companyCount = sectorAggregates.get(sector).companyCount;
+    if (companyCount == 0) {
+        return sectorCompanies;
+    }
+    sectorCompanies.reserve(companyCount);
 
     for (const auto& company : companies) {
         if (company->getSector() == sector) {
@@ -194,11 +370,7 @@ void Market::addDefaultCompanies() {
     addCompany(industrialCo);
 }
 
-void Market::simulateDay() {
-    for (auto& company : companies) {
-        company->closeTradingDay(currentDate);
-    }
-
+double Market::advanceDay() {
     currentDate.nextDay();
     currentCycleDay = (currentCycleDay + 1) % cycleLength;
 
@@ -208,19 +380,156 @@ void Market::simulateDay() {
 
     double marketMovement = generateMarketMovement();
 
-    double previousIndex = state.indexValue;
-    state.indexValue *= (1.0 + marketMovement);
+    updateSectorTrends(marketMovement);
+
+    return marketMovement;
+}
+
+void Market::finishDay(double previousIndex) {
+    sectorAggregates.finishDay();
+
+    if (++daysSinceRebase >= rebaseInterval) {
+        indexEngine.rebase();
+        daysSinceRebase = 0;
+    }
+
+    updateMarketIndex();
     state.dailyChange = state.indexValue - previousIndex;
-    state.dailyChangePercent = (state.dailyChange / previousIndex) * 100.0;
+    state.dailyChangePercent = (previousIndex > 0.0) ? (state.dailyChange / previousIndex) * 100.0 : 0.0;
+    markChanged();
 
-    updateSectorTrends();
+    if (sharedFeed) {
+        sharedFeed->publish(*this);
+    }
+}
 
+void Market::simulateDay() {
     for (auto& company : companies) {
+        company->closeTradingDay(currentDate);
+    }
+
+    double previousIndex = state.indexValue;
+
+    double marketMovement = advanceDay();
+
+    generateDailyFactors(marketMovement, {});
+
+    sectorAggregates.beginDay();
+
+    for (size_t i = 0; i < companies.size(); ++i) {
+        const auto& company = companies[i];
+        company->openTradingDay(currentDate);
+
+        company->updatePrice(company->getStock()->getCurrentPrice() * dailyFactors[i]);
+
+        sectorAggregates.accumulate(*company);
+    }
+
+    finishDay(previousIndex);
+}
+
+void Market::generateDailyFactors(double marketMovement, const std::vector<double>& economicImpacts) {
+    dailyFactors.resize(companies.size());
+
+    if (pool) {
+        uint64_t day = static_cast<uint64_t>(getCurrentDay());
+
+        pool->parallelFor(0, companies.size(), PARALLEL_GRAIN_SIZE, [&](size_t i) {
+            const Company& company = *companies[i];
+            bool trending = company.getSector() != Sector::Unknown;
+            double sectorTrend = sectorTrends[sectorIndex(company.getSector())];
+            RandomStream stream = RandomStream::derive(parallelSeed, day,
+                                                       RandomStream::keyFor(company.getTicker()),
+                                                       MARKET_STREAM_STAGE);
+
+            double factor = 1.0 + company.generateDailyMovement(marketMovement, sectorTrend, stream);
+            for (double impact : economicImpacts) {
+                sectorTrend += trending ? impact : 0.0;
+                factor *= 1.0 + company.generateDailyMovement(impact, sectorTrend, stream);
+            }
+
+            dailyFactors[i] = factor;
+        });
+        return;
+    }
+
+    for (size_t i = 0; i < companies.size(); ++i) {
+        const Company& company = *companies[i];
+        bool trending = company.getSector() != Sector::Unknown;
+        double sectorTrend = sectorTrends[sectorIndex(company.getSector())];
+
+        double factor = 1.0 + company.generateDailyMovement(marketMovement, sectorTrend);
+        for (double impact : economicImpacts) {
+            sectorTrend += trending ? impact : 0.0;
+            factor *= 1.0 + company.generateDailyMovement(impact, sectorTrend);
+        }
+
+        dailyFactors[i] = factor;
+    }
+}
+
+std::vector<std::pair<std::shared_ptr<Company>, double>> Market::simulateFusedDay(const DailyCompanyEffects& effects) {
+    std::vector<std::pair<std::shared_ptr<Company>, double>> dividendPayments;
+
+    Date closingDate = currentDate;
+    double previousIndex = state.indexValue;
+
+    double marketMovement = advanceDay();
+
+    // Economic news lands after the day's move, as in simulateDay() followed
+    // by triggerEconomicEvent(): each impact sees the trends raised by the
+    // impacts before it, and the sector trends take all of them at the end.
+    generateDailyFactors(marketMovement, effects.economicImpacts);
+
+    for (double impact : effects.economicImpacts) {
+        for (size_t i = 0; i < sectorIndex(Sector::Unknown); ++i) {
+            sectorTrends[i] += impact;
+        }
+    }
+
+    sectorAggregates.beginDay();
+
+    for (size_t i = 0; i < companies.size(); ++i) {
+        const auto& company = companies[i];
+
+        company->closeTradingDay(closingDate);
         company->openTradingDay(currentDate);
 
-        Sector companySector = company->getSector();
-        double sectorTrend = sectorTrends[companySector];
-        company->updateStockPrice(marketMovement, sectorTrend);
+        double factor = 1.0 + (i < effects.priceMovements.size() ? effects.priceMovements[i] : 0.0);
+        factor *= dailyFactors[i];
+
+        if (i < effects.newsFactors.size()) {
+            factor *= effects.newsFactors[i];
+        }
+
+        company->updatePrice(company->getStock()->getCurrentPrice() * factor);
+
+        sectorAggregates.accumulate(*company);
+
+        collectDividend(company, dividendPayments);
+    }
+
+    finishDay(previousIndex);
+
+    return dividendPayments;
+}
+
+void Market::collectDividend(const std::shared_ptr<Company>& company,
+                             std::vector<std::pair<std::shared_ptr<Company>, double>>& payments) const {
+    company->initializeDividendSchedule(currentDate);
+
+    if (company->processDividends(currentDate)) {
+        double dividendAmount = company->calculateDividendAmount();
+
+        if (dividendAmount > 0.0) {
+            payments.push_back({company, dividendAmount});
+
+            std::stringstream logMsg;
+            logMsg << "Dividend paid: " << company->getName()
+                   << " paid " << dividendAmount
+                   << "$ per share on " << currentDate.toString();
+            FileIO::appendToLog(logMsg.str());
+        }
     }
 }
 
@@ -228,69 +537,78 @@ std::vector<std::pair<std::shared_ptr<Company>, double>> Market::processCompanyD
     std::vector<std::pair<std::shared_ptr<Company>, double>> dividendPayments;
 
     for (auto& company : companies) {
-        company->initializeDividendSchedule(currentDate);
+        collectDividend(company, dividendPayments);
+    }
 
-        if (company->processDividends(currentDate)) {
-            double dividendAmount = company->calculateDividendAmount();
+    return dividendPayments;
+}
+void Market::setParallelMode(std::shared_ptr<WorkStealingPool> pool, uint64_t seed) {
+    this->pool = pool;
+    parallelSeed = seed;
+}
 
-            if (dividendAmount > 0.0) {
-                dividendPayments.push_back({company, dividendAmount});
+bool Market::isParallelMode() const {
+    return pool != nullptr;
+}
 
-                std::stringstream logMsg;
-                logMsg << "Dividend paid: " << company->getName()
-                       << " paid " << dividendAmount
-                       << "$ per share on " << currentDate.toString();
-                FileIO::appendToLog(logMsg.str());
-            }
-        }
+void Market::setSharedFeed(std::shared_ptr<SharedMarketFeed> feed) {
+    sharedFeed = feed;
+    if (sharedFeed) {
+        sharedFeed->publish(*this);
     }
+}
 
-    return dividendPayments;
+std::shared_ptr<SharedMarketFeed> Market::getSharedFeed() const {
+    return sharedFeed;
 }
+
 void Market::setMarketTrend(MarketTrend trend) {
     state.currentTrend = trend;
     state.trendDuration = 0;
+    markChanged();
 }
 
 void Market::triggerEconomicEvent(double impact, bool affectAllSectors) {
-    state.indexValue *= (1.0 + impact);
-
     if (affectAllSectors) {
-        for (auto& sector : sectorTrends) {
-            sector.second += impact;
+        for (size_t i = 0; i < sectorIndex(Sector::Unknown); ++i) {
+            sectorTrends[i] += impact;
         }
     } else {
-        std::vector<Sector> sectors = {
-            Sector::Technology, Sector::Energy, Sector::Finance,
-            Sector::Consumer, Sector::Manufacturing
-        };
-
-        Sector affectedSector = Random::getRandomElement(sectors);
+        size_t affectedSector = Random::getIndex(sectorIndex(Sector::Unknown));
         sectorTrends[affectedSector] += impact * 2.0;
     }
 
     for (auto& company : companies) {
-        Sector companySector = company->getSector();
-        company->updateStockPrice(impact, sectorTrends[companySector]);
+        company->updateStockPrice(impact, sectorTrends[sectorIndex(company->getSector())]);
     }
-}
 
-void Market::updateMarketIndex() {
-    if (companies.empty()) {
-        return;
-    }
+    refreshAggregates();
+}
 
-    double totalMarketCap = 0.0;
+void Market::refreshAggregates() {
+    sectorAggregates.beginDay();
     for (const auto& company : companies) {
-        totalMarketCap += company->getMarketCap();
+        sectorAggregates.accumulate(*company);
     }
+    sectorAggregates.finishDay();
+
+    updateMarketIndex();
+    markChanged();
+}
 
-    state.indexValue = (totalMarketCap / companies.size()) / 10;
+void Market::updateMarketIndex() {
+    state.indexValue = indexEngine.getCapWeightedIndex();
+
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        Sector sector = static_cast<Sector>(i);
+        sectorAggregates.setIndexValue(sector, indexEngine.getSectorIndex(sector));
+    }
 }
 
-void Market::updateSectorTrends() {
-    for (auto& [sector, trend] : sectorTrends) {
-        double newTrend = generateSectorMovement(sector);
+void Market::updateSectorTrends(double marketMovement) {
+    for (size_t i = 0; i < sectorIndex(Sector::Unknown); ++i) {
+        double& trend = sectorTrends[i];
+        double newTrend = generateSectorMovement(static_cast<Sector>(i), marketMovement);
 
         if (newTrend == trend) {
             newTrend += Random::getDouble(-0.01, 0.01);
@@ -384,9 +702,7 @@ double Market::generateMarketMovement() {
     return totalMovement;
 }
 
-double Market::generateSectorMovement(Sector sector) {
-    double marketMovement = (state.dailyChangePercent / 100.0);
-
+double Market::generateSectorMovement(Sector sector, double marketMovement) {
     double randomComponent = Random::getNormal(0.0, 0.005);
 
     double sectorSpecific = 0.0;
@@ -444,10 +760,14 @@ nlohmann::json Market::toJson() const {
     };
 
     j["sector_trends"] = nlohmann::json::object();
-    for (const auto& [sector, trend] : sectorTrends) {
-        j["sector_trends"][sectorToString(sector)] = trend;
+    for (size_t i = 0; i < sectorIndex(Sector::Unknown); ++i) {
+        j["sector_trends"][sectorToString(static_cast<Sector>(i))] = sectorTrends[i];
     }
 
+    j["sector_aggregates"] = sectorAggregates.toJson();
+    j["index_engine"] = indexEngine.toJson();
+    j["days_since_rebase"] = daysSinceRebase;
+
     j["companies"] = nlohmann::json::array();
     for (const auto& company : companies) {
         j["companies"].push_back(company->toJson());
@@ -457,6 +777,18 @@ nlohmann::json Market::toJson() const {
 }
 
 Market Market::fromJson(const nlohmann::json& json) {
+    std::vector<std::shared_ptr<Company>> companies;
+    companies.reserve(json["companies"].size());
+    for (const auto& companyJson : json["companies"]) {
+        companies.push_back(Company::fromJson(companyJson));
+    }
+
+    return fromJson(json, std::move(companies));
+}
+
+// Builds the market from everything except the "companies" array, which the
+// caller has already converted.
+Market Market::fromJson(const nlohmann::json& json, std::vector<std::shared_ptr<Company>> companies) {
     Market market;
 
     if (json.contains("current_date")) {
@@ -483,14 +815,29 @@ Market Market::fromJson(const nlohmann::json& json) {
 
     for (const auto& [sectorStr, trend] : json["sector_trends"].items()) {
         Sector sector = sectorFromString(sectorStr);
-        market.sectorTrends[sector] = trend;
+        market.sectorTrends[sectorIndex(sector)] = trend;
     }
 
-    market.companies.clear();
-    for (const auto& companyJson : json["companies"]) {
-        market.companies.push_back(Company::fromJson(companyJson));
+    market.companies = std::move(companies);
+
+    if (json.contains("sector_aggregates")) {
+        market.sectorAggregates = SectorAggregates::fromJson(json["sector_aggregates"]);
+    } else {
+        // Older saves carry no aggregates; sector counts must still match the companies.
+        market.sectorAggregates.beginDay();
+        for (const auto& company : market.companies) {
+            market.sectorAggregates.accumulate(*company);
+        }
+        market.sectorAggregates.finishDay();
     }
 
+    market.indexEngine.rebuild(market.companies);
+    market.indexEngine.restoreLevels(json.value("index_engine", nlohmann::json::object()),
+                                     market.state.indexValue);
+    market.daysSinceRebase = json.value("days_since_rebase", 0);
+    market.attachCompaniesToIndex();
+    market.updateMarketIndex();
+
     return market;
 }
 
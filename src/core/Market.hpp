@@ -4,12 +4,19 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <array>
 #include <nlohmann/json.hpp>
 #include "../models/Company.hpp"
 #include "../utils/Date.hpp"
+#include "../utils/WorkStealingPool.hpp"
+#include "../utils/ChangeVersion.hpp"
+#include "SectorAggregates.hpp"
+#include "MarketIndex.hpp"
 
 namespace StockMarketSimulator {
 
+class SharedMarketFeed;
+
 enum class MarketTrend {
     Bullish,
     Bearish,
@@ -28,11 +35,21 @@ struct MarketState {
     double unemploymentRate;
 };
 
+struct DailyCompanyEffects {
+    std::vector<double> priceMovements;
+    std::vector<double> newsFactors;
+    std::vector<double> economicImpacts;
+};
+
 class Market {
 private:
     std::vector<std::shared_ptr<Company>> companies;
     MarketState state;
-    std::map<Sector, double> sectorTrends;
+    std::array<double, SECTOR_COUNT> sectorTrends;
+    SectorAggregates sectorAggregates;
+    MarketIndex indexEngine;
+    int daysSinceRebase;
+    int rebaseInterval;
     Date currentDate;
     int cycleLength;
     int currentCycleDay;
@@ -41,23 +58,59 @@ private:
     double marketMomentum;
     double trendStrength;
 
+    std::shared_ptr<WorkStealingPool> pool;
+    uint64_t parallelSeed;
+    std::vector<double> dailyFactors;
+    std::shared_ptr<SharedMarketFeed> sharedFeed;
+    ChangeVersion version;
+
+    static constexpr size_t PARALLEL_GRAIN_SIZE = 256;
+    static constexpr uint64_t MARKET_STREAM_STAGE = 2;
+
+    Market(const Market& other, std::vector<std::shared_ptr<Company>> companies);
+
+    std::vector<std::shared_ptr<Company>> cloneCompanies() const;
+
     void updateMarketIndex();
-    void updateSectorTrends();
+    void attachCompaniesToIndex();
+    void detachCompaniesFromIndex();
+    void updateSectorTrends(double marketMovement);
     void calculateMarketTrend();
     void updateMacroeconomicFactors();
     double generateMarketMovement();
-    double generateSectorMovement(Sector sector);
+    double generateSectorMovement(Sector sector, double marketMovement);
+    double advanceDay();
+    void finishDay(double previousIndex);
+    void generateDailyFactors(double marketMovement, const std::vector<double>& economicImpacts);
+    void collectDividend(const std::shared_ptr<Company>& company,
+                         std::vector<std::pair<std::shared_ptr<Company>, double>>& payments) const;
 
 public:
     Market();
+    Market(const Market& other);
+    Market(Market&& other);
+    Market& operator=(const Market& other);
+    Market& operator=(Market&& other);
+    ~Market();
+
+    std::shared_ptr<Market> branch() const;
 
     const MarketState& getState() const;
     const std::vector<std::shared_ptr<Company>>& getCompanies() const;
-    const std::map<Sector, double>& getSectorTrends() const;
+    const std::array<double, SECTOR_COUNT>& getSectorTrends() const;
+    double getSectorTrend(Sector sector) const;
+    const SectorAggregates& getSectorAggregates() const;
     Date getCurrentDate() const;
     int getCurrentDay() const;
     double getMarketIndex() const;
+    double getEqualWeightedIndex() const;
+    double getSectorIndex(Sector sector) const;
+    const MarketIndex& getIndexEngine() const;
+    int getRebaseInterval() const;
+    void setRebaseInterval(int days);
     MarketTrend getCurrentTrend() const;
+    uint64_t getVersion() const;
+    void markChanged();
     std::string getTrendName() const;
     double getInterestRate() const;
     double getInflationRate() const;
@@ -70,11 +123,24 @@ public:
     void addDefaultCompanies();
 
     void simulateDay();
-    std::vector<std::pair<std::shared_ptr<Company>, double>> processCompanyDividends();    void setMarketTrend(MarketTrend trend);
+    std::vector<std::pair<std::shared_ptr<Company>, double>> simulateFusedDay(const DailyCompanyEffects& effects);
+    std::vector<std::pair<std::shared_ptr<Company>, double>> processCompanyDividends();
+    void setMarketTrend(MarketTrend trend);
     void triggerEconomicEvent(double impact, bool affectAllSectors = true);
 
+    // Recomputes sector aggregates and indices after prices moved outside
+    // simulateDay(), e.g. through news effects.
+    void refreshAggregates();
+
+    void setParallelMode(std::shared_ptr<WorkStealingPool> pool, uint64_t seed);
+    bool isParallelMode() const;
+
+    void setSharedFeed(std::shared_ptr<SharedMarketFeed> feed);
+    std::shared_ptr<SharedMarketFeed> getSharedFeed() const;
+
     nlohmann::json toJson() const;
     static Market fromJson(const nlohmann::json& json);
+    static Market fromJson(const nlohmann::json& json, std::vector<std::shared_ptr<Company>> companies);
 
     static std::string marketTrendToString(MarketTrend trend);
     static MarketTrend marketTrendFromString(const std::string& trendStr);
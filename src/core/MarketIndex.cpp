@@ -0,0 +1,227 @@
+#include "MarketIndex.hpp"
+#include "Market.hpp"
+
+namespace StockMarketSimulator {
+
+MarketIndex::MarketIndex(double initialLevel)
+    : activeCount(0),
+      totalMarketCap(0.0),
+      capDivisor(0.0),
+      capLevel(initialLevel),
+      equalWeightSum(0.0),
+      equalLevel(initialLevel),
+      updatesSinceRebase(0)
+{
+    sectorMarketCap.fill(0.0);
+    sectorDivisor.fill(0.0);
+    sectorLevel.fill(BASE_VALUE);
+}
+
+size_t MarketIndex::addConstituent(Sector sector, double price, double marketCap) {
+    double capBefore = getCapWeightedIndex();
+    double equalBefore = getEqualWeightedIndex();
+    double sectorBefore = getSectorIndex(sector);
+
+    constituents.push_back({sector, price, marketCap, price, true});
+    activeCount++;
+
+    size_t idx = sectorIndex(sector);
+    totalMarketCap += marketCap;
+    sectorMarketCap[idx] += marketCap;
+
+    capDivisor = (totalMarketCap > 0.0) ? totalMarketCap / capBefore : 0.0;
+    capLevel = capBefore;
+    sectorDivisor[idx] = (sectorMarketCap[idx] > 0.0) ? sectorMarketCap[idx] / sectorBefore : 0.0;
+    sectorLevel[idx] = sectorBefore;
+
+    equalLevel = equalBefore;
+    reanchorEqualWeight();
+
+    return constituents.size() - 1;
+}
+
+void MarketIndex::removeConstituent(size_t slot) {
+    if (slot >= constituents.size() || !constituents[slot].active) {
+        return;
+    }
+
+    Constituent& constituent = constituents[slot];
+    size_t idx = sectorIndex(constituent.sector);
+
+    double capBefore = getCapWeightedIndex();
+    double equalBefore = getEqualWeightedIndex();
+    double sectorBefore = getSectorIndex(constituent.sector);
+
+    totalMarketCap -= constituent.marketCap;
+    sectorMarketCap[idx] -= constituent.marketCap;
+    constituent.active = false;
+    activeCount--;
+
+    capDivisor = (totalMarketCap > 0.0) ? totalMarketCap / capBefore : 0.0;
+    capLevel = capBefore;
+    sectorDivisor[idx] = (sectorMarketCap[idx] > 0.0) ? sectorMarketCap[idx] / sectorBefore : 0.0;
+    sectorLevel[idx] = sectorBefore;
+
+    equalLevel = equalBefore;
+    reanchorEqualWeight();
+}
+
+void MarketIndex::onPriceChange(size_t slot, double newPrice, double newMarketCap) {
+    if (slot >= constituents.size()) {
+        return;
+    }
+
+    Constituent& constituent = constituents[slot];
+    if (!constituent.active) {
+        return;
+    }
+
+    size_t idx = sectorIndex(constituent.sector);
+    double capDelta = newMarketCap - constituent.marketCap;
+    totalMarketCap += capDelta;
+    sectorMarketCap[idx] += capDelta;
+
+    if (capDivisor <= 0.0 && totalMarketCap > 0.0) {
+        capDivisor = totalMarketCap / capLevel;
+    }
+    if (sectorDivisor[idx] <= 0.0 && sectorMarketCap[idx] > 0.0) {
+        sectorDivisor[idx] = sectorMarketCap[idx] / sectorLevel[idx];
+    }
+
+    if (constituent.anchorPrice > 0.0) {
+        equalWeightSum += (newPrice - constituent.price) / constituent.anchorPrice;
+    }
+
+    constituent.price = newPrice;
+    constituent.marketCap = newMarketCap;
+    updatesSinceRebase++;
+}
+
+void MarketIndex::reanchorEqualWeight() {
+    equalWeightSum = 0.0;
+
+    for (auto& constituent : constituents) {
+        if (constituent.active) {
+            constituent.anchorPrice = constituent.price;
+            equalWeightSum += 1.0;
+        }
+    }
+}
+
+void MarketIndex::rebuild(const std::vector<std::shared_ptr<Company>>& companies) {
+    double capBefore = getCapWeightedIndex();
+    double equalBefore = getEqualWeightedIndex();
+    std::array<double, SECTOR_COUNT> sectorsBefore;
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        sectorsBefore[i] = getSectorIndex(static_cast<Sector>(i));
+    }
+
+    constituents.clear();
+    constituents.reserve(companies.size());
+    activeCount = 0;
+    totalMarketCap = 0.0;
+    sectorMarketCap.fill(0.0);
+
+    for (const auto& company : companies) {
+        double price = company->getStock() ? company->getStock()->getCurrentPrice() : 0.0;
+        constituents.push_back({company->getSector(), price, company->getMarketCap(), price, true});
+        activeCount++;
+
+        totalMarketCap += company->getMarketCap();
+        sectorMarketCap[sectorIndex(company->getSector())] += company->getMarketCap();
+    }
+
+    setLevels(capBefore, equalBefore, sectorsBefore);
+}
+
+void MarketIndex::rebase() {
+    double equalBefore = getEqualWeightedIndex();
+
+    totalMarketCap = 0.0;
+    sectorMarketCap.fill(0.0);
+
+    for (const auto& constituent : constituents) {
+        if (constituent.active) {
+            totalMarketCap += constituent.marketCap;
+            sectorMarketCap[sectorIndex(constituent.sector)] += constituent.marketCap;
+        }
+    }
+
+    equalLevel = equalBefore;
+    reanchorEqualWeight();
+
+    updatesSinceRebase = 0;
+}
+
+double MarketIndex::getCapWeightedIndex() const {
+    return (capDivisor > 0.0) ? totalMarketCap / capDivisor : capLevel;
+}
+
+double MarketIndex::getEqualWeightedIndex() const {
+    return (activeCount > 0) ? equalLevel * equalWeightSum / activeCount : equalLevel;
+}
+
+double MarketIndex::getSectorIndex(Sector sector) const {
+    size_t idx = sectorIndex(sector);
+    return (sectorDivisor[idx] > 0.0) ? sectorMarketCap[idx] / sectorDivisor[idx] : sectorLevel[idx];
+}
+
+double MarketIndex::getTotalMarketCap() const {
+    return totalMarketCap;
+}
+
+size_t MarketIndex::getConstituentCount() const {
+    return activeCount;
+}
+
+int MarketIndex::getUpdatesSinceRebase() const {
+    return updatesSinceRebase;
+}
+
+void MarketIndex::setLevels(double capWeighted, double equalWeighted,
+                            const std::array<double, SECTOR_COUNT>& sectorLevels) {
+    capLevel = capWeighted;
+    capDivisor = (totalMarketCap > 0.0 && capWeighted > 0.0) ? totalMarketCap / capWeighted : 0.0;
+
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        sectorLevel[i] = sectorLevels[i];
+        sectorDivisor[i] = (sectorMarketCap[i] > 0.0 && sectorLevels[i] > 0.0)
+                               ? sectorMarketCap[i] / sectorLevels[i] : 0.0;
+    }
+
+    equalLevel = equalWeighted;
+    reanchorEqualWeight();
+    updatesSinceRebase = 0;
+}
+
+nlohmann::json MarketIndex::toJson() const {
+    nlohmann::json j;
+    j["cap_weighted"] = getCapWeightedIndex();
+    j["equal_weighted"] = getEqualWeightedIndex();
+
+    j["sectors"] = nlohmann::json::object();
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        Sector sector = static_cast<Sector>(i);
+        j["sectors"][Market::sectorToString(sector)] = getSectorIndex(sector);
+    }
+
+    return j;
+}
+
+void MarketIndex::restoreLevels(const nlohmann::json& json, double fallbackLevel) {
+    double capWeighted = json.value("cap_weighted", fallbackLevel);
+    double equalWeighted = json.value("equal_weighted", fallbackLevel);
+
+    std::array<double, SECTOR_COUNT> sectorLevels;
+    sectorLevels.fill(BASE_VALUE);
+
+    if (json.contains("sectors")) {
+        for (auto it = json["sectors"].begin(); it != json["sectors"].end(); ++it) {
+            sectorLevels[sectorIndex(Market::sectorFromString(it.key()))] = it.value();
+        }
+    }
+
+    setLevels(capWeighted, equalWeighted, sectorLevels);
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include "../models/Company.hpp"
+
+namespace StockMarketSimulator {
+
+class MarketIndex {
+private:
+    struct Constituent {
+        Sector sector;
+        double price;
+        double marketCap;
+        double anchorPrice;
+        bool active;
+    };
+
+    std::vector<Constituent> constituents;
+    size_t activeCount;
+
+    double totalMarketCap;
+    double capDivisor;
+    double capLevel;
+
+    double equalWeightSum;
+    double equalLevel;
+
+    std::array<double, SECTOR_COUNT> sectorMarketCap;
+    std::array<double, SECTOR_COUNT> sectorDivisor;
+    std::array<double, SECTOR_COUNT> sectorLevel;
+
+    int updatesSinceRebase;
+
+    void reanchorEqualWeight();
+
+public:
+    static constexpr double BASE_VALUE = 1000.0;
+
+    MarketIndex(double initialLevel = BASE_VALUE);
+
+    size_t addConstituent(Sector sector, double price, double marketCap);
+    void removeConstituent(size_t slot);
+    void onPriceChange(size_t slot, double newPrice, double newMarketCap);
+
+    void rebuild(const std::vector<std::shared_ptr<Company>>& companies);
+    void rebase();
+
+    double getCapWeightedIndex() const;
+    double getEqualWeightedIndex() const;
+    double getSectorIndex(Sector sector) const;
+    double getTotalMarketCap() const;
+    size_t getConstituentCount() const;
+    int getUpdatesSinceRebase() const;
+
+    void setLevels(double capWeighted, double equalWeighted,
+                   const std::array<double, SECTOR_COUNT>& sectorLevels);
+
+    nlohmann::json toJson() const;
+    void restoreLevels(const nlohmann::json& json, double fallbackLevel);
+};
+
+}
@@ -0,0 +1,48 @@
+#include "OrderExecutor.hpp"
+#include "Market.hpp"
+#include "Player.hpp"
+
+namespace StockMarketSimulator {
+
+OrderReport OrderExecutor::execute(Player& player, const Market& market, const OrderRequest& request) {
+    return execute(player, market.getCompanyByTicker(request.ticker), request, market.getCurrentDay());
+}
+
+OrderReport OrderExecutor::execute(Player& player, const std::shared_ptr<Company>& company,
+                                   const OrderRequest& request, int day) {
+    OrderReport report{request.clientOrderId, OrderStatus::Rejected, request.ticker,
+                       request.quantity, 0.0, day, ""};
+
+    if (!company || !company->getStock()) {
+        report.reason = "Unknown ticker";
+        return report;
+    }
+
+    if (request.quantity <= 0) {
+        report.reason = "Quantity must be positive";
+        return report;
+    }
+
+    report.price = company->getStock()->getCurrentPrice();
+
+    if (request.side == OrderSide::Buy) {
+        if (!player.buyStock(company, request.quantity, request.useMargin)) {
+            report.reason = request.useMargin ? "Insufficient buying power" : "Insufficient cash";
+            return report;
+        }
+    } else {
+        if (player.getPortfolio()->getPositionQuantity(request.ticker) < request.quantity) {
+            report.reason = "Insufficient position";
+            return report;
+        }
+        if (!player.sellStock(company, request.quantity)) {
+            report.reason = "Sell rejected";
+            return report;
+        }
+    }
+
+    report.status = OrderStatus::Filled;
+    return report;
+}
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+#include "../models/Order.hpp"
+#include "../models/Company.hpp"
+
+namespace StockMarketSimulator {
+
+class Player;
+class Market;
+
+// Validates an order against the player's cash and positions and executes it
+// at the company's current price. Used by every automated order source.
+class OrderExecutor {
+public:
+    static OrderReport execute(Player& player, const Market& market, const OrderRequest& request);
+    static OrderReport execute(Player& player, const std::shared_ptr<Company>& company,
+                               const OrderRequest& request, int day);
+};
+
+}
@@ -0,0 +1,599 @@
+#include "ParameterSweep.hpp"
+#include "Game.hpp"
+#include "../utils/Random.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+struct SweepJob {
+    size_t configurationIndex;
+    unsigned int seed;
+};
+
+bool startsWith(const std::string& value, const std::string& prefix) {
+    return value.compare(0, prefix.size(), prefix) == 0;
+}
+
+double drawdownPercent(double peak, double value) {
+    return (peak > 0.0) ? (peak - value) / peak * 100.0 : 0.0;
+}
+
+bool applySectorParameter(PriceService& priceService, const std::string& name, double value, std::string& error) {
+    size_t separator = name.find('.');
+    if (separator == std::string::npos) {
+        error = "Sector parameter needs a field: " + name;
+        return false;
+    }
+
+    std::string sectorName = name.substr(0, separator);
+    std::string field = name.substr(separator + 1);
+    Sector sector = Market::sectorFromString(sectorName);
+    if (Market::sectorToString(sector) != sectorName) {
+        error = "Unknown sector: " + sectorName;
+        return false;
+    }
+
+    SectorVolatilityProfile profile = priceService.getSectorProfile(sector);
+    if (field == "baseVolatility") {
+        profile.baseVolatility = value;
+    } else if (field == "marketSensitivity") {
+        profile.marketSensitivity = value;
+    } else if (field == "newsSensitivity") {
+        profile.newsSensitivity = value;
+    } else if (field == "cycleSensitivity") {
+        profile.cycleSensitivity = value;
+    } else {
+        error = "Unknown sector profile field: " + field;
+        return false;
+    }
+
+    priceService.setSectorProfile(sector, profile);
+    return true;
+}
+
+void writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t bytes = write(fd, data.data() + written, data.size() - written);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return;
+        }
+        written += static_cast<size_t>(bytes);
+    }
+}
+
+}
+
+void SweepSpace::addValues(const std::string& name, const std::vector<double>& values) {
+    if (values.empty()) {
+        throw std::invalid_argument("Sweep dimension needs at least one value: " + name);
+    }
+
+    auto minmax = std::minmax_element(values.begin(), values.end());
+    dimensions.push_back(SweepDimension{name, values, *minmax.first, *minmax.second, false});
+}
+
+void SweepSpace::addRange(const std::string& name, double minimum, double maximum, int steps) {
+    if (maximum < minimum) {
+        std::swap(minimum, maximum);
+    }
+
+    std::vector<double> values;
+    if (steps <= 1 || maximum == minimum) {
+        values.push_back(minimum);
+    } else {
+        for (int i = 0; i < steps; ++i) {
+            values.push_back(minimum + (maximum - minimum) * i / (steps - 1));
+        }
+    }
+
+    dimensions.push_back(SweepDimension{name, values, minimum, maximum, minimum < maximum});
+}
+
+const std::vector<SweepDimension>& SweepSpace::getDimensions() const {
+    return dimensions;
+}
+
+std::vector<SweepConfiguration> SweepSpace::grid() const {
+    std::vector<SweepConfiguration> configurations(1);
+
+    for (const auto& dimension : dimensions) {
+        std::vector<SweepConfiguration> expanded;
+        expanded.reserve(configurations.size() * dimension.values.size());
+        for (const auto& configuration : configurations) {
+            for (double value : dimension.values) {
+                SweepConfiguration next = configuration;
+                next[dimension.name] = value;
+                expanded.push_back(std::move(next));
+            }
+        }
+        configurations.swap(expanded);
+    }
+
+    return configurations;
+}
+
+std::vector<SweepConfiguration> SweepSpace::sample(size_t count, uint64_t seed) const {
+    std::mt19937_64 generator(seed);
+    std::vector<SweepConfiguration> configurations(count);
+
+    for (auto& configuration : configurations) {
+        for (const auto& dimension : dimensions) {
+            if (dimension.continuous) {
+                std::uniform_real_distribution<double> distribution(dimension.minimum, dimension.maximum);
+                configuration[dimension.name] = distribution(generator);
+            } else {
+                std::uniform_int_distribution<size_t> distribution(0, dimension.values.size() - 1);
+                configuration[dimension.name] = dimension.values[distribution(generator)];
+            }
+        }
+    }
+
+    return configurations;
+}
+
+SweepSpace SweepSpace::fromJson(const nlohmann::json& json) {
+    SweepSpace space;
+    for (auto it = json.begin(); it != json.end(); ++it) {
+        if (it->is_array()) {
+            space.addValues(it.key(), it->get<std::vector<double>>());
+        } else if (it->is_object()) {
+            space.addRange(it.key(), it->at("min").get<double>(), it->at("max").get<double>(),
+                           it->value("steps", 5));
+        } else {
+            space.addValues(it.key(), {it->get<double>()});
+        }
+    }
+    return space;
+}
+
+SweepOptions SweepOptions::fromJson(const nlohmann::json& json) {
+    SweepOptions options;
+    options.strategyName = json.value("strategy", std::string());
+    options.days = json.value("days", options.days);
+    options.seeds = json.value("seeds", options.seeds);
+    options.workers = json.value("workers", options.workers);
+    options.initialBalance = json.value("initial_balance", options.initialBalance);
+    options.warmupDays = json.value("warmup_days", options.warmupDays);
+    return options;
+}
+
+nlohmann::json SweepMetrics::toJson() const {
+    nlohmann::json j;
+    j["final_net_worth"] = finalNetWorth;
+    j["return_percent"] = returnPercent;
+    j["max_drawdown_percent"] = maxDrawdownPercent;
+    j["final_index"] = finalIndex;
+    j["index_return_percent"] = indexReturnPercent;
+    j["index_volatility"] = indexVolatility;
+    j["index_max_drawdown_percent"] = indexMaxDrawdownPercent;
+    return j;
+}
+
+SweepMetrics SweepMetrics::fromJson(const nlohmann::json& json) {
+    SweepMetrics metrics;
+    metrics.finalNetWorth = json.at("final_net_worth").get<double>();
+    metrics.returnPercent = json.at("return_percent").get<double>();
+    metrics.maxDrawdownPercent = json.at("max_drawdown_percent").get<double>();
+    metrics.finalIndex = json.at("final_index").get<double>();
+    metrics.indexReturnPercent = json.at("index_return_percent").get<double>();
+    metrics.indexVolatility = json.at("index_volatility").get<double>();
+    metrics.indexMaxDrawdownPercent = json.at("index_max_drawdown_percent").get<double>();
+    return metrics;
+}
+
+nlohmann::json SweepResult::toJson() const {
+    nlohmann::json j;
+    j["configuration"] = configurationIndex;
+    j["parameters"] = parameters;
+    j["seed"] = seed;
+    j["succeeded"] = succeeded;
+    if (succeeded) {
+        j["metrics"] = metrics.toJson();
+    } else {
+        j["error"] = error;
+    }
+    return j;
+}
+
+ParameterSweep::ParameterSweep(SweepOptions options)
+    : options(std::move(options))
+{
+    if (this->options.workers == 0) {
+        this->options.workers = 1;
+    }
+}
+
+bool ParameterSweep::warmStart() {
+    baseGame = std::make_shared<Game>();
+    baseGame->initialize("Sweep", options.initialBalance);
+    baseGame->getSaveService()->setAutosave(false);
+
+    if (!baseGame->start() || !baseGame->simulateDays(options.warmupDays)) {
+        lastError = "Warm start failed: " + baseGame->getLastError();
+        baseGame.reset();
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const std::vector<SweepConfiguration>& configurations) {
+    std::vector<SweepJob> jobs;
+    for (size_t i = 0; i < configurations.size(); ++i) {
+        for (unsigned int seed : options.seeds) {
+            jobs.push_back(SweepJob{i, seed});
+        }
+    }
+
+    std::vector<SweepResult> results(jobs.size());
+    for (size_t job = 0; job < jobs.size(); ++job) {
+        results[job].configurationIndex = jobs[job].configurationIndex;
+        results[job].parameters = configurations[jobs[job].configurationIndex];
+        results[job].seed = jobs[job].seed;
+    }
+
+    if (!baseGame && !warmStart()) {
+        for (auto& result : results) {
+            result.error = lastError;
+        }
+        return results;
+    }
+
+    std::vector<RunningChild> running;
+    std::vector<pollfd> fds;
+    size_t next = 0;
+
+    while (next < jobs.size() || !running.empty()) {
+        while (running.size() < options.workers && next < jobs.size()) {
+            RunningChild child;
+            if (launch(configurations[jobs[next].configurationIndex], jobs[next].seed, next, child)) {
+                running.push_back(std::move(child));
+            } else {
+                results[next].error = lastError;
+            }
+            ++next;
+        }
+
+        if (running.empty()) {
+            continue;
+        }
+
+        fds.clear();
+        for (const auto& child : running) {
+            fds.push_back({child.fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) {
+            lastError = "Failed to wait for sweep runs";
+            for (auto& child : running) {
+                kill(child.pid, SIGKILL);
+                collect(child);
+                results[child.job].error = lastError;
+            }
+            running.clear();
+            for (; next < jobs.size(); ++next) {
+                results[next].error = lastError;
+            }
+            break;
+        }
+
+        for (size_t i = running.size(); i-- > 0;) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+
+            char buffer[4096];
+            ssize_t bytes = read(running[i].fd, buffer, sizeof(buffer));
+            if (bytes > 0) {
+                running[i].output.append(buffer, static_cast<size_t>(bytes));
+                continue;
+            }
+            if (bytes < 0 && errno == EINTR) {
+                continue;
+            }
+
+            SweepResult collected = collect(running[i]);
+            SweepResult& result = results[running[i].job];
+            result.succeeded = collected.succeeded;
+            result.error = collected.error;
+            result.metrics = collected.metrics;
+            running.erase(running.begin() + i);
+        }
+    }
+
+    return results;
+}
+
+bool ParameterSweep::launch(const SweepConfiguration& configuration, unsigned int seed, size_t job,
+                            RunningChild& child) {
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) {
+        lastError = "Failed to create result pipe";
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(pipeFds[0]);
+        close(pipeFds[1]);
+        lastError = "Failed to fork sweep run";
+        return false;
+    }
+
+    if (pid == 0) {
+        close(pipeFds[0]);
+        SweepResult result;
+        try {
+            result = evaluate(*baseGame, options, configuration, seed);
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        writeAll(pipeFds[1], result.toJson().dump());
+        close(pipeFds[1]);
+        _exit(0);
+    }
+
+    close(pipeFds[1]);
+    child.pid = pid;
+    child.fd = pipeFds[0];
+    child.job = job;
+    return true;
+}
+
+SweepResult ParameterSweep::collect(RunningChild& child) {
+    close(child.fd);
+
+    int status = 0;
+    while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR) {
+    }
+
+    SweepResult result;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || child.output.empty()) {
+        result.error = "Sweep run exited abnormally";
+        return result;
+    }
+
+    try {
+        auto json = nlohmann::json::parse(child.output);
+        result.succeeded = json.at("succeeded").get<bool>();
+        if (result.succeeded) {
+            result.metrics = SweepMetrics::fromJson(json.at("metrics"));
+        } else {
+            result.error = json.value("error", std::string("Sweep run failed"));
+        }
+    } catch (const std::exception& e) {
+        result.error = "Malformed sweep result: " + std::string(e.what());
+    }
+
+    return result;
+}
+
+bool ParameterSweep::applyParameter(Game& game, const std::string& name, double value, std::string& error) {
+    auto priceService = game.getPriceService();
+    if (!priceService) {
+        error = "Price service not initialized";
+        return false;
+    }
+
+    if (startsWith(name, "sector.")) {
+        return applySectorParameter(*priceService, name.substr(7), value, error);
+    }
+
+    if (name == "price.marketVolatilityFactor") {
+        priceService->setMarketVolatilityFactor(value);
+    } else if (name == "price.trendStrength") {
+        priceService->setTrendStrength(value);
+    } else if (name == "price.momentumFactor") {
+        priceService->setMomentumFactor(value);
+    } else if (name == "price.randomnessFactor") {
+        priceService->setRandomnessFactor(value);
+    } else {
+        error = "Unknown sweep parameter: " + name;
+        return false;
+    }
+
+    return true;
+}
+
+SweepResult ParameterSweep::evaluate(Game& game, const SweepOptions& options,
+                                     const SweepConfiguration& configuration, unsigned int seed) {
+    SweepResult result;
+    result.parameters = configuration;
+    result.seed = seed;
+
+    Random::initialize(seed);
+
+    std::unique_ptr<Strategy> strategy;
+    if (!options.strategyName.empty()) {
+        strategy = StrategyRegistry::create(options.strategyName);
+        if (!strategy) {
+            result.error = "Unknown strategy: " + options.strategyName;
+            return result;
+        }
+    }
+
+    for (const auto& [name, value] : configuration) {
+        if (startsWith(name, "strategy.")) {
+            if (!strategy || !strategy->setParameter(name.substr(9), value)) {
+                result.error = "Unknown strategy parameter: " + name;
+                return result;
+            }
+        } else if (!applyParameter(game, name, value, result.error)) {
+            return result;
+        }
+    }
+
+    std::shared_ptr<Player> tracked = game.getPlayer();
+    if (strategy) {
+        if (!game.addStrategyAccount(std::move(strategy), "Sweep", options.initialBalance)) {
+            result.error = game.getLastError();
+            return result;
+        }
+        const StrategyEngine& engine = game.getStrategyEngine();
+        tracked = engine.getPlayer(engine.getAccountCount() - 1);
+    }
+
+    auto market = game.getMarket();
+    double startWorth = tracked->getNetWorth();
+    double startIndex = market->getMarketIndex();
+    double worthPeak = startWorth;
+    double indexPeak = startIndex;
+    double changeSum = 0.0;
+    double changeSquares = 0.0;
+
+    for (int day = 0; day < options.days; ++day) {
+        if (!game.simulateDay()) {
+            result.error = game.getLastError();
+            return result;
+        }
+
+        double worth = tracked->getNetWorth();
+        double index = market->getMarketIndex();
+        worthPeak = std::max(worthPeak, worth);
+        indexPeak = std::max(indexPeak, index);
+        result.metrics.maxDrawdownPercent = std::max(result.metrics.maxDrawdownPercent,
+                                                     drawdownPercent(worthPeak, worth));
+        result.metrics.indexMaxDrawdownPercent = std::max(result.metrics.indexMaxDrawdownPercent,
+                                                          drawdownPercent(indexPeak, index));
+
+        double change = market->getState().dailyChangePercent;
+        changeSum += change;
+        changeSquares += change * change;
+    }
+
+    result.metrics.finalNetWorth = tracked->getNetWorth();
+    result.metrics.returnPercent = (startWorth > 0.0) ? (result.metrics.finalNetWorth / startWorth - 1.0) * 100.0 : 0.0;
+    result.metrics.finalIndex = market->getMarketIndex();
+    result.metrics.indexReturnPercent = (startIndex > 0.0) ? (result.metrics.finalIndex / startIndex - 1.0) * 100.0 : 0.0;
+    if (options.days > 0) {
+        double mean = changeSum / options.days;
+        result.metrics.indexVolatility = std::sqrt(std::max(0.0, changeSquares / options.days - mean * mean));
+    }
+
+    result.succeeded = true;
+    return result;
+}
+
+std::vector<SweepSummary> ParameterSweep::summarize(const std::vector<SweepResult>& results) {
+    std::map<size_t, SweepSummary> byConfiguration;
+
+    for (const auto& result : results) {
+        if (!result.succeeded) {
+            continue;
+        }
+
+        SweepSummary& summary = byConfiguration[result.configurationIndex];
+        summary.parameters = result.parameters;
+        summary.runs++;
+        summary.mean.finalNetWorth += result.metrics.finalNetWorth;
+        summary.mean.returnPercent += result.metrics.returnPercent;
+        summary.mean.maxDrawdownPercent += result.metrics.maxDrawdownPercent;
+        summary.mean.finalIndex += result.metrics.finalIndex;
+        summary.mean.indexReturnPercent += result.metrics.indexReturnPercent;
+        summary.mean.indexVolatility += result.metrics.indexVolatility;
+        summary.mean.indexMaxDrawdownPercent += result.metrics.indexMaxDrawdownPercent;
+    }
+
+    std::vector<SweepSummary> summaries;
+    for (auto& entry : byConfiguration) {
+        SweepSummary& summary = entry.second;
+        double runs = static_cast<double>(summary.runs);
+        summary.mean.finalNetWorth /= runs;
+        summary.mean.returnPercent /= runs;
+        summary.mean.maxDrawdownPercent /= runs;
+        summary.mean.finalIndex /= runs;
+        summary.mean.indexReturnPercent /= runs;
+        summary.mean.indexVolatility /= runs;
+        summary.mean.indexMaxDrawdownPercent /= runs;
+        summaries.push_back(std::move(summary));
+    }
+
+    // Best configuration first.
+    std::stable_sort(summaries.begin(), summaries.end(), [](const SweepSummary& a, const SweepSummary& b) {
+        return a.mean.finalNetWorth > b.mean.finalNetWorth;
+    });
+    return summaries;
+}
+
+nlohmann::json ParameterSweep::toJson(const std::vector<SweepResult>& results) {
+    nlohmann::json runs = nlohmann::json::array();
+    for (const auto& result : results) {
+        runs.push_back(result.toJson());
+    }
+
+    nlohmann::json summaries = nlohmann::json::array();
+    for (const auto& summary : summarize(results)) {
+        nlohmann::json j;
+        j["parameters"] = summary.parameters;
+        j["runs"] = summary.runs;
+        j["mean"] = summary.mean.toJson();
+        summaries.push_back(j);
+    }
+
+    nlohmann::json j;
+    j["runs"] = runs;
+    j["summary"] = summaries;
+    return j;
+}
+
+std::string ParameterSweep::formatTable(const std::vector<SweepSummary>& summaries) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+
+    std::vector<std::string> names;
+    if (!summaries.empty()) {
+        for (const auto& entry : summaries.front().parameters) {
+            names.push_back(entry.first);
+        }
+    }
+
+    for (const auto& name : names) {
+        out << std::setw(std::max<int>(12, static_cast<int>(name.size()) + 2)) << name;
+    }
+    out << std::setw(6) << "runs" << std::setw(16) << "net worth" << std::setw(10) << "return%"
+        << std::setw(10) << "maxDD%" << std::setw(10) << "index%" << std::setw(10) << "indexVol"
+        << "\n";
+
+    for (const auto& summary : summaries) {
+        for (const auto& name : names) {
+            auto it = summary.parameters.find(name);
+            out << std::setw(std::max<int>(12, static_cast<int>(name.size()) + 2))
+                << (it != summary.parameters.end() ? it->second : 0.0);
+        }
+        out << std::setw(6) << summary.runs
+            << std::setw(16) << summary.mean.finalNetWorth
+            << std::setw(10) << summary.mean.returnPercent
+            << std::setw(10) << summary.mean.maxDrawdownPercent
+            << std::setw(10) << summary.mean.indexReturnPercent
+            << std::setw(10) << summary.mean.indexVolatility
+            << "\n";
+    }
+
+    return out.str();
+}
+
+std::string ParameterSweep::getLastError() const {
+    return lastError;
+}
+
+const SweepOptions& ParameterSweep::getOptions() const {
+    return options;
+}
+
+}
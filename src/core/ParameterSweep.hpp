@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace StockMarketSimulator {
+
+class Game;
+
+// Parameter name -> value. Names are "price.<setting>",
+// "sector.<Sector>.<profileField>" or "strategy.<parameter>".
+using SweepConfiguration = std::map<std::string, double>;
+
+struct SweepDimension {
+    std::string name;
+    std::vector<double> values;
+    double minimum;
+    double maximum;
+    bool continuous;
+};
+
+// A search space: each dimension is either an explicit value list or a
+// [minimum, maximum] range that is split into steps for grids and sampled
+// uniformly for random search.
+class SweepSpace {
+private:
+    std::vector<SweepDimension> dimensions;
+
+public:
+    void addValues(const std::string& name, const std::vector<double>& values);
+    void addRange(const std::string& name, double minimum, double maximum, int steps);
+
+    const std::vector<SweepDimension>& getDimensions() const;
+
+    std::vector<SweepConfiguration> grid() const;
+    std::vector<SweepConfiguration> sample(size_t count, uint64_t seed) const;
+
+    static SweepSpace fromJson(const nlohmann::json& json);
+};
+
+struct SweepOptions {
+    std::string strategyName;
+    int days = 250;
+    std::vector<unsigned int> seeds = {1};
+    size_t workers = 1;
+    double initialBalance = 100000.0;
+    int warmupDays = 0;
+
+    static SweepOptions fromJson(const nlohmann::json& json);
+};
+
+struct SweepMetrics {
+    double finalNetWorth = 0.0;
+    double returnPercent = 0.0;
+    double maxDrawdownPercent = 0.0;
+    double finalIndex = 0.0;
+    double indexReturnPercent = 0.0;
+    double indexVolatility = 0.0;
+    double indexMaxDrawdownPercent = 0.0;
+
+    nlohmann::json toJson() const;
+    static SweepMetrics fromJson(const nlohmann::json& json);
+};
+
+struct SweepResult {
+    size_t configurationIndex = 0;
+    SweepConfiguration parameters;
+    unsigned int seed = 0;
+    bool succeeded = false;
+    std::string error;
+    SweepMetrics metrics;
+
+    nlohmann::json toJson() const;
+};
+
+struct SweepSummary {
+    SweepConfiguration parameters;
+    size_t runs = 0;
+    SweepMetrics mean;
+};
+
+// Evaluates configurations against one warm-started game. Every run forks
+// from that game, so initialization is paid once and concurrent runs never
+// share the global Random generator.
+class ParameterSweep {
+private:
+    struct RunningChild {
+        int pid;
+        int fd;
+        size_t job;
+        std::string output;
+    };
+
+    SweepOptions options;
+    std::shared_ptr<Game> baseGame;
+    std::string lastError;
+
+    bool launch(const SweepConfiguration& configuration, unsigned int seed, size_t job, RunningChild& child);
+    static SweepResult collect(RunningChild& child);
+
+public:
+    explicit ParameterSweep(SweepOptions options);
+
+    bool warmStart();
+    std::vector<SweepResult> run(const std::vector<SweepConfiguration>& configurations);
+
+    std::string getLastError() const;
+    const SweepOptions& getOptions() const;
+
+    static bool applyParameter(Game& game, const std::string& name, double value, std::string& error);
+    static SweepResult evaluate(Game& game, const SweepOptions& options,
+                                const SweepConfiguration& configuration, unsigned int seed);
+
+    static std::vector<SweepSummary> summarize(const std::vector<SweepResult>& results);
+    static nlohmann::json toJson(const std::vector<SweepResult>& results);
+    static std::string formatTable(const std::vector<SweepSummary>& summaries);
+};
+
+}
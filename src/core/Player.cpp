@@ -26,6 +26,34 @@ Player::Player(const std::string& name, double initialBalance)
 {
 }
 
+Player::Player(const Player& other)
+    : name(other.name),
+      portfolio(std::make_unique<Portfolio>(*other.portfolio)),
+      loans(other.loans),
+      marginLoan(other.marginLoan),
+      marginInterestRate(other.marginInterestRate),
+      marginLimitMultiplier(other.marginLimitMultiplier),
+      currentDate(other.currentDate),
+      market(other.market),
+      loansVersion(other.loansVersion)
+{
+}
+
+Player& Player::operator=(const Player& other) {
+    if (this != &other) {
+        name = other.name;
+        portfolio = std::make_unique<Portfolio>(*other.portfolio);
+        loans = other.loans;
+        marginLoan = other.marginLoan;
+        marginInterestRate = other.marginInterestRate;
+        marginLimitMultiplier = other.marginLimitMultiplier;
+        currentDate = other.currentDate;
+        market = other.market;
+        loansVersion = other.loansVersion;
+    }
+    return *this;
+}
+
 std::string Player::getName() const {
     return name;
 }
@@ -71,6 +99,10 @@ const std::vector<Loan>& Player::getLoans() const {
     return loans;
 }
 
+uint64_t Player::getLoansVersion() const {
+    return loansVersion.get();
+}
+
 Date Player::getCurrentDate() const {
     return currentDate;
 }
@@ -105,6 +137,7 @@ void Player::accrueMarginInterest() {
     if (marginLoan > 0.0) {
         double dailyInterest = marginLoan * (marginInterestRate / 7.0);
         marginLoan += dailyInterest;
+        loansVersion.bump();
     }
 }
 
@@ -132,6 +165,7 @@ bool Player::buyStock(std::shared_ptr<Company> company, int quantity, bool useMa
 
         if (marginNeeded <= getMaxMarginLoan()) {
             marginLoan += marginNeeded;
+            loansVersion.bump();
 
             portfolio->depositCash(marginNeeded);
 
@@ -190,6 +224,7 @@ bool Player::takeLoan(double amount, double interestRate, int durationDays, cons
 
     Loan newLoan(amount, interestRate, durationDays, currentDate, 0.001, description);
     loans.push_back(newLoan);
+    loansVersion.bump();
 
     portfolio->depositCash(amount);
 
@@ -219,6 +254,7 @@ bool Player::repayLoan(size_t loanIndex, double amount) {
     if (amountToRepay >= totalDue) {
         loan.markAsPaid();
     }
+    loansVersion.bump();
 
     return true;
 }
@@ -251,6 +287,7 @@ bool Player::takeMarginLoan(double amount) {
     }
 
     marginLoan += amount;
+    loansVersion.bump();
     portfolio->depositCash(amount);
     return true;
 }
@@ -265,6 +302,7 @@ bool Player::repayMarginLoan(double amount) {
     }
 
     marginLoan -= amount;
+    loansVersion.bump();
     portfolio->withdrawCash(amount);
     return true;
 }
@@ -290,10 +328,21 @@ bool Player::repayMarginLoan(double amount) {
 // }
 
 void Player::updateDailyState() {
+    updateValuations();
+    processDividendIncome();
+    processLoans();
+    processMarginRequirements();
+}
+
+void Player::updateValuations() {
     portfolio->updatePositionValues();
+}
+
+void Player::processDividendIncome() {
     portfolio->checkDividendPayments(currentDate);
-    processLoans();
+}
 
+void Player::processMarginRequirements() {
     accrueMarginInterest();
 
     if (checkMarginCall()) {
@@ -335,9 +384,13 @@ void Player::updateDailyState() {
 }
 
 void Player::processLoans() {
+    bool changed = false;
+
     for (auto& loan : loans) {
         if (!loan.getIsPaid()) {
+            double dueBefore = loan.getTotalDue();
             loan.update(currentDate);
+            changed = changed || loan.getTotalDue() != dueBefore;
 
             if (loan.getDueDate() == currentDate) {
                 double totalDue = loan.getTotalDue();
@@ -345,10 +398,15 @@ void Player::processLoans() {
                 if (portfolio->getCashBalance() >= totalDue) {
                     portfolio->withdrawCash(totalDue);
                     loan.markAsPaid();
+                    changed = true;
                 }
             }
         }
     }
+
+    if (changed) {
+        loansVersion.bump();
+    }
 }
 
 void Player::closeDay() {
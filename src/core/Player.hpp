@@ -8,6 +8,7 @@
 #include "../models/Loan.hpp"
 #include "../models/Transaction.hpp"
 #include "../utils/Date.hpp"
+#include "../utils/ChangeVersion.hpp"
 
 namespace StockMarketSimulator {
 
@@ -23,12 +24,16 @@ private:
     double marginLimitMultiplier;
     Date currentDate;
     std::weak_ptr<Market> market;
+    ChangeVersion loansVersion;
 
     void accrueMarginInterest();
 
 public:
     Player();
     Player(const std::string& name, double initialBalance = 10000.0);
+    Player(const Player& other);
+
+    Player& operator=(const Player& other);
 
     std::string getName() const;
     Portfolio* getPortfolio() const;
@@ -39,6 +44,7 @@ public:
     double getTotalLiabilities() const;
     double getNetWorth() const;
     const std::vector<Loan>& getLoans() const;
+    uint64_t getLoansVersion() const;
     Date getCurrentDate() const;
     int getCurrentDay() const;
 
@@ -61,7 +67,10 @@ public:
     void receiveDividends(std::shared_ptr<Company> company, double amountPerShare);
     
     void updateDailyState();
+    void updateValuations();
+    void processDividendIncome();
     void processLoans();
+    void processMarginRequirements();
     void closeDay();
     void openDay();
     
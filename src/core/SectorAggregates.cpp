@@ -0,0 +1,159 @@
+#include "SectorAggregates.hpp"
+#include "Market.hpp"
+
+namespace StockMarketSimulator {
+
+SectorSnapshot::SectorSnapshot()
+    : indexValue(1000.0),
+      capWeightedChangePercent(0.0),
+      averageChangePercent(0.0),
+      totalMarketCap(0.0),
+      advancers(0),
+      decliners(0),
+      unchanged(0),
+      companyCount(0)
+{
+}
+
+nlohmann::json SectorSnapshot::toJson() const {
+    nlohmann::json j;
+    j["index_value"] = indexValue;
+    j["cap_weighted_change_percent"] = capWeightedChangePercent;
+    j["average_change_percent"] = averageChangePercent;
+    j["total_market_cap"] = totalMarketCap;
+    j["advancers"] = advancers;
+    j["decliners"] = decliners;
+    j["unchanged"] = unchanged;
+    j["company_count"] = companyCount;
+    return j;
+}
+
+SectorSnapshot SectorSnapshot::fromJson(const nlohmann::json& json) {
+    SectorSnapshot snapshot;
+    snapshot.indexValue = json.value("index_value", 1000.0);
+    snapshot.capWeightedChangePercent = json.value("cap_weighted_change_percent", 0.0);
+    snapshot.averageChangePercent = json.value("average_change_percent", 0.0);
+    snapshot.totalMarketCap = json.value("total_market_cap", 0.0);
+    snapshot.advancers = json.value("advancers", 0);
+    snapshot.decliners = json.value("decliners", 0);
+    snapshot.unchanged = json.value("unchanged", 0);
+    snapshot.companyCount = json.value("company_count", 0);
+    return snapshot;
+}
+
+SectorAggregates::SectorAggregates() {
+    weightedChangeSum.fill(0.0);
+    previousCapSum.fill(0.0);
+    changeSum.fill(0.0);
+}
+
+void SectorAggregates::beginDay() {
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        SectorSnapshot& snapshot = sectors[i];
+        snapshot.totalMarketCap = 0.0;
+        snapshot.advancers = 0;
+        snapshot.decliners = 0;
+        snapshot.unchanged = 0;
+        snapshot.companyCount = 0;
+
+        weightedChangeSum[i] = 0.0;
+        previousCapSum[i] = 0.0;
+        changeSum[i] = 0.0;
+    }
+}
+
+void SectorAggregates::accumulate(Sector sector, double previousClose, double currentPrice, double marketCap) {
+    size_t idx = sectorIndex(sector);
+    SectorSnapshot& snapshot = sectors[idx];
+
+    double change = (previousClose > 0.0) ? (currentPrice - previousClose) / previousClose : 0.0;
+    double previousCap = (currentPrice > 0.0) ? marketCap * (previousClose / currentPrice) : 0.0;
+
+    snapshot.totalMarketCap += marketCap;
+    snapshot.companyCount++;
+    snapshot.advancers += (change > 0.0);
+    snapshot.decliners += (change < 0.0);
+    snapshot.unchanged += (change == 0.0);
+
+    weightedChangeSum[idx] += previousCap * change;
+    previousCapSum[idx] += previousCap;
+    changeSum[idx] += change;
+}
+
+void SectorAggregates::accumulate(const Company& company) {
+    const Stock* stock = company.getStock();
+    if (!stock) {
+        return;
+    }
+
+    accumulate(company.getSector(), stock->getPreviousClosePrice(),
+               stock->getCurrentPrice(), company.getMarketCap());
+}
+
+void SectorAggregates::finishDay() {
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        SectorSnapshot& snapshot = sectors[i];
+
+        if (snapshot.companyCount == 0) {
+            snapshot.capWeightedChangePercent = 0.0;
+            snapshot.averageChangePercent = 0.0;
+            continue;
+        }
+
+        double weightedChange = (previousCapSum[i] > 0.0) ? weightedChangeSum[i] / previousCapSum[i] : 0.0;
+
+        snapshot.capWeightedChangePercent = weightedChange * 100.0;
+        snapshot.averageChangePercent = (changeSum[i] / snapshot.companyCount) * 100.0;
+    }
+}
+
+void SectorAggregates::setIndexValue(Sector sector, double value) {
+    sectors[sectorIndex(sector)].indexValue = value;
+}
+
+const SectorSnapshot& SectorAggregates::get(Sector sector) const {
+    return sectors[sectorIndex(sector)];
+}
+
+const std::array<SectorSnapshot, SECTOR_COUNT>& SectorAggregates::getAll() const {
+    return sectors;
+}
+
+int SectorAggregates::getAdvancers() const {
+    int total = 0;
+    for (const auto& snapshot : sectors) {
+        total += snapshot.advancers;
+    }
+    return total;
+}
+
+int SectorAggregates::getDecliners() const {
+    int total = 0;
+    for (const auto& snapshot : sectors) {
+        total += snapshot.decliners;
+    }
+    return total;
+}
+
+nlohmann::json SectorAggregates::toJson() const {
+    nlohmann::json j = nlohmann::json::object();
+
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        j[Market::sectorToString(static_cast<Sector>(i))] = sectors[i].toJson();
+    }
+
+    return j;
+}
+
+SectorAggregates SectorAggregates::fromJson(const nlohmann::json& json) {
+    SectorAggregates aggregates;
+
+    for (auto it = json.begin(); it != json.end(); ++it) {
+        Sector sector = Market::sectorFromString(it.key());
+        aggregates.sectors[sectorIndex(sector)] = SectorSnapshot::fromJson(it.value());
+    }
+
+    return aggregates;
+}
+
+}
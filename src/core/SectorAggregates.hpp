@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <nlohmann/json.hpp>
+#include "../models/Company.hpp"
+
+namespace StockMarketSimulator {
+
+struct SectorSnapshot {
+    double indexValue;
+    double capWeightedChangePercent;
+    double averageChangePercent;
+    double totalMarketCap;
+    int advancers;
+    int decliners;
+    int unchanged;
+    int companyCount;
+
+    SectorSnapshot();
+
+    nlohmann::json toJson() const;
+    static SectorSnapshot fromJson(const nlohmann::json& json);
+};
+
+class SectorAggregates {
+private:
+    std::array<SectorSnapshot, SECTOR_COUNT> sectors;
+
+    std::array<double, SECTOR_COUNT> weightedChangeSum;
+    std::array<double, SECTOR_COUNT> previousCapSum;
+    std::array<double, SECTOR_COUNT> changeSum;
+
+public:
+    SectorAggregates();
+
+    void beginDay();
+    void accumulate(Sector sector, double previousClose, double currentPrice, double marketCap);
+    void accumulate(const Company& company);
+    void finishDay();
+
+    void setIndexValue(Sector sector, double value);
+
+    const SectorSnapshot& get(Sector sector) const;
+    const std::array<SectorSnapshot, SECTOR_COUNT>& getAll() const;
+
+    int getAdvancers() const;
+    int getDecliners() const;
+
+    nlohmann::json toJson() const;
+    static SectorAggregates fromJson(const nlohmann::json& json);
+};
+
+}
@@ -0,0 +1,205 @@
+#include "Strategy.hpp"
+#include "Market.hpp"
+#include "Player.hpp"
+#include "../utils/FileIO.hpp"
+#include <algorithm>
+#include <dlfcn.h>
+#include <map>
+#include <mutex>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+constexpr double STRATEGY_COMMISSION = 0.01;
+
+int affordableQuantity(double budget, double price) {
+    if (price <= 0.0 || budget <= 0.0) {
+        return 0;
+    }
+    return static_cast<int>(budget / (price * (1.0 + STRATEGY_COMMISSION)));
+}
+
+// Splits the starting cash evenly across every listed company and holds.
+class BuyAndHoldStrategy : public Strategy {
+private:
+    bool invested = false;
+
+public:
+    std::string getName() const override {
+        return "buy-and-hold";
+    }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<BuyAndHoldStrategy>(*this);
+    }
+
+    void onDay(const StrategyContext& context, std::vector<OrderRequest>& orders) override {
+        if (invested) {
+            return;
+        }
+        invested = true;
+
+        const auto& companies = context.market.getCompanies();
+        if (companies.empty()) {
+            return;
+        }
+
+        double budget = context.portfolio.getCashBalance() / companies.size();
+        for (const auto& company : companies) {
+            int quantity = affordableQuantity(budget, company->getStock()->getCurrentPrice());
+            if (quantity > 0) {
+                orders.push_back({orders.size() + 1, OrderSide::Buy, company->getTicker(), quantity, false});
+            }
+        }
+    }
+};
+
+// Buys names that rallied today and exits held names that fell.
+class MomentumStrategy : public Strategy {
+private:
+    double entryThreshold;
+    double exitThreshold;
+    double positionFraction;
+    uint64_t nextOrderId = 1;
+
+public:
+    MomentumStrategy(double entryThreshold = 1.0, double exitThreshold = -1.0, double positionFraction = 0.1)
+        : entryThreshold(entryThreshold),
+          exitThreshold(exitThreshold),
+          positionFraction(positionFraction)
+    {
+    }
+
+    std::string getName() const override {
+        return "momentum";
+    }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<MomentumStrategy>(*this);
+    }
+
+    bool setParameter(const std::string& name, double value) override {
+        if (name == "entryThreshold") {
+            entryThreshold = value;
+        } else if (name == "exitThreshold") {
+            exitThreshold = value;
+        } else if (name == "positionFraction") {
+            positionFraction = std::clamp(value, 0.0, 1.0);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void onDay(const StrategyContext& context, std::vector<OrderRequest>& orders) override {
+        double budget = context.portfolio.getCashBalance() * positionFraction;
+
+        for (const auto& company : context.market.getCompanies()) {
+            const Stock* stock = company->getStock();
+            double change = stock->getDayChangePercent();
+            const std::string& ticker = company->getTicker();
+            int held = context.portfolio.getPositionQuantity(ticker);
+
+            if (held > 0 && change <= exitThreshold) {
+                orders.push_back({nextOrderId++, OrderSide::Sell, ticker, held, false});
+            } else if (held == 0 && change >= entryThreshold) {
+                int quantity = affordableQuantity(budget, stock->getCurrentPrice());
+                if (quantity > 0) {
+                    orders.push_back({nextOrderId++, OrderSide::Buy, ticker, quantity, false});
+                }
+            }
+        }
+    }
+};
+
+struct RegistryState {
+    std::mutex mutex;
+    std::map<std::string, StrategyRegistry::Factory> factories;
+    std::vector<void*> pluginHandles;
+
+    RegistryState() {
+        factories["buy-and-hold"] = [] { return std::make_unique<BuyAndHoldStrategy>(); };
+        factories["momentum"] = [] { return std::make_unique<MomentumStrategy>(); };
+    }
+};
+
+RegistryState& registry() {
+    static RegistryState state;
+    return state;
+}
+
+}
+
+bool StrategyRegistry::registerStrategy(const std::string& name, Factory factory) {
+    if (name.empty() || !factory) {
+        return false;
+    }
+
+    auto& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.factories.emplace(name, std::move(factory)).second;
+}
+
+std::unique_ptr<Strategy> StrategyRegistry::create(const std::string& name) {
+    Factory factory;
+    {
+        auto& state = registry();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.factories.find(name);
+        if (it == state.factories.end()) {
+            return nullptr;
+        }
+        factory = it->second;
+    }
+    return factory();
+}
+
+bool StrategyRegistry::contains(const std::string& name) {
+    auto& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.factories.count(name) > 0;
+}
+
+std::vector<std::string> StrategyRegistry::getNames() {
+    auto& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    std::vector<std::string> names;
+    names.reserve(state.factories.size());
+    for (const auto& entry : state.factories) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+bool StrategyRegistry::loadPlugin(const std::string& path, std::string& error) {
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        const char* message = dlerror();
+        error = message ? message : "Failed to load strategy plugin: " + path;
+        return false;
+    }
+
+    using EntryPoint = void (*)();
+    auto entry = reinterpret_cast<EntryPoint>(dlsym(handle, SMP_STRATEGY_PLUGIN_SYMBOL));
+    if (!entry) {
+        error = "Strategy plugin does not export " SMP_STRATEGY_PLUGIN_SYMBOL ": " + path;
+        dlclose(handle);
+        return false;
+    }
+
+    // Plugins stay loaded for the life of the process because the strategies
+    // they register are constructed from code inside the library.
+    {
+        auto& state = registry();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.pluginHandles.push_back(handle);
+    }
+    entry();
+
+    FileIO::appendToLog("Loaded strategy plugin " + path);
+    return true;
+}
+
+}
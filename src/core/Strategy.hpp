@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../models/Order.hpp"
+
+namespace StockMarketSimulator {
+
+class Market;
+class Player;
+class Portfolio;
+
+// Read-only view handed to a strategy once per simulated day, after prices
+// have moved. Orders returned from onDay() fill at the current prices.
+struct StrategyContext {
+    const Market& market;
+    const Player& player;
+    const Portfolio& portfolio;
+    int day;
+};
+
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    virtual std::string getName() const = 0;
+    virtual void onDay(const StrategyContext& context, std::vector<OrderRequest>& orders) = 0;
+
+    // Tunable knobs for parameter sweeps; returns false for unknown names.
+    virtual bool setParameter(const std::string& name, double value) {
+        (void)name;
+        (void)value;
+        return false;
+    }
+
+    // Copies the strategy together with its running state so checkpoints can
+    // restore it on rewind. Strategies returning null keep their live state.
+    virtual std::unique_ptr<Strategy> clone() const {
+        return nullptr;
+    }
+};
+
+// Name-keyed strategy factories. Built-in strategies are always available;
+// shared-library plugins add their own by exporting SMP_STRATEGY_PLUGIN_ENTRY.
+class StrategyRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<Strategy>()>;
+
+    static bool registerStrategy(const std::string& name, Factory factory);
+    static std::unique_ptr<Strategy> create(const std::string& name);
+    static bool contains(const std::string& name);
+    static std::vector<std::string> getNames();
+
+    static bool loadPlugin(const std::string& path, std::string& error);
+};
+
+}
+
+#define SMP_STRATEGY_PLUGIN_SYMBOL "smpRegisterStrategies"
+#define SMP_STRATEGY_PLUGIN_ENTRY extern "C" void smpRegisterStrategies()
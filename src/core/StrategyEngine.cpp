@@ -0,0 +1,137 @@
+#include "StrategyEngine.hpp"
+#include "Market.hpp"
+#include "Player.hpp"
+#include "OrderExecutor.hpp"
+#include <stdexcept>
+
+namespace StockMarketSimulator {
+
+size_t StrategyEngine::addAccount(std::shared_ptr<Player> player, std::unique_ptr<Strategy> strategy) {
+    if (!player || !strategy) {
+        throw std::invalid_argument("Strategy account requires a player and a strategy");
+    }
+
+    accounts.push_back(Account{std::move(player), std::move(strategy), {}, {}, {}});
+    return accounts.size() - 1;
+}
+
+void StrategyEngine::clear() {
+    accounts.clear();
+    companyIndex.clear();
+}
+
+size_t StrategyEngine::getAccountCount() const {
+    return accounts.size();
+}
+
+std::shared_ptr<Player> StrategyEngine::getPlayer(size_t index) const {
+    return accounts.at(index).player;
+}
+
+const Strategy& StrategyEngine::getStrategy(size_t index) const {
+    return *accounts.at(index).strategy;
+}
+
+const StrategyAccountStats& StrategyEngine::getStats(size_t index) const {
+    return accounts.at(index).stats;
+}
+
+const std::vector<OrderReport>& StrategyEngine::getLastReports(size_t index) const {
+    return accounts.at(index).reports;
+}
+
+void StrategyEngine::setParallelMode(std::shared_ptr<WorkStealingPool> pool) {
+    this->pool = pool;
+}
+
+std::vector<StrategyAccountSnapshot> StrategyEngine::snapshot() const {
+    std::vector<StrategyAccountSnapshot> snapshots;
+    snapshots.reserve(accounts.size());
+    for (const auto& account : accounts) {
+        snapshots.push_back(StrategyAccountSnapshot{std::make_shared<Player>(*account.player),
+                                                    account.strategy->clone(), account.stats});
+    }
+    return snapshots;
+}
+
+void StrategyEngine::restore(const std::vector<StrategyAccountSnapshot>& snapshots,
+                             const std::shared_ptr<Market>& market) {
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        Account& account = accounts[i];
+        if (i < snapshots.size()) {
+            *account.player = *snapshots[i].player;
+            if (snapshots[i].strategy) {
+                account.strategy = snapshots[i].strategy->clone();
+            }
+            account.stats = snapshots[i].stats;
+            account.orders.clear();
+            account.reports.clear();
+        }
+
+        account.player->setMarket(market);
+        account.player->getPortfolio()->rebindCompanies(market->getCompanies());
+    }
+    companyIndex.clear();
+}
+
+void StrategyEngine::runDay(const Market& market) {
+    if (accounts.empty()) {
+        return;
+    }
+
+    // Built once per day and only read while accounts run concurrently.
+    const auto& companies = market.getCompanies();
+    companyIndex.clear();
+    companyIndex.reserve(companies.size());
+    for (const auto& company : companies) {
+        companyIndex.emplace(company->getTicker(), company);
+    }
+
+    int day = market.getCurrentDay();
+    if (pool && accounts.size() > 1) {
+        pool->parallelFor(0, accounts.size(), 1, [this, &market, day](size_t i) {
+            runAccount(accounts[i], market, day);
+        });
+    } else {
+        for (auto& account : accounts) {
+            runAccount(account, market, day);
+        }
+    }
+}
+
+void StrategyEngine::runAccount(Account& account, const Market& market, int day) {
+    Player& player = *account.player;
+
+    player.updateValuations();
+    player.processDividendIncome();
+    player.processLoans();
+    player.processMarginRequirements();
+
+    account.orders.clear();
+    account.reports.clear();
+
+    StrategyContext context{market, player, *player.getPortfolio(), day};
+    account.strategy->onDay(context, account.orders);
+    account.stats.decisions++;
+
+    for (const auto& order : account.orders) {
+        auto it = companyIndex.find(order.ticker);
+        std::shared_ptr<Company> company = (it != companyIndex.end()) ? it->second : nullptr;
+
+        OrderReport report = OrderExecutor::execute(player, company, order, day);
+        if (report.status == OrderStatus::Filled) {
+            account.stats.ordersFilled++;
+        } else {
+            account.stats.ordersRejected++;
+        }
+        account.reports.push_back(std::move(report));
+    }
+    account.stats.ordersSubmitted += account.orders.size();
+
+    if (!account.orders.empty()) {
+        player.updateValuations();
+    }
+    player.closeDay();
+}
+
+}
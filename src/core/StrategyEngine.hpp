@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Strategy.hpp"
+#include "../utils/WorkStealingPool.hpp"
+
+namespace StockMarketSimulator {
+
+class Market;
+class Player;
+class Company;
+
+struct StrategyAccountStats {
+    uint64_t decisions = 0;
+    uint64_t ordersSubmitted = 0;
+    uint64_t ordersFilled = 0;
+    uint64_t ordersRejected = 0;
+};
+
+// An account as it stood at the end of a day, kept by checkpoints. The
+// strategy is null when it does not support clone().
+struct StrategyAccountSnapshot {
+    std::shared_ptr<const Player> player;
+    std::shared_ptr<const Strategy> strategy;
+    StrategyAccountStats stats;
+};
+
+// Runs one strategy per simulated account. Accounts only touch their own
+// Player, so a day's accounts are processed in parallel on the worker pool.
+class StrategyEngine {
+private:
+    struct Account {
+        std::shared_ptr<Player> player;
+        std::unique_ptr<Strategy> strategy;
+        std::vector<OrderRequest> orders;
+        std::vector<OrderReport> reports;
+        StrategyAccountStats stats;
+    };
+
+    std::vector<Account> accounts;
+    std::shared_ptr<WorkStealingPool> pool;
+    std::unordered_map<std::string, std::shared_ptr<Company>> companyIndex;
+
+    void runAccount(Account& account, const Market& market, int day);
+
+public:
+    size_t addAccount(std::shared_ptr<Player> player, std::unique_ptr<Strategy> strategy);
+    void clear();
+
+    size_t getAccountCount() const;
+    std::shared_ptr<Player> getPlayer(size_t index) const;
+    const Strategy& getStrategy(size_t index) const;
+    const StrategyAccountStats& getStats(size_t index) const;
+    const std::vector<OrderReport>& getLastReports(size_t index) const;
+
+    void setParallelMode(std::shared_ptr<WorkStealingPool> pool);
+
+    std::vector<StrategyAccountSnapshot> snapshot() const;
+
+    // Puts every account back to its snapshot and points all accounts at the
+    // market's companies. Accounts added after the snapshot are only rebound.
+    void restore(const std::vector<StrategyAccountSnapshot>& snapshots, const std::shared_ptr<Market>& market);
+
+    // Settles the day for every account (valuations, dividends, loans),
+    // asks each strategy for orders and executes them, then closes the day.
+    void runDay(const Market& market);
+};
+
+}
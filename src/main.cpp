@@ -1,11 +1,18 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <memory>
 #include <string>
 #include <vector>
 #include "core/Game.hpp"
+#include "core/ParameterSweep.hpp"
 #include "services/SaveService.hpp"
 #include "ui/screens/MainScreen.hpp"
 #include "utils/Console.hpp"
+#include "utils/Profiler.hpp"
 
 using namespace StockMarketSimulator;
 
@@ -117,6 +124,18 @@ std::string getSaveFilename() {
     return "";
 }
 
+void dumpProfile() {
+#ifdef SMP_PROFILING
+    Profiler::writeJson(FileIO::combineFilePath(FileIO::getDataDirectory(), "profile.json"));
+    std::cerr << Profiler::report();
+#endif
+#ifdef SMP_ALLOCATION_TRACKING
+    FileIO::writeJsonFile(FileIO::combineFilePath(FileIO::getDataDirectory(), "allocations.json"),
+                          AllocationTracker::toJson());
+    std::cerr << AllocationTracker::report();
+#endif
+}
+
 std::pair<std::string, double> getPlayerInfo() {
     Console::clear();
 
@@ -152,16 +171,185 @@ std::pair<std::string, double> getPlayerInfo() {
     return {playerName, initialBalance};
 }
 
+std::vector<std::string> splitList(const std::string& value, char separator) {
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, separator)) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// Headless back-test: runs the comma-separated strategies in SMP_BACKTEST
+// side by side, each on its own account, and prints a summary.
+int runBacktest(const std::string& strategyList) {
+    if (const char* plugins = std::getenv("SMP_STRATEGY_PLUGINS")) {
+        for (const auto& path : splitList(plugins, ':')) {
+            std::string error;
+            if (!StrategyRegistry::loadPlugin(path, error)) {
+                std::cerr << error << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    const char* daysValue = std::getenv("SMP_BACKTEST_DAYS");
+    const char* threadsValue = std::getenv("SMP_BACKTEST_THREADS");
+    int days = daysValue ? std::atoi(daysValue) : 250;
+    int threads = threadsValue ? std::atoi(threadsValue) : 0;
+    const double initialBalance = 100000.0;
+
+    // Headless runs leave the interactive log and saves untouched, and keep
+    // autosave I/O out of the timed loop.
+    FileIO::setLogFile("");
+
+    Game game;
+    game.initialize("Benchmark", initialBalance);
+    game.getSaveService()->setAutosave(false);
+    if (threads > 0) {
+        game.enableParallelMode(static_cast<size_t>(threads), 0);
+    }
+
+    for (const auto& name : splitList(strategyList, ',')) {
+        if (!game.addStrategyAccount(name, name, initialBalance)) {
+            std::cerr << game.getLastError() << std::endl;
+            return 1;
+        }
+    }
+
+    game.start();
+    auto start = std::chrono::steady_clock::now();
+    if (!game.simulateDays(days)) {
+        std::cerr << game.getLastError() << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const StrategyEngine& engine = game.getStrategyEngine();
+    uint64_t decisions = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < engine.getAccountCount(); ++i) {
+        const auto& stats = engine.getStats(i);
+        double netWorth = engine.getPlayer(i)->getNetWorth();
+        decisions += stats.decisions;
+
+        std::cout << std::left << std::setw(20) << engine.getStrategy(i).getName()
+                  << " net worth " << std::right << std::setw(14) << netWorth
+                  << "  return " << std::setw(8) << (netWorth / initialBalance - 1.0) * 100.0 << "%"
+                  << "  fills " << stats.ordersFilled
+                  << "  rejected " << stats.ordersRejected << std::endl;
+    }
+    std::cout << days << " days in " << seconds << "s, "
+              << (seconds > 0.0 ? decisions / seconds : 0.0) << " decisions/s" << std::endl;
+
+    dumpProfile();
+    return 0;
+}
+
+// Headless parameter sweep driven by the JSON spec named in SMP_SWEEP; see
+// SweepOptions::fromJson and SweepSpace::fromJson for the fields it accepts.
+int runSweep(const std::string& specPath) {
+    try {
+        nlohmann::json spec = FileIO::readJsonFile(specPath);
+        SweepOptions options = SweepOptions::fromJson(spec);
+        SweepSpace space = SweepSpace::fromJson(spec.at("parameters"));
+
+        std::vector<SweepConfiguration> configurations;
+        if (spec.value("search", std::string("grid")) == "random") {
+            configurations = space.sample(spec.value("samples", 20), spec.value("sample_seed", 1));
+        } else {
+            configurations = space.grid();
+        }
+
+        ParameterSweep sweep(options);
+        if (!sweep.warmStart()) {
+            std::cerr << sweep.getLastError() << std::endl;
+            return 1;
+        }
+
+        auto results = sweep.run(configurations);
+        std::string outputPath = FileIO::combineFilePath(FileIO::getDataDirectory(), "sweep_results.json");
+        if (spec.value("compress", false)) {
+            outputPath += ".lz";
+            FileIO::writeCompressedTextFile(outputPath, ParameterSweep::toJson(results).dump(4));
+        } else {
+            FileIO::writeJsonFile(outputPath, ParameterSweep::toJson(results));
+        }
+
+        std::cout << ParameterSweep::formatTable(ParameterSweep::summarize(results));
+        std::cout << results.size() << " runs written to " << outputPath << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Sweep failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
 int main() {
+    if (const char* strategies = std::getenv("SMP_BACKTEST")) {
+        return runBacktest(strategies);
+    }
+
+    if (const char* sweepSpec = std::getenv("SMP_SWEEP")) {
+        return runSweep(sweepSpec);
+    }
+
     try {
         Console::initialize();
 
         std::shared_ptr<Game> game = std::make_shared<Game>();
 
+        if (const char* socketPath = std::getenv("SMP_MARKET_DATA_SOCKET")) {
+            auto server = std::make_shared<MarketDataServer>(socketPath);
+            if (server->start()) {
+                game->setMarketDataServer(server);
+            } else {
+                FileIO::appendToLog("Market data server disabled: " + server->getLastError());
+            }
+        }
+
+        if (const char* feedName = std::getenv("SMP_SHARED_FEED")) {
+            auto feed = std::make_shared<SharedMarketFeed>(feedName);
+            if (feed->open()) {
+                game->setSharedFeed(feed);
+            } else {
+                FileIO::appendToLog("Shared market feed disabled: " + feed->getLastError());
+            }
+        }
+
+        if (const char* gatewayPath = std::getenv("SMP_ORDER_GATEWAY_SOCKET")) {
+            auto gateway = std::make_shared<OrderGateway>(gatewayPath);
+            if (gateway->start()) {
+                game->setOrderGateway(gateway);
+            } else {
+                FileIO::appendToLog("Order gateway disabled: " + gateway->getLastError());
+            }
+        }
+
+        if (const char* interval = std::getenv("SMP_CHECKPOINT_INTERVAL")) {
+            CheckpointOptions options;
+            options.interval = std::max(1, std::atoi(interval));
+            if (const char* budget = std::getenv("SMP_CHECKPOINT_BUDGET_MB")) {
+                options.memoryBudget = static_cast<size_t>(std::max(1, std::atoi(budget))) * 1024 * 1024;
+            }
+            game->setCheckpointStore(std::make_shared<CheckpointStore>(options));
+        }
+
         while (true) {
             displayWelcomeScreen();
 
-            int choice = Console::readChar() - '0';
+            char key = 0;
+            if (!Console::readKey(key)) {
+                // Input has ended, e.g. a dropped session; nothing can choose again.
+                Console::cleanup();
+                dumpProfile();
+                return 0;
+            }
+
+            int choice = key - '0';
 
             switch (choice) {
                 case 1: {
@@ -216,6 +404,7 @@ int main() {
                     Console::print("Goodbye!");
 
                     Console::cleanup();
+                    dumpProfile();
                     return 0;
 
                 default:
@@ -237,6 +426,7 @@ int main() {
         Console::println("Error: " + std::string(e.what()));
 
         Console::cleanup();
+        dumpProfile();
         return 1;
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Company.hpp"
+#include "../core/MarketIndex.hpp"
 #include "../utils/Random.hpp"
 #include "utils/FileIO.hpp"
 #include <stdexcept>
@@ -122,7 +123,9 @@ Company::Company()
       marketCap(0.0),
       peRatio(0.0),
       revenue(0.0),
-      profit(0.0)
+      profit(0.0),
+      marketIndex(nullptr),
+      indexSlot(0)
 {
     stock = std::make_unique<Stock>(weak_from_this(), 0.0);
 }
@@ -141,6 +144,8 @@ Company::Company(const std::string& name, const std::string& ticker,
       peRatio(0.0),
       revenue(0.0),
       profit(0.0),
+      marketIndex(nullptr),
+      indexSlot(0),
       lastDividendDate()
 {
     stock = std::make_unique<Stock>(weak_from_this(), initialPrice);
@@ -155,16 +160,21 @@ Company::Company(const Company& other)
       sector(other.sector),
       volatility(other.volatility),
       dividendPolicy(other.dividendPolicy),
+      lastDividendDate(other.lastDividendDate),
       marketCap(other.marketCap),
       peRatio(other.peRatio),
       revenue(other.revenue),
-      profit(other.profit)
+      profit(other.profit),
+      marketIndex(nullptr),
+      indexSlot(0)
 {
+    // No shared_ptr owns this copy yet, so the stock is left unbound rather
+    // than pointing at the original; owners rebind it, as cloneCompanies does.
     if (other.stock) {
         stock = std::make_unique<Stock>(*other.stock);
-        stock->getCompany() = weak_from_this();
+        stock->setCompany(std::weak_ptr<Company>());
     } else {
-        stock = std::make_unique<Stock>(weak_from_this(), 0.0);
+        stock = std::make_unique<Stock>(std::weak_ptr<Company>(), 0.0);
     }
 }
 
@@ -176,6 +186,7 @@ Company& Company::operator=(const Company& other) {
         sector = other.sector;
         volatility = other.volatility;
         dividendPolicy = other.dividendPolicy;
+        lastDividendDate = other.lastDividendDate;
         marketCap = other.marketCap;
         peRatio = other.peRatio;
         revenue = other.revenue;
@@ -183,10 +194,12 @@ Company& Company::operator=(const Company& other) {
 
         if (other.stock) {
             stock = std::make_unique<Stock>(*other.stock);
-            stock->getCompany() = weak_from_this();
+            stock->setCompany(weak_from_this());
         } else {
             stock = std::make_unique<Stock>(weak_from_this(), 0.0);
         }
+
+        notifyMarketIndex();
     }
     return *this;
 }
@@ -268,6 +281,43 @@ void Company::setFinancials(double marketCap, double peRatio, double revenue, do
     this->peRatio = peRatio;
     this->revenue = revenue;
     this->profit = profit;
+
+    notifyMarketIndex();
+}
+
+void Company::attachToIndex(MarketIndex* index, size_t slot) {
+    marketIndex = index;
+    indexSlot = slot;
+}
+
+void Company::detachFromIndex() {
+    marketIndex = nullptr;
+    indexSlot = 0;
+}
+
+bool Company::isAttachedTo(const MarketIndex* index) const {
+    return marketIndex != nullptr && marketIndex == index;
+}
+
+void Company::refreshMarketCap() {
+    marketCap = stock->getCurrentPrice() * 1000000;
+    notifyMarketIndex();
+}
+
+void Company::notifyMarketIndex() {
+    if (marketIndex && stock) {
+        marketIndex->onPriceChange(indexSlot, stock->getCurrentPrice(), marketCap);
+    }
+}
+
+void Company::updatePrice(double newPrice) {
+    if (!stock) {
+        return;
+    }
+
+    stock->updatePrice(newPrice);
+
+    refreshMarketCap();
 }
 
 void Company::updateStockPrice(double marketTrend, double sectorTrend) {
@@ -278,7 +328,23 @@ void Company::updateStockPrice(double marketTrend, double sectorTrend) {
     double newPrice = stock->generatePriceMovement(volatility, marketTrend, sectorTrend);
     stock->updatePrice(newPrice);
 
-    marketCap = stock->getCurrentPrice() * 1000000;
+    refreshMarketCap();
+}
+
+double Company::generateDailyMovement(double marketTrend, double sectorTrend) const {
+    if (!stock) {
+        return 0.0;
+    }
+
+    return stock->generateMovement(volatility, marketTrend, sectorTrend);
+}
+
+double Company::generateDailyMovement(double marketTrend, double sectorTrend, RandomStream& stream) const {
+    if (!stock) {
+        return 0.0;
+    }
+
+    return stock->generateMovement(volatility, marketTrend, sectorTrend, stream);
 }
 
 void Company::processNewsImpact(double newsImpact) {
@@ -288,7 +354,7 @@ void Company::processNewsImpact(double newsImpact) {
 
     stock->updatePriceWithNewsImpact(newsImpact);
 
-    marketCap = stock->getCurrentPrice() * 1000000;
+    refreshMarketCap();
 }
 
 void Company::closeTradingDay(const Date& currentDate) {
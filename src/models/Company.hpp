@@ -18,6 +18,12 @@ enum class Sector {
     Unknown
 };
 
+constexpr size_t SECTOR_COUNT = static_cast<size_t>(Sector::Unknown) + 1;
+
+constexpr size_t sectorIndex(Sector sector) {
+    return static_cast<size_t>(sector);
+}
+
 struct DividendPolicy {
     double annualDividendRate;
     int paymentFrequency;
@@ -39,6 +45,8 @@ struct DividendPolicy {
     static DividendPolicy fromJson(const nlohmann::json& json);
 };
 
+class MarketIndex;
+
 struct DividendPaymentInfo {
         bool paymentMade;
         Date paymentDate;
@@ -61,6 +69,12 @@ private:
     double revenue;
     double profit;
 
+    MarketIndex* marketIndex;
+    size_t indexSlot;
+
+    void refreshMarketCap();
+    void notifyMarketIndex();
+
     static Sector sectorFromString(const std::string& sectorStr);
     static std::string sectorToString(Sector sector);
 
@@ -95,7 +109,14 @@ public:
     void setDividendPolicy(const DividendPolicy& policy);
     void setFinancials(double marketCap, double peRatio, double revenue, double profit);
 
+    void attachToIndex(MarketIndex* index, size_t slot);
+    void detachFromIndex();
+    bool isAttachedTo(const MarketIndex* index) const;
+
+    void updatePrice(double newPrice);
     void updateStockPrice(double marketTrend, double sectorTrend);
+    double generateDailyMovement(double marketTrend, double sectorTrend) const;
+    double generateDailyMovement(double marketTrend, double sectorTrend, RandomStream& stream) const;
     void processNewsImpact(double newsImpact);
 
     void closeTradingDay();
@@ -8,6 +8,8 @@ News::News()
     : type(NewsType::Global),
       title(""),
       content(""),
+      templateId(-1),
+      variant(0),
       impact(0.0),
       publishDate(),
       targetSector(Sector::Unknown),
@@ -20,6 +22,8 @@ News::News(NewsType type, const std::string& title, const std::string& content,
     : type(type),
       title(title),
       content(content),
+      templateId(-1),
+      variant(0),
       impact(impact),
       publishDate(publishDate),
       targetSector(Sector::Unknown),
@@ -32,6 +36,8 @@ News::News(NewsType type, const std::string& title, const std::string& content,
     : type(type),
       title(title),
       content(content),
+      templateId(-1),
+      variant(0),
       impact(impact),
       publishDate(publishDate),
       targetSector(targetSector),
@@ -44,6 +50,8 @@ News::News(NewsType type, const std::string& title, const std::string& content,
     : type(type),
       title(title),
       content(content),
+      templateId(-1),
+      variant(0),
       impact(impact),
       publishDate(publishDate),
       targetSector(Sector::Unknown),
@@ -56,18 +64,57 @@ News::News(NewsType type, const std::string& title, const std::string& content,
     }
 }
 
+News::News(NewsType type, std::shared_ptr<const NewsTemplate> sourceTemplate, uint32_t variant,
+           double impact, const Date& publishDate)
+    : type(type),
+      sourceTemplate(sourceTemplate),
+      templateId(sourceTemplate ? sourceTemplate->id : -1),
+      variant(variant),
+      impact(impact),
+      publishDate(publishDate),
+      targetSector(Sector::Unknown),
+      processed(false)
+{
+}
+
 NewsType News::getType() const {
     return type;
 }
 
 std::string News::getTitle() const {
+    if (sourceTemplate) {
+        auto company = targetCompany.lock();
+        return sourceTemplate->renderTitle(company ? company->getName() : "", variant);
+    }
+
     return title;
 }
 
 std::string News::getContent() const {
+    if (sourceTemplate) {
+        auto company = targetCompany.lock();
+        return sourceTemplate->renderContent(company ? company->getName() : "", variant);
+    }
+
     return content;
 }
 
+std::shared_ptr<const NewsTemplate> News::getTemplate() const {
+    return sourceTemplate;
+}
+
+int News::getTemplateId() const {
+    return templateId;
+}
+
+uint32_t News::getVariant() const {
+    return variant;
+}
+
+bool News::isTemplated() const {
+    return sourceTemplate != nullptr;
+}
+
 double News::getImpact() const {
     return impact;
 }
@@ -93,13 +140,38 @@ void News::setType(NewsType type) {
 }
 
 void News::setTitle(const std::string& title) {
+    if (sourceTemplate) {
+        content = getContent();
+        sourceTemplate.reset();
+        templateId = -1;
+        variant = 0;
+    }
+
     this->title = title;
 }
 
 void News::setContent(const std::string& content) {
+    if (sourceTemplate) {
+        title = getTitle();
+        sourceTemplate.reset();
+        templateId = -1;
+        variant = 0;
+    }
+
     this->content = content;
 }
 
+void News::setTemplate(std::shared_ptr<const NewsTemplate> sourceTemplate, uint32_t variant) {
+    this->sourceTemplate = sourceTemplate;
+    this->templateId = sourceTemplate ? sourceTemplate->id : -1;
+    this->variant = variant;
+
+    if (sourceTemplate) {
+        title.clear();
+        content.clear();
+    }
+}
+
 void News::setImpact(double impact) {
     this->impact = impact;
 }
@@ -156,6 +228,32 @@ bool News::shouldAffectCompany(const std::shared_ptr<Company>& company) const {
     return false;
 }
 
+bool News::hasSameHeadline(const News& other) const {
+    if (templateId != other.templateId) {
+        return false;
+    }
+
+    if (!sourceTemplate && !other.sourceTemplate) {
+        return title == other.title;
+    }
+
+    return getTitle() == other.getTitle();
+}
+
+bool News::isSameEvent(const News& other) const {
+    if (type != other.type || publishDate != other.publishDate || templateId != other.templateId) {
+        return false;
+    }
+
+    if (sourceTemplate || other.sourceTemplate) {
+        return variant == other.variant &&
+               targetSector == other.targetSector &&
+               targetCompany.lock() == other.targetCompany.lock();
+    }
+
+    return title == other.title && content == other.content;
+}
+
 std::string News::newsTypeToString(NewsType type) {
     switch (type) {
         case NewsType::Global: return "Global";
@@ -177,8 +275,14 @@ nlohmann::json News::toJson() const {
     nlohmann::json j;
 
     j["type"] = newsTypeToString(type);
-    j["title"] = title;
-    j["content"] = content;
+    if (templateId >= 0) {
+        j["template_id"] = templateId;
+        j["variant"] = variant;
+    }
+    if (!sourceTemplate) {
+        j["title"] = title;
+        j["content"] = content;
+    }
     j["impact"] = impact;
     j["publish_date"] = publishDate.toJson();
     j["processed"] = processed;
@@ -195,12 +299,29 @@ nlohmann::json News::toJson() const {
     return j;
 }
 
-News News::fromJson(const nlohmann::json& json, const std::vector<std::shared_ptr<Company>>& companies) {
+News News::fromJson(const nlohmann::json& json, const std::vector<std::shared_ptr<Company>>& companies,
+                    const std::vector<std::shared_ptr<const NewsTemplate>>& templates) {
     News news;
 
     news.type = newsTypeFromString(json["type"]);
-    news.title = json["title"];
-    news.content = json["content"];
+
+    if (json.contains("template_id")) {
+        int id = json["template_id"];
+        uint32_t variant = json.value("variant", 0u);
+
+        if (id >= 0 && id < static_cast<int>(templates.size()) && templates[id]) {
+            news.setTemplate(templates[id], variant);
+        } else {
+            news.templateId = id;
+            news.variant = variant;
+            news.title = json.value("title", std::string());
+            news.content = json.value("content", std::string());
+        }
+    } else {
+        news.title = json["title"];
+        news.content = json["content"];
+    }
+
     news.impact = json["impact"];
 
     if (json.contains("publish_date")) {
@@ -230,7 +351,8 @@ News News::fromJson(const nlohmann::json& json, const std::vector<std::shared_pt
 }
 
 NewsTemplate::NewsTemplate()
-    : type(NewsType::Global),
+    : id(-1),
+      type(NewsType::Global),
       titleTemplate(""),
       contentTemplate(""),
       minImpact(0.0),
@@ -247,7 +369,8 @@ NewsTemplate::NewsTemplate(NewsType type, const std::string& titleTemplate,
                          bool requiresPositiveMarket,
                          bool requiresNegativeMarket,
                          Sector targetSector)
-    : type(type),
+    : id(-1),
+      type(type),
       titleTemplate(titleTemplate),
       contentTemplate(contentTemplate),
       minImpact(minImpact),
@@ -258,6 +381,64 @@ NewsTemplate::NewsTemplate(NewsType type, const std::string& titleTemplate,
 {
 }
 
+static uint32_t mixVariant(uint32_t variant, uint32_t salt) {
+    uint32_t h = variant ^ (salt * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+std::string NewsTemplate::renderTitle(const std::string& companyName, uint32_t variant) const {
+    return renderText(titleTemplate, companyName, variant);
+}
+
+std::string NewsTemplate::renderContent(const std::string& companyName, uint32_t variant) const {
+    return renderText(contentTemplate, companyName, variant);
+}
+
+std::string NewsTemplate::renderText(const std::string& text, const std::string& companyName, uint32_t variant) {
+    std::string result = text;
+    uint32_t salt = 0;
+
+    size_t pos = result.find("%s");
+    while (pos != std::string::npos) {
+        std::string replacement;
+
+        if (!companyName.empty()) {
+            replacement = companyName;
+        } else {
+            static const std::vector<std::string> rateWords = {"increased", "decreased", "saved", "changed"};
+            static const std::vector<std::string> economyWords = {"growth", "deceleration", "stabilization", "recovery"};
+            static const std::vector<std::string> genericWords = {"changes", "important news", "updated data"};
+
+            const std::vector<std::string>* words = &genericWords;
+            if (result.find("rate") != std::string::npos) {
+                words = &rateWords;
+            } else if (result.find("economic") != std::string::npos) {
+                words = &economyWords;
+            }
+
+            replacement = (*words)[mixVariant(variant, salt++) % words->size()];
+        }
+
+        result.replace(pos, 2, replacement);
+        pos = result.find("%s", pos + replacement.length());
+    }
+
+    pos = result.find("%d");
+    while (pos != std::string::npos) {
+        std::string replacement = std::to_string(5 + mixVariant(variant, salt++) % 46);
+        result.replace(pos, 2, replacement);
+
+        pos = result.find("%d", pos + replacement.length());
+    }
+
+    return result;
+}
+
 nlohmann::json NewsTemplate::toJson() const {
     nlohmann::json j;
 
@@ -3,6 +3,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include "Company.hpp"
 #include "../utils/Date.hpp"
@@ -15,11 +16,16 @@ enum class NewsType {
     Corporate
 };
 
+struct NewsTemplate;
+
 class News {
 private:
     NewsType type;
     std::string title;
     std::string content;
+    std::shared_ptr<const NewsTemplate> sourceTemplate;
+    int templateId;
+    uint32_t variant;
     double impact;
     Date publishDate;
     Sector targetSector;
@@ -34,10 +40,16 @@ public:
          double impact, const Date& publishDate, Sector targetSector);
     News(NewsType type, const std::string& title, const std::string& content,
          double impact, const Date& publishDate, std::weak_ptr<Company> targetCompany);
+    News(NewsType type, std::shared_ptr<const NewsTemplate> sourceTemplate, uint32_t variant,
+         double impact, const Date& publishDate);
 
     NewsType getType() const;
     std::string getTitle() const;
     std::string getContent() const;
+    std::shared_ptr<const NewsTemplate> getTemplate() const;
+    int getTemplateId() const;
+    uint32_t getVariant() const;
+    bool isTemplated() const;
     double getImpact() const;
     Date getPublishDate() const;
     Sector getTargetSector() const;
@@ -47,6 +59,7 @@ public:
     void setType(NewsType type);
     void setTitle(const std::string& title);
     void setContent(const std::string& content);
+    void setTemplate(std::shared_ptr<const NewsTemplate> sourceTemplate, uint32_t variant);
     void setImpact(double impact);
     void setPublishDate(const Date& date);
     void setTargetSector(Sector sector);
@@ -56,15 +69,20 @@ public:
     bool shouldAffectMarket() const;
     bool shouldAffectSector(Sector sector) const;
     bool shouldAffectCompany(const std::shared_ptr<Company>& company) const;
+    bool hasSameHeadline(const News& other) const;
+    bool isSameEvent(const News& other) const;
+
     static std::string newsTypeToString(NewsType type);
     static NewsType newsTypeFromString(const std::string& typeStr);
 
     nlohmann::json toJson() const;
-    static News fromJson(const nlohmann::json& json, 
-                         const std::vector<std::shared_ptr<Company>>& companies = {});
+    static News fromJson(const nlohmann::json& json,
+                         const std::vector<std::shared_ptr<Company>>& companies = {},
+                         const std::vector<std::shared_ptr<const NewsTemplate>>& templates = {});
 };
 
 struct NewsTemplate {
+    int id;
     NewsType type;
     std::string titleTemplate;
     std::string contentTemplate;
@@ -81,7 +99,11 @@ struct NewsTemplate {
                  bool requiresPositiveMarket = false,
                  bool requiresNegativeMarket = false,
                  Sector targetSector = Sector::Unknown);
-                 
+
+    std::string renderTitle(const std::string& companyName, uint32_t variant) const;
+    std::string renderContent(const std::string& companyName, uint32_t variant) const;
+    static std::string renderText(const std::string& text, const std::string& companyName, uint32_t variant);
+
     nlohmann::json toJson() const;
     static NewsTemplate fromJson(const nlohmann::json& json);
 };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace StockMarketSimulator {
+
+enum class OrderSide : uint8_t {
+    Buy = 0,
+    Sell = 1
+};
+
+enum class OrderStatus : uint8_t {
+    Accepted = 0,
+    Rejected = 1,
+    Filled = 2
+};
+
+struct OrderRequest {
+    uint64_t clientOrderId;
+    OrderSide side;
+    std::string ticker;
+    int32_t quantity;
+    bool useMargin;
+};
+
+struct OrderReport {
+    uint64_t clientOrderId;
+    OrderStatus status;
+    std::string ticker;
+    int32_t quantity;
+    double price;
+    int32_t day;
+    std::string reason;
+};
+
+}
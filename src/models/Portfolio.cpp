@@ -1,6 +1,7 @@
 #include "Portfolio.hpp"
 #include <algorithm>
 #include "utils/FileIO.hpp"
+#include "utils/Profiler.hpp"
 #include <cmath>
 #include <stdexcept>
 
@@ -228,15 +229,19 @@ double Portfolio::getDayChangePercent() const {
     return 0.0;
 }
 
+uint64_t Portfolio::getVersion() const {
+    return version.get();
+}
+
 const std::unordered_map<std::string, PortfolioPosition>& Portfolio::getPositions() const {
     return positions;
 }
 
-const std::vector<PortfolioHistory>& Portfolio::getHistory() const {
+const PersistentVector<PortfolioHistory>& Portfolio::getHistory() const {
     return history;
 }
 
-const std::vector<Transaction>& Portfolio::getTransactions() const {
+const PersistentVector<Transaction>& Portfolio::getTransactions() const {
     return transactions;
 }
 
@@ -344,6 +349,8 @@ bool Portfolio::sellStock(std::shared_ptr<Company> company, int quantity, double
 }
 
 void Portfolio::updatePositionValues() {
+    SMP_PROFILE_SCOPE("portfolio.valuation");
+
     for (auto& [ticker, position] : positions) {
         position.updateCurrentValue();
     }
@@ -358,6 +365,7 @@ void Portfolio::updatePortfolioValue() {
         stocksValue += position.currentValue;
     }
     totalValue = cashBalance + stocksValue;
+    version.bump();
 }
 
 void Portfolio::closeDay(const Date& date) {
@@ -367,6 +375,7 @@ void Portfolio::closeDay(const Date& date) {
 
 void Portfolio::openDay() {
     previousDayValue = totalValue;
+    version.bump();
 }
 
 void Portfolio::recordHistoryEntry(const Date& date) {
@@ -378,7 +387,7 @@ void Portfolio::recordHistoryEntry(const Date& date) {
 
     const size_t MAX_HISTORY_SIZE = 365 * 5;
     if (history.size() > MAX_HISTORY_SIZE) {
-        history.erase(history.begin());
+        history.dropFront(1);
     }
 }
 
@@ -428,6 +437,32 @@ void Portfolio::receiveDividends(std::shared_ptr<Company> company, double amount
     totalDividendsReceived += dividendAmount;
     updatePortfolioValue();
 }
+// Points open positions at another market's companies with the same tickers,
+// as needed when a portfolio is copied into a branched game.
+void Portfolio::rebindCompanies(const std::vector<std::shared_ptr<Company>>& companies) {
+    std::unordered_map<std::string, std::shared_ptr<Company>> companyMap;
+    for (const auto& company : companies) {
+        companyMap[company->getTicker()] = company;
+    }
+
+    for (auto& entry : positions) {
+        auto it = companyMap.find(entry.first);
+        if (it != companyMap.end()) {
+            entry.second.company = it->second;
+        }
+    }
+    version.bump();
+}
+
+// Replaces the history and transaction ledgers with ones a streaming loader
+// converted separately from the rest of the portfolio.
+void Portfolio::restoreLedgers(PersistentVector<PortfolioHistory> history,
+                               PersistentVector<Transaction> transactions) {
+    this->history = std::move(history);
+    this->transactions = std::move(transactions);
+    version.bump();
+}
+
 void Portfolio::depositCash(double amount) {
     if (amount <= 0) {
         return;
@@ -450,30 +485,35 @@ bool Portfolio::withdrawCash(double amount) {
 
 std::map<Sector, double> Portfolio::getSectorAllocation() const {
     std::map<Sector, double> allocation;
+    std::array<double, SECTOR_COUNT> values = getSectorValues();
 
-    for (const auto& [ticker, position] : positions) {
-        Sector sector = position.company->getSector();
-        allocation[sector] += position.currentValue;
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        if (values[i] != 0.0) {
+            allocation[static_cast<Sector>(i)] = values[i];
+        }
     }
 
     return allocation;
 }
 
+std::array<double, SECTOR_COUNT> Portfolio::getSectorValues() const {
+    std::array<double, SECTOR_COUNT> values{};
+
+    for (const auto& [ticker, position] : positions) {
+        values[sectorIndex(position.company->getSector())] += position.currentValue;
+    }
+
+    return values;
+}
+
 double Portfolio::getSectorAllocationPercent(Sector sector) const {
-    double sectorValue = 0.0;
     double stocksValue = getTotalStocksValue();
 
     if (stocksValue <= 0) {
         return 0.0;
     }
 
-    for (const auto& [ticker, position] : positions) {
-        if (position.company->getSector() == sector) {
-            sectorValue += position.currentValue;
-        }
-    }
-
-    return (sectorValue / stocksValue) * 100.0;
+    return (getSectorValues()[sectorIndex(sector)] / stocksValue) * 100.0;
 }
 
 std::vector<double> Portfolio::getValueHistory() const {
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <array>
 #include <memory>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
@@ -10,6 +11,8 @@
 #include "Stock.hpp"
 #include "Transaction.hpp"
 #include "../utils/Date.hpp"
+#include "../utils/ChangeVersion.hpp"
+#include "../utils/PersistentVector.hpp"
 
 namespace StockMarketSimulator {
 
@@ -54,14 +57,15 @@ struct PortfolioHistory {
 class Portfolio {
 private:
     std::unordered_map<std::string, PortfolioPosition> positions;
-    std::vector<PortfolioHistory> history;
-    std::vector<Transaction> transactions;
+    PersistentVector<PortfolioHistory> history;
+    PersistentVector<Transaction> transactions;
 
     double initialInvestment;
     double cashBalance;
     double totalValue;
     double previousDayValue;
     double totalDividendsReceived;
+    ChangeVersion version;
 
     void updatePortfolioValue();
     void recordHistoryEntry(const Date& date);
@@ -80,10 +84,11 @@ public:
     double getTotalReturnPercent() const;
     double getDayChangeAmount() const;
     double getDayChangePercent() const;
+    uint64_t getVersion() const;
 
     const std::unordered_map<std::string, PortfolioPosition>& getPositions() const;
-    const std::vector<PortfolioHistory>& getHistory() const;
-    const std::vector<Transaction>& getTransactions() const;
+    const PersistentVector<PortfolioHistory>& getHistory() const;
+    const PersistentVector<Transaction>& getTransactions() const;
 
     bool hasPosition(const std::string& ticker) const;
     int getPositionQuantity(const std::string& ticker) const;
@@ -99,9 +104,12 @@ public:
     void receiveDividends(std::shared_ptr<Company> company, double amount);
 
     void depositCash(double amount);
+    void rebindCompanies(const std::vector<std::shared_ptr<Company>>& companies);
+    void restoreLedgers(PersistentVector<PortfolioHistory> history, PersistentVector<Transaction> transactions);
     bool withdrawCash(double amount);
 
     std::map<Sector, double> getSectorAllocation() const;
+    std::array<double, SECTOR_COUNT> getSectorValues() const;
     double getSectorAllocationPercent(Sector sector) const;
     std::vector<double> getValueHistory() const;
     double getPeriodReturn(int days) const;
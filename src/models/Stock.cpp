@@ -2,6 +2,7 @@
 #include "Company.hpp"
 #include "../utils/Random.hpp"
 #include <algorithm>
+#include <utility>
 #include <cmath>
 
 namespace StockMarketSimulator {
@@ -17,7 +18,8 @@ Stock::Stock()
       marketInfluence(0.5),
       sectorInfluence(0.3),
       dayChangeAmount(0.0),
-      dayChangePercent(0.0)
+      dayChangePercent(0.0),
+      historyLoaded(true)
 {
 }
 
@@ -33,7 +35,8 @@ Stock::Stock(std::weak_ptr<Company> company, double initialPrice)
       marketInfluence(0.5),
       sectorInfluence(0.3),
       dayChangeAmount(0.0),
-      dayChangePercent(0.0)
+      dayChangePercent(0.0),
+      historyLoaded(true)
 {
     priceHistory.push_back(initialPrice);
 }
@@ -41,7 +44,6 @@ Stock::Stock(std::weak_ptr<Company> company, double initialPrice)
 Stock::Stock(const Stock& other)
     : company(other.company),
       currentPrice(other.currentPrice),
-      priceHistory(other.priceHistory),
       lastUpdateTime(other.lastUpdateTime),
       lastUpdateDate(other.lastUpdateDate),
       highestPrice(other.highestPrice),
@@ -51,15 +53,23 @@ Stock::Stock(const Stock& other)
       marketInfluence(other.marketInfluence),
       sectorInfluence(other.sectorInfluence),
       dayChangeAmount(other.dayChangeAmount),
-      dayChangePercent(other.dayChangePercent)
+      dayChangePercent(other.dayChangePercent),
+      historyLoaded(true)
 {
+    std::lock_guard<std::mutex> lock(other.historyMutex);
+    priceHistory = other.priceHistory;
+    pendingHistory = other.pendingHistory;
+    historyLoaded = other.historyLoaded.load();
 }
 
 Stock& Stock::operator=(const Stock& other) {
     if (this != &other) {
+        std::scoped_lock lock(historyMutex, other.historyMutex);
         company = other.company;
         currentPrice = other.currentPrice;
         priceHistory = other.priceHistory;
+        pendingHistory = other.pendingHistory;
+        historyLoaded = other.historyLoaded.load();
         lastUpdateTime = other.lastUpdateTime;
         lastUpdateDate = other.lastUpdateDate;
         highestPrice = other.highestPrice;
@@ -103,10 +113,12 @@ double Stock::getLowestPrice() const {
 }
 
 std::vector<double> Stock::getPriceHistory() const {
-    return priceHistory;
+    pageInHistory();
+    return priceHistory.toVector();
 }
 
 size_t Stock::getPriceHistoryLength() const {
+    pageInHistory();
     return priceHistory.size();
 }
 
@@ -114,10 +126,46 @@ std::weak_ptr<Company> Stock::getCompany() const {
     return company;
 }
 
+void Stock::setCompany(std::weak_ptr<Company> company) {
+    this->company = std::move(company);
+}
+
 Date Stock::getLastUpdateDate() const {
     return lastUpdateDate;
 }
 
+void Stock::setLazyPriceHistory(HistoryLoader loader) {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    pendingHistory = std::move(loader);
+    historyLoaded = !pendingHistory;
+}
+
+bool Stock::isPriceHistoryLoaded() const {
+    return historyLoaded;
+}
+
+// Readers on several threads may be the first to touch the history; the
+// first one loads it while the others wait on the mutex. A loader that throws
+// stays pending, so the error reaches this caller and a later access retries.
+void Stock::pageInHistory() const {
+    if (historyLoaded.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(historyMutex);
+    if (!pendingHistory) {
+        return;
+    }
+
+    std::vector<double> history = pendingHistory();
+    pendingHistory = nullptr;
+
+    if (!history.empty()) {
+        priceHistory = history;
+    }
+    historyLoaded.store(true, std::memory_order_release);
+}
+
 void Stock::updatePrice(double newPrice) {
     if (newPrice <= 0.0) {
         newPrice = 0.01;
@@ -132,10 +180,11 @@ void Stock::updatePrice(double newPrice) {
         lowestPrice = newPrice;
     }
 
+    pageInHistory();
     priceHistory.push_back(newPrice);
 
     if (priceHistory.size() > 1000) {
-        priceHistory.erase(priceHistory.begin());
+        priceHistory.dropFront(1);
     }
 
     lastUpdateTime = std::time(nullptr);
@@ -204,15 +253,25 @@ void Stock::setSectorInfluence(double influence) {
     sectorInfluence = std::max(0.0, std::min(1.0, influence));
 }
 
-double Stock::generatePriceMovement(double volatility, double marketTrend, double sectorTrend) {
-    double randomComponent = Random::getNormal(0.0, volatility * 0.01);
+double Stock::generateMovement(double volatility, double marketTrend, double sectorTrend) const {
+    return combineMovement(Random::getNormal(0.0, volatility * 0.01), marketTrend, sectorTrend);
+}
 
+double Stock::generateMovement(double volatility, double marketTrend, double sectorTrend, RandomStream& stream) const {
+    return combineMovement(stream.getNormal(0.0, volatility * 0.01), marketTrend, sectorTrend);
+}
+
+double Stock::combineMovement(double randomComponent, double marketTrend, double sectorTrend) const {
     double marketComponent = marketTrend * marketInfluence;
     double sectorComponent = sectorTrend * sectorInfluence;
 
     double individualComponent = randomComponent * (1.0 - marketInfluence - sectorInfluence);
 
-    double totalMovement = marketComponent + sectorComponent + individualComponent;
+    return marketComponent + sectorComponent + individualComponent;
+}
+
+double Stock::generatePriceMovement(double volatility, double marketTrend, double sectorTrend) {
+    double totalMovement = generateMovement(volatility, marketTrend, sectorTrend);
 
     double newPrice = currentPrice * (1.0 + totalMovement);
 
@@ -228,7 +287,7 @@ nlohmann::json Stock::toJson() const {
     j["lowest_price"] = lowestPrice;
     j["market_influence"] = marketInfluence;
     j["sector_influence"] = sectorInfluence;
-    j["price_history"] = priceHistory;
+    j["price_history"] = getPriceHistory();
     j["last_update_date"] = lastUpdateDate.toJson();
 
     return j;
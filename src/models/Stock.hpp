@@ -1,21 +1,30 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <functional>
 #include <nlohmann/json.hpp>
 #include <ctime>
 #include "../utils/Date.hpp"
+#include "../utils/RandomStream.hpp"
+#include "../utils/PersistentVector.hpp"
 
 namespace StockMarketSimulator {
 
 class Company;
 
 class Stock {
+public:
+    using HistoryLoader = std::function<std::vector<double>()>;
+
 private:
     std::weak_ptr<Company> company;
     double currentPrice;
-    std::vector<double> priceHistory;
+    mutable PersistentVector<double> priceHistory;
+    mutable HistoryLoader pendingHistory;
     std::time_t lastUpdateTime;
     Date lastUpdateDate;
 
@@ -31,6 +40,13 @@ private:
     double dayChangeAmount;
     double dayChangePercent;
 
+    mutable std::mutex historyMutex;
+    mutable std::atomic<bool> historyLoaded;
+
+    double combineMovement(double randomComponent, double marketTrend, double sectorTrend) const;
+
+    void pageInHistory() const;
+
 public:
     Stock();
     Stock(std::weak_ptr<Company> company, double initialPrice);
@@ -48,8 +64,14 @@ public:
     std::vector<double> getPriceHistory() const;
     size_t getPriceHistoryLength() const;
     std::weak_ptr<Company> getCompany() const;
+    void setCompany(std::weak_ptr<Company> company);
     Date getLastUpdateDate() const;
 
+    // Defers the price history to the loader until it is first needed. An
+    // empty result keeps the single-price history the stock already has.
+    void setLazyPriceHistory(HistoryLoader loader);
+    bool isPriceHistoryLoaded() const;
+
     void updatePrice(double newPrice);
     void calculateDailyChange();
 
@@ -67,6 +89,8 @@ public:
     void setMarketInfluence(double influence);
     void setSectorInfluence(double influence);
 
+    double generateMovement(double volatility, double marketTrend, double sectorTrend) const;
+    double generateMovement(double volatility, double marketTrend, double sectorTrend, RandomStream& stream) const;
     double generatePriceMovement(double volatility, double marketTrend, double sectorTrend);
 
     nlohmann::json toJson() const;
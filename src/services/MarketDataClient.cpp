@@ -0,0 +1,106 @@
+#include "MarketDataClient.hpp"
+#include "../utils/UnixSocket.hpp"
+#include <cerrno>
+#include <chrono>
+#include <poll.h>
+
+namespace StockMarketSimulator {
+
+MarketDataClient::MarketDataClient()
+    : fd(-1)
+{
+}
+
+MarketDataClient::~MarketDataClient() {
+    disconnect();
+}
+
+bool MarketDataClient::connect(const std::string& socketPath) {
+    disconnect();
+    fd = UnixSocket::connect(socketPath, lastError);
+    return fd >= 0;
+}
+
+void MarketDataClient::disconnect() {
+    UnixSocket::close(fd);
+    fd = -1;
+    inbound.clear();
+}
+
+bool MarketDataClient::isConnected() const {
+    return fd >= 0;
+}
+
+bool MarketDataClient::sendAll(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t bytes = UnixSocket::send(fd, data.data() + sent, data.size() - sent);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            lastError = "Failed to send to market data server";
+            return false;
+        }
+        sent += static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+bool MarketDataClient::subscribe(const std::vector<std::string>& tickers) {
+    std::string frame;
+    MarketDataProtocol::appendSubscription(frame, MarketDataMessageType::Subscribe, tickers);
+    return isConnected() && sendAll(frame);
+}
+
+bool MarketDataClient::unsubscribe(const std::vector<std::string>& tickers) {
+    std::string frame;
+    MarketDataProtocol::appendSubscription(frame, MarketDataMessageType::Unsubscribe, tickers);
+    return isConnected() && sendAll(frame);
+}
+
+bool MarketDataClient::receive(MarketDataMessage& message, int timeoutMilliseconds) {
+    using Clock = std::chrono::steady_clock;
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+
+    while (isConnected()) {
+        if (MarketDataProtocol::extractMessage(inbound, message)) {
+            return true;
+        }
+
+        int timeout = -1;
+        if (timeoutMilliseconds >= 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            if (remaining.count() <= 0) {
+                return false;
+            }
+            timeout = static_cast<int>(remaining.count());
+        }
+
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            return false;
+        }
+
+        char buffer[8192];
+        ssize_t bytes = UnixSocket::receive(fd, buffer, sizeof(buffer));
+        if (bytes <= 0) {
+            lastError = "Market data server closed the connection";
+            disconnect();
+            return false;
+        }
+        inbound.append(buffer, static_cast<size_t>(bytes));
+    }
+
+    return false;
+}
+
+std::string MarketDataClient::getLastError() const {
+    return lastError;
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "MarketDataProtocol.hpp"
+
+namespace StockMarketSimulator {
+
+class MarketDataClient {
+private:
+    int fd;
+    std::string inbound;
+    std::string lastError;
+
+    bool sendAll(const std::string& data);
+
+public:
+    MarketDataClient();
+    ~MarketDataClient();
+
+    MarketDataClient(const MarketDataClient&) = delete;
+    MarketDataClient& operator=(const MarketDataClient&) = delete;
+
+    bool connect(const std::string& socketPath);
+    void disconnect();
+    bool isConnected() const;
+
+    bool subscribe(const std::vector<std::string>& tickers = {});
+    bool unsubscribe(const std::vector<std::string>& tickers = {});
+
+    // Waits up to timeoutMilliseconds for the next message; a negative
+    // timeout blocks until one arrives or the server disconnects.
+    bool receive(MarketDataMessage& message, int timeoutMilliseconds);
+
+    std::string getLastError() const;
+};
+
+}
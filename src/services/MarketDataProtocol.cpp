@@ -0,0 +1,162 @@
+#include "MarketDataProtocol.hpp"
+#include "NewsService.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+// Smallest encoded entries, used to bound reservations by the frame length.
+constexpr size_t MIN_QUOTE_SIZE = 1 + 3 * 8;
+constexpr size_t MIN_NEWS_SIZE = 1 + 8 + 1 + 2;
+
+uint8_t typeByte(MarketDataMessageType type) {
+    return static_cast<uint8_t>(type);
+}
+
+}
+
+MarketSnapshot MarketSnapshot::capture(const Market& market, const NewsService* newsService,
+                                       const std::vector<News>& dailyNews) {
+    MarketSnapshot snapshot;
+    snapshot.day = market.getCurrentDay();
+    snapshot.state = market.getState();
+
+    const auto& companies = market.getCompanies();
+    snapshot.quotes.reserve(companies.size());
+    for (const auto& company : companies) {
+        const Stock* stock = company->getStock();
+        if (!stock) {
+            continue;
+        }
+
+        snapshot.quotes.push_back({company->getTicker(), stock->getCurrentPrice(),
+                                   stock->getOpenPrice(), stock->getDayChangePercent()});
+    }
+
+    snapshot.news.reserve(dailyNews.size());
+    for (const auto& news : dailyNews) {
+        auto company = news.getTargetCompany().lock();
+        snapshot.news.push_back({news.getType(), news.getImpact(),
+                                 company ? company->getTicker() : std::string(),
+                                 newsService ? newsService->getNewsTitle(news) : news.getTitle()});
+    }
+
+    return snapshot;
+}
+
+void MarketDataProtocol::appendMarketState(std::string& out, int32_t day, const MarketState& state) {
+    FrameWriter writer(out, typeByte(MarketDataMessageType::MarketState));
+    writer.putInt32(day);
+    writer.putDouble(state.indexValue);
+    writer.putDouble(state.dailyChange);
+    writer.putDouble(state.dailyChangePercent);
+    writer.putUnsigned(static_cast<uint8_t>(state.currentTrend), 1);
+    writer.putInt32(state.trendDuration);
+    writer.putDouble(state.interestRate);
+    writer.putDouble(state.inflationRate);
+    writer.putDouble(state.unemploymentRate);
+}
+
+void MarketDataProtocol::appendQuotes(std::string& out, const std::vector<const QuoteUpdate*>& quotes) {
+    FrameWriter writer(out, typeByte(MarketDataMessageType::Quotes));
+    writer.putUnsigned(quotes.size(), 4);
+    for (const QuoteUpdate* quote : quotes) {
+        writer.putString(quote->ticker, 1);
+        writer.putDouble(quote->price);
+        writer.putDouble(quote->openPrice);
+        writer.putDouble(quote->changePercent);
+    }
+}
+
+void MarketDataProtocol::appendNews(std::string& out, const std::vector<NewsUpdate>& news) {
+    FrameWriter writer(out, typeByte(MarketDataMessageType::News));
+    writer.putUnsigned(news.size(), 4);
+    for (const auto& item : news) {
+        writer.putUnsigned(static_cast<uint8_t>(item.type), 1);
+        writer.putDouble(item.impact);
+        writer.putString(item.ticker, 1);
+        writer.putString(item.title, 2);
+    }
+}
+
+void MarketDataProtocol::appendSubscription(std::string& out, MarketDataMessageType type,
+                                            const std::vector<std::string>& tickers) {
+    FrameWriter writer(out, typeByte(type));
+    writer.putUnsigned(tickers.size(), 4);
+    for (const auto& ticker : tickers) {
+        writer.putString(ticker, 1);
+    }
+}
+
+bool MarketDataProtocol::extractMessage(std::string& buffer, MarketDataMessage& message) {
+    uint8_t type = 0;
+    uint32_t length = 0;
+    if (!FrameWriter::peek(buffer, MAX_PAYLOAD_SIZE, type, length)) {
+        return false;
+    }
+
+    message = MarketDataMessage();
+    message.type = static_cast<MarketDataMessageType>(type);
+    FrameReader reader(buffer, HEADER_SIZE, HEADER_SIZE + length);
+
+    switch (message.type) {
+        case MarketDataMessageType::Subscribe:
+        case MarketDataMessageType::Unsubscribe: {
+            size_t count = reader.getUnsigned(4);
+            for (size_t i = 0; i < count; ++i) {
+                message.tickers.push_back(reader.getString(1));
+            }
+            break;
+        }
+
+        case MarketDataMessageType::MarketState:
+            message.day = reader.getInt32();
+            message.state.indexValue = reader.getDouble();
+            message.state.dailyChange = reader.getDouble();
+            message.state.dailyChangePercent = reader.getDouble();
+            message.state.currentTrend = static_cast<MarketTrend>(reader.getUnsigned(1));
+            message.state.trendDuration = reader.getInt32();
+            message.state.interestRate = reader.getDouble();
+            message.state.inflationRate = reader.getDouble();
+            message.state.unemploymentRate = reader.getDouble();
+            break;
+
+        case MarketDataMessageType::Quotes: {
+            size_t count = reader.getUnsigned(4);
+            message.quotes.reserve(std::min<size_t>(count, length / MIN_QUOTE_SIZE));
+            for (size_t i = 0; i < count; ++i) {
+                QuoteUpdate quote;
+                quote.ticker = reader.getString(1);
+                quote.price = reader.getDouble();
+                quote.openPrice = reader.getDouble();
+                quote.changePercent = reader.getDouble();
+                message.quotes.push_back(std::move(quote));
+            }
+            break;
+        }
+
+        case MarketDataMessageType::News: {
+            size_t count = reader.getUnsigned(4);
+            message.news.reserve(std::min<size_t>(count, length / MIN_NEWS_SIZE));
+            for (size_t i = 0; i < count; ++i) {
+                NewsUpdate item;
+                item.type = static_cast<NewsType>(reader.getUnsigned(1));
+                item.impact = reader.getDouble();
+                item.ticker = reader.getString(1);
+                item.title = reader.getString(2);
+                message.news.push_back(std::move(item));
+            }
+            break;
+        }
+
+        default:
+            throw std::runtime_error("Unknown market data message type");
+    }
+
+    buffer.erase(0, HEADER_SIZE + length);
+    return true;
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../core/Market.hpp"
+#include "../models/News.hpp"
+#include "../utils/BinaryFrame.hpp"
+
+namespace StockMarketSimulator {
+
+class NewsService;
+
+enum class MarketDataMessageType : uint8_t {
+    Subscribe = 1,
+    Unsubscribe = 2,
+    MarketState = 16,
+    Quotes = 17,
+    News = 18
+};
+
+struct QuoteUpdate {
+    std::string ticker;
+    double price;
+    double openPrice;
+    double changePercent;
+};
+
+struct NewsUpdate {
+    NewsType type;
+    double impact;
+    std::string ticker;
+    std::string title;
+};
+
+struct MarketSnapshot {
+    int32_t day;
+    MarketState state;
+    std::vector<QuoteUpdate> quotes;
+    std::vector<NewsUpdate> news;
+
+    static MarketSnapshot capture(const Market& market, const NewsService* newsService,
+                                  const std::vector<News>& dailyNews);
+};
+
+struct MarketDataMessage {
+    MarketDataMessageType type;
+    int32_t day;
+    MarketState state;
+    std::vector<QuoteUpdate> quotes;
+    std::vector<NewsUpdate> news;
+    std::vector<std::string> tickers;
+};
+
+// Messages use the length-prefixed framing from BinaryFrame.hpp.
+class MarketDataProtocol {
+public:
+    static constexpr size_t HEADER_SIZE = FrameWriter::HEADER_SIZE;
+    static constexpr uint32_t MAX_PAYLOAD_SIZE = 16u * 1024u * 1024u;
+
+    static void appendMarketState(std::string& out, int32_t day, const MarketState& state);
+    static void appendQuotes(std::string& out, const std::vector<const QuoteUpdate*>& quotes);
+    static void appendNews(std::string& out, const std::vector<NewsUpdate>& news);
+    static void appendSubscription(std::string& out, MarketDataMessageType type,
+                                   const std::vector<std::string>& tickers);
+
+    // Removes one complete frame from the front of buffer and decodes it.
+    // Returns false when the buffer holds only a partial frame; throws
+    // std::runtime_error on malformed input.
+    static bool extractMessage(std::string& buffer, MarketDataMessage& message);
+};
+
+}
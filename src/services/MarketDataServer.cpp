@@ -0,0 +1,320 @@
+#include "MarketDataServer.hpp"
+#include "../utils/UnixSocket.hpp"
+#include "../utils/FileIO.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace StockMarketSimulator {
+
+MarketDataServer::MarketDataServer(const std::string& socketPath, size_t maxPendingBytes)
+    : socketPath(socketPath),
+      maxPendingBytes(maxPendingBytes),
+      listenFd(-1),
+      wakeFds{-1, -1},
+      running(false),
+      clientCount(0),
+      publishedSnapshots(0),
+      droppedSnapshots(0)
+{
+}
+
+MarketDataServer::~MarketDataServer() {
+    stop();
+}
+
+bool MarketDataServer::start() {
+    if (listenFd >= 0) {
+        return running;
+    }
+
+    listenFd = UnixSocket::listen(socketPath, lastError);
+    if (listenFd < 0) {
+        return false;
+    }
+
+    if (pipe(wakeFds) != 0) {
+        lastError = "Failed to create wake pipe";
+        UnixSocket::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    UnixSocket::setNonBlocking(wakeFds[0]);
+    UnixSocket::setNonBlocking(wakeFds[1]);
+
+    running = true;
+    ioThread = std::thread(&MarketDataServer::ioLoop, this);
+
+    FileIO::appendToLog("Market data server listening on " + socketPath);
+    return true;
+}
+
+void MarketDataServer::stop() {
+    if (listenFd < 0) {
+        return;
+    }
+
+    running = false;
+
+    char byte = 1;
+    ssize_t written = write(wakeFds[1], &byte, 1);
+    (void)written;
+
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+
+    for (auto& client : clients) {
+        UnixSocket::close(client.fd);
+    }
+    clients.clear();
+    clientCount = 0;
+
+    UnixSocket::close(listenFd);
+    UnixSocket::close(wakeFds[0]);
+    UnixSocket::close(wakeFds[1]);
+    listenFd = wakeFds[0] = wakeFds[1] = -1;
+    UnixSocket::unlink(socketPath);
+}
+
+bool MarketDataServer::isRunning() const {
+    return running;
+}
+
+void MarketDataServer::publish(MarketSnapshot snapshot) {
+    if (!running) {
+        return;
+    }
+
+    auto shared = std::make_shared<const MarketSnapshot>(std::move(snapshot));
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queuedSnapshots.size() >= MAX_QUEUED_SNAPSHOTS) {
+            queuedSnapshots.pop_front();
+            droppedSnapshots++;
+        }
+        queuedSnapshots.push_back(std::move(shared));
+    }
+    publishedSnapshots++;
+
+    char byte = 1;
+    ssize_t written = write(wakeFds[1], &byte, 1);
+    (void)written;
+}
+
+void MarketDataServer::drainWakePipe() {
+    char buffer[64];
+    while (read(wakeFds[0], buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+void MarketDataServer::ioLoop() {
+    std::vector<pollfd> fds;
+
+    while (running) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakeFds[0], POLLIN, 0});
+        for (const auto& client : clients) {
+            short events = POLLIN;
+            if (!client.outbound.empty()) {
+                events |= POLLOUT;
+            }
+            fds.push_back({client.fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            drainWakePipe();
+        }
+
+        std::vector<bool> closed(clients.size(), false);
+        for (size_t i = 0; i < clients.size(); ++i) {
+            short revents = fds[i + 2].revents;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                closed[i] = !readClient(clients[i]);
+            }
+            if (!closed[i] && (revents & POLLOUT)) {
+                closed[i] = !flushClient(clients[i]);
+            }
+        }
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (closed[i]) {
+                UnixSocket::close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            acceptClients();
+        }
+
+        std::deque<std::shared_ptr<const MarketSnapshot>> snapshots;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            snapshots.swap(queuedSnapshots);
+        }
+        for (const auto& snapshot : snapshots) {
+            deliver(*snapshot);
+        }
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (!clients[i].outbound.empty() && !flushClient(clients[i])) {
+                UnixSocket::close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+
+        clientCount = clients.size();
+    }
+}
+
+void MarketDataServer::acceptClients() {
+    while (true) {
+        int fd = UnixSocket::accept(listenFd);
+        if (fd < 0) {
+            break;
+        }
+        clients.push_back(Client{fd, false, {}, {}, {}});
+    }
+    clientCount = clients.size();
+}
+
+bool MarketDataServer::readClient(Client& client) {
+    char buffer[4096];
+    while (true) {
+        ssize_t bytes = UnixSocket::receive(client.fd, buffer, sizeof(buffer));
+        if (bytes > 0) {
+            client.inbound.append(buffer, static_cast<size_t>(bytes));
+            continue;
+        }
+        if (bytes == 0) {
+            return false;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    try {
+        MarketDataMessage message;
+        while (MarketDataProtocol::extractMessage(client.inbound, message)) {
+            if (message.type == MarketDataMessageType::Subscribe) {
+                if (message.tickers.empty()) {
+                    client.allTickers = true;
+                }
+                client.tickers.insert(message.tickers.begin(), message.tickers.end());
+            } else if (message.type == MarketDataMessageType::Unsubscribe) {
+                if (message.tickers.empty()) {
+                    client.allTickers = false;
+                    client.tickers.clear();
+                }
+                for (const auto& ticker : message.tickers) {
+                    client.tickers.erase(ticker);
+                }
+            }
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    return true;
+}
+
+bool MarketDataServer::flushClient(Client& client) {
+    size_t sent = 0;
+    while (sent < client.outbound.size()) {
+        ssize_t bytes = UnixSocket::send(client.fd, client.outbound.data() + sent, client.outbound.size() - sent);
+        if (bytes > 0) {
+            sent += static_cast<size_t>(bytes);
+            continue;
+        }
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+
+    client.outbound.erase(0, sent);
+    return true;
+}
+
+void MarketDataServer::deliver(const MarketSnapshot& snapshot) {
+    std::string common;
+    MarketDataProtocol::appendMarketState(common, snapshot.day, snapshot.state);
+    if (!snapshot.news.empty()) {
+        MarketDataProtocol::appendNews(common, snapshot.news);
+    }
+
+    std::vector<const QuoteUpdate*> allQuotes;
+    allQuotes.reserve(snapshot.quotes.size());
+    for (const auto& quote : snapshot.quotes) {
+        allQuotes.push_back(&quote);
+    }
+
+    std::string allQuotesFrame;
+    std::vector<const QuoteUpdate*> selected;
+
+    for (auto& client : clients) {
+        // Whole snapshots are skipped for consumers that fall behind so the
+        // stream they do receive stays consistent.
+        if (client.outbound.size() > maxPendingBytes) {
+            droppedSnapshots++;
+            continue;
+        }
+
+        client.outbound += common;
+
+        if (client.allTickers) {
+            if (allQuotesFrame.empty()) {
+                MarketDataProtocol::appendQuotes(allQuotesFrame, allQuotes);
+            }
+            client.outbound += allQuotesFrame;
+        } else if (!client.tickers.empty()) {
+            selected.clear();
+            for (const QuoteUpdate* quote : allQuotes) {
+                if (client.tickers.count(quote->ticker)) {
+                    selected.push_back(quote);
+                }
+            }
+            MarketDataProtocol::appendQuotes(client.outbound, selected);
+        }
+    }
+}
+
+const std::string& MarketDataServer::getSocketPath() const {
+    return socketPath;
+}
+
+std::string MarketDataServer::getLastError() const {
+    return lastError;
+}
+
+size_t MarketDataServer::getClientCount() const {
+    return clientCount;
+}
+
+uint64_t MarketDataServer::getPublishedSnapshots() const {
+    return publishedSnapshots;
+}
+
+uint64_t MarketDataServer::getDroppedSnapshots() const {
+    return droppedSnapshots;
+}
+
+}
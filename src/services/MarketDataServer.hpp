@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MarketDataProtocol.hpp"
+
+namespace StockMarketSimulator {
+
+class MarketDataServer {
+private:
+    struct Client {
+        int fd;
+        bool allTickers;
+        std::set<std::string> tickers;
+        std::string inbound;
+        std::string outbound;
+    };
+
+    std::string socketPath;
+    size_t maxPendingBytes;
+    int listenFd;
+    int wakeFds[2];
+    std::thread ioThread;
+    std::atomic<bool> running;
+    std::string lastError;
+
+    std::mutex queueMutex;
+    std::deque<std::shared_ptr<const MarketSnapshot>> queuedSnapshots;
+
+    std::vector<Client> clients;
+    std::atomic<size_t> clientCount;
+    std::atomic<uint64_t> publishedSnapshots;
+    std::atomic<uint64_t> droppedSnapshots;
+
+    void ioLoop();
+    void acceptClients();
+    bool readClient(Client& client);
+    bool flushClient(Client& client);
+    void deliver(const MarketSnapshot& snapshot);
+    void drainWakePipe();
+
+public:
+    static constexpr size_t DEFAULT_MAX_PENDING_BYTES = 1u << 20;
+    static constexpr size_t MAX_QUEUED_SNAPSHOTS = 64;
+
+    explicit MarketDataServer(const std::string& socketPath,
+                              size_t maxPendingBytes = DEFAULT_MAX_PENDING_BYTES);
+    ~MarketDataServer();
+
+    MarketDataServer(const MarketDataServer&) = delete;
+    MarketDataServer& operator=(const MarketDataServer&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    void publish(MarketSnapshot snapshot);
+
+    const std::string& getSocketPath() const;
+    std::string getLastError() const;
+    size_t getClientCount() const;
+    uint64_t getPublishedSnapshots() const;
+    uint64_t getDroppedSnapshots() const;
+};
+
+}
@@ -1,20 +1,59 @@
 #include "NewsService.hpp"
+#include "../utils/Profiler.hpp"
 #include <algorithm>
 #include <sstream>
+#include <limits>
 
 namespace StockMarketSimulator {
 
 NewsService::NewsService()
-    : currentDate(1, 3, 2023),
-      newsPerDay(2)
+    : renderedText(64),
+      currentDate(1, 3, 2023),
+      newsPerDay(2),
+      historyLoaded(true)
 {
 }
 
 NewsService::NewsService(std::weak_ptr<Market> market)
     : market(market),
+      renderedText(64),
       currentDate(1, 3, 2023),
-      newsPerDay(2)
+      newsPerDay(2),
+      historyLoaded(true)
+{
+}
+
+NewsService::NewsService(const NewsService& other)
+    : market(other.market),
+      newsTemplates(other.newsTemplates),
+      categoryTemplates(other.categoryTemplates),
+      renderedText(other.renderedText),
+      currentDate(other.currentDate),
+      newsPerDay(other.newsPerDay),
+      version(other.version),
+      historyLoaded(true)
 {
+    std::lock_guard<std::mutex> lock(other.historyMutex);
+    newsHistory = other.newsHistory;
+    pendingHistory = other.pendingHistory;
+    historyLoaded = other.historyLoaded.load();
+}
+
+NewsService& NewsService::operator=(const NewsService& other) {
+    if (this != &other) {
+        std::scoped_lock lock(historyMutex, other.historyMutex);
+        market = other.market;
+        newsHistory = other.newsHistory;
+        pendingHistory = other.pendingHistory;
+        historyLoaded = other.historyLoaded.load();
+        newsTemplates = other.newsTemplates;
+        categoryTemplates = other.categoryTemplates;
+        renderedText = other.renderedText;
+        currentDate = other.currentDate;
+        newsPerDay = other.newsPerDay;
+        version = other.version;
+    }
+    return *this;
 }
 
 void NewsService::initialize(const std::string& templatesPath) {
@@ -28,12 +67,10 @@ void NewsService::loadNewsTemplates(const std::string& filePath) {
 
             newsTemplates.clear();
             categoryTemplates.clear();
+            renderedText.clear();
 
             for (const auto& templateJson : json) {
-                NewsTemplate newsTemplate = NewsTemplate::fromJson(templateJson);
-                newsTemplates.push_back(newsTemplate);
-
-                categoryTemplates[newsTemplate.type].push_back(newsTemplate);
+                registerTemplate(NewsTemplate::fromJson(templateJson));
             }
         } else {
             createDefaultTemplates();
@@ -44,7 +81,11 @@ void NewsService::loadNewsTemplates(const std::string& filePath) {
 }
 
 void NewsService::createDefaultTemplates() {
-    newsTemplates.push_back(NewsTemplate(
+    newsTemplates.clear();
+    categoryTemplates.clear();
+    renderedText.clear();
+
+    registerTemplate(NewsTemplate(
         NewsType::Global,
         "Central bank %s interest rate",
         "The Central Bank has decided  %s base interest rate by  %d basis points.",
@@ -52,7 +93,7 @@ void NewsService::createDefaultTemplates() {
         false, false
     ));
 
-    newsTemplates.push_back(NewsTemplate(
+    registerTemplate(NewsTemplate(
         NewsType::Global,
         "The economy is showing signs %s",
         "According to the latest economic indicators, the economy is showing clear signs %s.",
@@ -60,7 +101,7 @@ void NewsService::createDefaultTemplates() {
         false, false
     ));
 
-    newsTemplates.push_back(NewsTemplate(
+    registerTemplate(NewsTemplate(
         NewsType::Sector,
         "New technologies in the sector",
         "New technologies have emerged in the sector that can significantly affect the market.",
@@ -69,7 +110,7 @@ void NewsService::createDefaultTemplates() {
         Sector::Technology
     ));
 
-    newsTemplates.push_back(NewsTemplate(
+    registerTemplate(NewsTemplate(
         NewsType::Sector,
         "Changes in energy prices",
         "Global energy prices show significant fluctuations.",
@@ -78,7 +119,7 @@ void NewsService::createDefaultTemplates() {
         Sector::Energy
     ));
 
-    newsTemplates.push_back(NewsTemplate(
+    registerTemplate(NewsTemplate(
         NewsType::Corporate,
         "%s announces a new product",
         "Company %s announced the release of a new product that promises to change the market.",
@@ -86,28 +127,41 @@ void NewsService::createDefaultTemplates() {
         false, false
     ));
 
-    newsTemplates.push_back(NewsTemplate(
+    registerTemplate(NewsTemplate(
         NewsType::Corporate,
         "%s publishes a financial report",
         "Company %s published the quarterly financial report. %s",
         -0.04, 0.04,
         false, false
     ));
+}
 
-    for (const auto& tmpl : newsTemplates) {
-        categoryTemplates[tmpl.type].push_back(tmpl);
-    }
+std::shared_ptr<const NewsTemplate> NewsService::registerTemplate(NewsTemplate newsTemplate) {
+    newsTemplate.id = static_cast<int>(newsTemplates.size());
+
+    auto shared = std::make_shared<const NewsTemplate>(std::move(newsTemplate));
+    newsTemplates.push_back(shared);
+    categoryTemplates[shared->type].push_back(shared);
+
+    return shared;
 }
 
 void NewsService::setMarket(std::weak_ptr<Market> market) {
     this->market = market;
+    renderedText.clear();
 }
 
-const std::vector<News>& NewsService::getNewsHistory() const {
+const PersistentVector<News>& NewsService::getNewsHistory() const {
+    pageInHistory();
     return newsHistory;
 }
 
+uint64_t NewsService::getVersion() const {
+    return version.get();
+}
+
 std::vector<News> NewsService::getNewsByDay(int day) const {
+    pageInHistory();
     std::vector<News> result;
 
     Date date = Date::fromDayNumber(day);
@@ -122,6 +176,7 @@ std::vector<News> NewsService::getNewsByDay(int day) const {
 }
 
 std::vector<News> NewsService::getLatestNews(int count) const {
+    pageInHistory();
     std::vector<News> result;
 
     int size = static_cast<int>(newsHistory.size());
@@ -134,7 +189,32 @@ std::vector<News> NewsService::getLatestNews(int count) const {
     return result;
 }
 
+std::string NewsService::getNewsTitle(const News& news) const {
+    return renderNewsText(news, false);
+}
+
+std::string NewsService::getNewsContent(const News& news) const {
+    return renderNewsText(news, true);
+}
+
+std::string NewsService::renderNewsText(const News& news, bool content) const {
+    if (!news.isTemplated()) {
+        return content ? news.getContent() : news.getTitle();
+    }
+
+    auto company = news.getTargetCompany().lock();
+    NewsTextKey key{news.getTemplateId(), news.getVariant(), company ? company->getTicker() : std::string(), content};
+
+    if (const std::string* cached = renderedText.find(key)) {
+        return *cached;
+    }
+
+    return renderedText.insert(key, content ? news.getContent() : news.getTitle());
+}
+
     std::vector<News> NewsService::generateDailyNews(int newsCount) {
+    SMP_PROFILE_SCOPE("news.generate");
+
     auto marketPtr = market.lock();
     if (!marketPtr) {
         return {};
@@ -182,6 +262,7 @@ std::vector<News> NewsService::getLatestNews(int count) const {
 
     // Explicitly set current date for all news
     currentDate = marketPtr->getCurrentDate();
+    pageInHistory();
     for (auto& news : generatedNews) {
         news.setPublishDate(currentDate);
         newsHistory.push_back(news);
@@ -189,8 +270,9 @@ std::vector<News> NewsService::getLatestNews(int count) const {
 
     const size_t MAX_HISTORY_SIZE = 1000;
     if (newsHistory.size() > MAX_HISTORY_SIZE) {
-        newsHistory.erase(newsHistory.begin(), newsHistory.begin() + (newsHistory.size() - MAX_HISTORY_SIZE));
+        newsHistory.dropFront(newsHistory.size() - MAX_HISTORY_SIZE);
     }
+    version.bump();
 
     return generatedNews;
 }
@@ -201,9 +283,9 @@ News NewsService::generateRandomNews(NewsType type) {
     }
 
     MarketTrend trend = marketPtr->getCurrentTrend();
-    NewsTemplate templ = selectNewsTemplate(type, trend);
+    auto templ = selectNewsTemplate(type, trend);
 
-    double impact = Random::getDouble(templ.minImpact, templ.maxImpact);
+    double impact = Random::getDouble(templ->minImpact, templ->maxImpact);
 
     if (trend == MarketTrend::Bullish && impact < 0) {
         impact *= 0.5;
@@ -224,19 +306,13 @@ News NewsService::generateRandomNews(NewsType type) {
         }
     }
 
-    std::string title = processTemplate(templ.titleTemplate, targetCompany);
-    std::string content = processTemplate(templ.contentTemplate, targetCompany);
+    uint32_t variant = static_cast<uint32_t>(Random::getInt(0, std::numeric_limits<int>::max()));
 
-    News news;
-    news.setType(type);
-    news.setTitle(title);
-    news.setContent(content);
-    news.setImpact(impact);
-    news.setPublishDate(currentDate);
+    News news(type, templ, variant, impact, currentDate);
 
     if (type == NewsType::Sector) {
-        if (templ.targetSector != Sector::Unknown && currentDate.getDay() % 2 != 0) {
-            news.setTargetSector(templ.targetSector);
+        if (templ->targetSector != Sector::Unknown && currentDate.getDay() % 2 != 0) {
+            news.setTargetSector(templ->targetSector);
         } else {
             int sectorIndex = (currentDate.getDay() + Random::getInt(0, 4)) % 5;
             Sector randomSector = static_cast<Sector>(sectorIndex);
@@ -249,93 +325,93 @@ News NewsService::generateRandomNews(NewsType type) {
     return news;
 }
 
-NewsTemplate NewsService::selectNewsTemplate(NewsType type, MarketTrend trend) {
-    auto& templates = categoryTemplates[type];
+std::shared_ptr<const NewsTemplate> NewsService::selectNewsTemplate(NewsType type, MarketTrend trend) {
+    const auto& templates = categoryTemplates[type];
 
     if (templates.empty()) {
         if (type == NewsType::Global) {
-            return NewsTemplate(type, "Global markets show changes",
-                               "Global markets are showing significant changes.",
-                               -0.02, 0.02);
+            return registerTemplate(NewsTemplate(type, "Global markets show changes",
+                                                 "Global markets are showing significant changes.",
+                                                 -0.02, 0.02));
         } else if (type == NewsType::Sector) {
-            return NewsTemplate(type, "Changes in the sector",
-                               "Important changes are being observed in the sector.",
-                               -0.01, 0.01, false, false, Sector::Technology);
+            return registerTemplate(NewsTemplate(type, "Changes in the sector",
+                                                 "Important changes are being observed in the sector.",
+                                                 -0.01, 0.01, false, false, Sector::Technology));
         } else {
-            return NewsTemplate(type, "News from the company",
-                               "The company has released an important statement.",
-                               -0.03, 0.03);
+            return registerTemplate(NewsTemplate(type, "News from the company",
+                                                 "The company has released an important statement.",
+                                                 -0.03, 0.03));
         }
     }
 
-    std::vector<NewsTemplate> filteredTemplates;
+    std::vector<const std::shared_ptr<const NewsTemplate>*> filteredTemplates;
+    filteredTemplates.reserve(templates.size());
     bool isBullish = (trend == MarketTrend::Bullish);
     bool isBearish = (trend == MarketTrend::Bearish);
 
     for (const auto& tmpl : templates) {
-        if ((isBullish && tmpl.requiresPositiveMarket) ||
-            (isBearish && tmpl.requiresNegativeMarket) ||
-            (!tmpl.requiresPositiveMarket && !tmpl.requiresNegativeMarket)) {
-            filteredTemplates.push_back(tmpl);
+        if ((isBullish && tmpl->requiresPositiveMarket) ||
+            (isBearish && tmpl->requiresNegativeMarket) ||
+            (!tmpl->requiresPositiveMarket && !tmpl->requiresNegativeMarket)) {
+            filteredTemplates.push_back(&tmpl);
         }
     }
 
     if (filteredTemplates.empty()) {
         return templates[Random::getIndex(templates.size())];
     } else {
-        return filteredTemplates[Random::getIndex(filteredTemplates.size())];
+        return *filteredTemplates[Random::getIndex(filteredTemplates.size())];
     }
 }
 
-std::string NewsService::processTemplate(const std::string& templ,
-                                        const std::shared_ptr<Company>& company) {
-    std::string result = templ;
+void NewsService::applyNewsEffects(std::vector<News>& news) {
+    auto marketPtr = market.lock();
+    if (!marketPtr) {
+        return;
+    }
 
-    if (company) {
-        size_t pos = result.find("%s");
-        while (pos != std::string::npos) {
-            result.replace(pos, 2, company->getName());
-            pos = result.find("%s", pos + company->getName().length());
+    bool pricesMoved = false;
+    for (auto& newsItem : news) {
+        if (newsItem.isProcessed()) {
+            continue;
         }
-    } else {
-        size_t pos = result.find("%s");
-        while (pos != std::string::npos) {
-            std::vector<std::string> possibleWords;
-
-            if (result.find("rate") != std::string::npos) {
-                possibleWords = {"increased", "decreased", "saved", "changed"};
-            } else if (result.find("economic") != std::string::npos) {
-                possibleWords = {"growth", "deceleration", "stabilization", "recovery"};
-            } else {
-                possibleWords = {"changes", "important news", "updated data"};
-            }
 
-            std::string replacement = possibleWords[Random::getIndex(possibleWords.size())];
-            result.replace(pos, 2, replacement);
+        double impact = newsItem.getImpact();
 
-            pos = result.find("%s", pos + replacement.length());
+        if (newsItem.shouldAffectMarket()) {
+            marketPtr->triggerEconomicEvent(impact);
+        } else if (newsItem.getType() == NewsType::Sector) {
+            Sector targetSector = newsItem.getTargetSector();
+            for (const auto& company : marketPtr->getCompaniesBySector(targetSector)) {
+                company->processNewsImpact(impact);
+            }
+            pricesMoved = true;
+        } else if (newsItem.getType() == NewsType::Corporate) {
+            auto targetCompany = newsItem.getTargetCompany().lock();
+            if (targetCompany) {
+                targetCompany->processNewsImpact(impact);
+                pricesMoved = true;
+            }
         }
-    }
 
-    size_t pos = result.find("%d");
-    while (pos != std::string::npos) {
-        int randomNumber = Random::getInt(5, 50);
-        std::string replacement = std::to_string(randomNumber);
-        result.replace(pos, 2, replacement);
-
-        pos = result.find("%d", pos + replacement.length());
+        markProcessed(newsItem);
     }
 
-    return result;
+    if (pricesMoved) {
+        marketPtr->refreshAggregates();
+    }
 }
 
-void NewsService::applyNewsEffects(const std::vector<News>& news) {
+void NewsService::collectNewsEffects(std::vector<News>& news, DailyCompanyEffects& effects) {
     auto marketPtr = market.lock();
     if (!marketPtr) {
         return;
     }
 
-    for (auto& newsItem : const_cast<std::vector<News>&>(news)) {
+    const auto& companies = marketPtr->getCompanies();
+    effects.newsFactors.assign(companies.size(), 1.0);
+
+    for (auto& newsItem : news) {
         if (newsItem.isProcessed()) {
             continue;
         }
@@ -343,34 +419,45 @@ void NewsService::applyNewsEffects(const std::vector<News>& news) {
         double impact = newsItem.getImpact();
 
         if (newsItem.shouldAffectMarket()) {
-            marketPtr->triggerEconomicEvent(impact);
+            effects.economicImpacts.push_back(impact);
         } else if (newsItem.getType() == NewsType::Sector) {
             Sector targetSector = newsItem.getTargetSector();
-            for (const auto& company : marketPtr->getCompaniesBySector(targetSector)) {
-                company->processNewsImpact(impact);
+            if (marketPtr->getSectorAggregates().get(targetSector).companyCount > 0) {
+                for (size_t i = 0; i < companies.size(); ++i) {
+                    if (companies[i]->getSector() == targetSector) {
+                        effects.newsFactors[i] *= 1.0 + impact;
+                    }
+                }
             }
         } else if (newsItem.getType() == NewsType::Corporate) {
             auto targetCompany = newsItem.getTargetCompany().lock();
-            if (targetCompany) {
-                targetCompany->processNewsImpact(impact);
+            auto it = std::find(companies.begin(), companies.end(), targetCompany);
+            if (targetCompany && it != companies.end()) {
+                effects.newsFactors[it - companies.begin()] *= 1.0 + impact;
             }
         }
 
-        newsItem.setProcessed(true);
+        markProcessed(newsItem);
+    }
+}
+
+void NewsService::markProcessed(News& news) {
+    news.setProcessed(true);
+    pageInHistory();
 
-        for (auto& historyNews : newsHistory) {
-            if (historyNews.getPublishDate() == newsItem.getPublishDate() &&
-                historyNews.getTitle() == newsItem.getTitle() &&
-                historyNews.getContent() == newsItem.getContent()) {
-                historyNews.setProcessed(true);
-                break;
-                }
+    for (size_t i = 0; i < newsHistory.size(); ++i) {
+        if (newsHistory[i].isSameEvent(news)) {
+            newsHistory.mutate(i).setProcessed(true);
+            version.bump();
+            break;
         }
     }
 }
 
 void NewsService::addCustomNews(const News& news) {
+    pageInHistory();
     newsHistory.push_back(news);
+    version.bump();
 }
 
 Date NewsService::getCurrentDate() const {
@@ -398,7 +485,7 @@ nlohmann::json NewsService::toJson() const {
     j["news_per_day"] = newsPerDay;
 
     j["news_history"] = nlohmann::json::array();
-    for (const auto& news : newsHistory) {
+    for (const auto& news : getNewsHistory()) {
         j["news_history"].push_back(news.toJson());
     }
 
@@ -407,41 +494,89 @@ nlohmann::json NewsService::toJson() const {
 
 NewsService NewsService::fromJson(const nlohmann::json& json, std::weak_ptr<Market> market) {
     NewsService service(market);
+    service.initialize();
+    service.restoreFromJson(json);
+    return service;
+}
 
+void NewsService::restoreFromJson(const nlohmann::json& json) {
     if (json.contains("current_date")) {
-        service.currentDate = Date::fromJson(json["current_date"]);
+        currentDate = Date::fromJson(json["current_date"]);
     } else if (json.contains("current_day")) {
         int currentDay = json["current_day"];
-        service.currentDate = Date::fromDayNumber(currentDay);
+        currentDate = Date::fromDayNumber(currentDay);
     } else {
-        service.currentDate = Date(1, 3, 2023);
+        currentDate = Date(1, 3, 2023);
     }
 
-    service.newsPerDay = json["news_per_day"];
+    newsPerDay = json["news_per_day"];
+
+    if (json.contains("news_history")) {
+        for (const auto& newsJson : json["news_history"]) {
+            appendNewsFromJson(newsJson);
+        }
+    }
+}
 
+void NewsService::appendNewsFromJson(const nlohmann::json& newsJson) {
+    pageInHistory();
     auto marketPtr = market.lock();
     if (marketPtr) {
-        const auto& companies = marketPtr->getCompanies();
+        newsHistory.push_back(News::fromJson(newsJson, marketPtr->getCompanies(), newsTemplates));
+        version.bump();
+    }
+}
 
-        for (const auto& newsJson : json["news_history"]) {
-            News news = News::fromJson(newsJson, companies);
-            service.newsHistory.push_back(news);
+void NewsService::setLazyNewsHistory(HistorySource source) {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    pendingHistory = std::move(source);
+    historyLoaded = !pendingHistory;
+}
+
+bool NewsService::isNewsHistoryLoaded() const {
+    return historyLoaded;
+}
+
+// Const readers such as the autosave task may race the simulation thread to
+// the first page-in, as with Stock::pageInHistory, and a source that throws
+// likewise stays pending.
+void NewsService::pageInHistory() const {
+    if (historyLoaded.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(historyMutex);
+    // News refers to companies, so paging in waits until a market is attached.
+    auto marketPtr = market.lock();
+    if (!pendingHistory || !marketPtr) {
+        return;
+    }
+
+    nlohmann::json history = pendingHistory();
+    std::vector<News> loaded;
+    if (history.is_array()) {
+        loaded.reserve(history.size());
+        for (const auto& newsJson : history) {
+            loaded.push_back(News::fromJson(newsJson, marketPtr->getCompanies(), newsTemplates));
         }
     }
-    
-    service.initialize();
-    
-    return service;
+    pendingHistory = nullptr;
+
+    for (auto& news : loaded) {
+        newsHistory.push_back(std::move(news));
+    }
+    historyLoaded.store(true, std::memory_order_release);
 }
 bool NewsService::isDuplicateNews(const News& news) const {
+    pageInHistory();
     size_t checkCount = std::min(newsHistory.size(), static_cast<size_t>(10));
 
     for (size_t i = newsHistory.size() - checkCount; i < newsHistory.size(); i++) {
         const News& existingNews = newsHistory[i];
 
         if (existingNews.getPublishDate() == news.getPublishDate() &&
-            existingNews.getTitle() == news.getTitle() &&
-            existingNews.getType() == news.getType()) {
+            existingNews.getType() == news.getType() &&
+            existingNews.hasSameHeadline(news)) {
 
             if (news.getType() == NewsType::Corporate) {
                 auto existingCompany = existingNews.getTargetCompany().lock();
@@ -4,6 +4,9 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <functional>
+#include <mutex>
+#include <atomic>
 #include <nlohmann/json.hpp>
 #include "../models/News.hpp"
 #include "../models/Company.hpp"
@@ -11,49 +14,95 @@
 #include "../utils/Random.hpp"
 #include "../utils/FileIO.hpp"
 #include "../utils/Date.hpp"
+#include "../utils/LruCache.hpp"
+#include "../utils/PersistentVector.hpp"
+#include "../utils/ChangeVersion.hpp"
 
 namespace StockMarketSimulator {
 
+struct NewsTextKey {
+    int templateId;
+    uint32_t variant;
+    std::string ticker;
+    bool content;
+
+    bool operator==(const NewsTextKey& other) const {
+        return templateId == other.templateId && variant == other.variant &&
+               ticker == other.ticker && content == other.content;
+    }
+};
+
+struct NewsTextKeyHash {
+    size_t operator()(const NewsTextKey& key) const {
+        size_t h = std::hash<int>()(key.templateId);
+        h = h * 31 + std::hash<uint32_t>()(key.variant);
+        h = h * 31 + std::hash<std::string>()(key.ticker);
+        return h * 2 + (key.content ? 1 : 0);
+    }
+};
+
 class NewsService {
+public:
+    using HistorySource = std::function<nlohmann::json()>;
+
 private:
     std::weak_ptr<Market> market;
-    std::vector<News> newsHistory;
-    std::vector<NewsTemplate> newsTemplates;
-    std::map<NewsType, std::vector<NewsTemplate>> categoryTemplates;
+    mutable PersistentVector<News> newsHistory;
+    mutable HistorySource pendingHistory;
+    std::vector<std::shared_ptr<const NewsTemplate>> newsTemplates;
+    std::map<NewsType, std::vector<std::shared_ptr<const NewsTemplate>>> categoryTemplates;
+    mutable LruCache<NewsTextKey, std::string, NewsTextKeyHash> renderedText;
 
     Date currentDate;
     int newsPerDay;
+    ChangeVersion version;
+
+    mutable std::mutex historyMutex;
+    mutable std::atomic<bool> historyLoaded;
 
     void loadNewsTemplates(const std::string& filePath);
 
     void createDefaultTemplates();
 
+    std::shared_ptr<const NewsTemplate> registerTemplate(NewsTemplate newsTemplate);
+
     News generateRandomNews(NewsType type);
 
-    std::string processTemplate(const std::string& templ,
-                                const std::shared_ptr<Company>& company = nullptr);
+    std::shared_ptr<const NewsTemplate> selectNewsTemplate(NewsType type, MarketTrend trend);
 
-    NewsTemplate selectNewsTemplate(NewsType type, MarketTrend trend);
+    std::string renderNewsText(const News& news, bool content) const;
 
     bool isDuplicateNews(const News& news) const;
 
+    void markProcessed(News& news);
+
+    void pageInHistory() const;
+
 public:
     NewsService();
     NewsService(std::weak_ptr<Market> market);
+    NewsService(const NewsService& other);
+
+    NewsService& operator=(const NewsService& other);
 
     void initialize(const std::string& templatesPath = "data/news_templates.json");
 
     void setMarket(std::weak_ptr<Market> market);
 
-    const std::vector<News>& getNewsHistory() const;
+    const PersistentVector<News>& getNewsHistory() const;
+    uint64_t getVersion() const;
 
     std::vector<News> getNewsByDay(int day) const;
 
     std::vector<News> getLatestNews(int count = 5) const;
 
+    std::string getNewsTitle(const News& news) const;
+    std::string getNewsContent(const News& news) const;
+
     std::vector<News> generateDailyNews(int newsCount = 0);
 
-    void applyNewsEffects(const std::vector<News>& news);
+    void applyNewsEffects(std::vector<News>& news);
+    void collectNewsEffects(std::vector<News>& news, DailyCompanyEffects& effects);
 
     void addCustomNews(const News& news);
 
@@ -65,6 +114,16 @@ public:
     
     nlohmann::json toJson() const;
     static NewsService fromJson(const nlohmann::json& json, std::weak_ptr<Market> market);
+
+    // Incremental counterparts of fromJson() for streaming loads; the
+    // service must already be initialized and attached to its market.
+    void restoreFromJson(const nlohmann::json& json);
+    void appendNewsFromJson(const nlohmann::json& newsJson);
+
+    // Defers the news history to a source returning its JSON array until the
+    // history is first read or extended.
+    void setLazyNewsHistory(HistorySource source);
+    bool isNewsHistoryLoaded() const;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,378 @@
+#include "OrderGateway.hpp"
+#include "../core/Game.hpp"
+#include "../core/OrderExecutor.hpp"
+#include "../utils/UnixSocket.hpp"
+#include "../utils/FileIO.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <map>
+#include <poll.h>
+#include <unistd.h>
+
+namespace StockMarketSimulator {
+
+OrderGateway::OrderGateway(const std::string& socketPath, size_t maxPendingOrders,
+                           size_t maxPendingBytes)
+    : socketPath(socketPath),
+      maxPendingOrders(maxPendingOrders),
+      maxPendingBytes(maxPendingBytes),
+      listenFd(-1),
+      wakeFds{-1, -1},
+      running(false),
+      nextClientId(1),
+      clientCount(0),
+      receivedOrders(0),
+      filledOrders(0),
+      rejectedOrders(0),
+      disconnectedClients(0)
+{
+}
+
+OrderGateway::~OrderGateway() {
+    stop();
+}
+
+bool OrderGateway::start() {
+    if (listenFd >= 0) {
+        return running;
+    }
+
+    listenFd = UnixSocket::listen(socketPath, lastError);
+    if (listenFd < 0) {
+        return false;
+    }
+
+    if (pipe(wakeFds) != 0) {
+        lastError = "Failed to create wake pipe";
+        UnixSocket::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    UnixSocket::setNonBlocking(wakeFds[0]);
+    UnixSocket::setNonBlocking(wakeFds[1]);
+
+    running = true;
+    ioThread = std::thread(&OrderGateway::ioLoop, this);
+
+    FileIO::appendToLog("Order gateway listening on " + socketPath);
+    return true;
+}
+
+void OrderGateway::stop() {
+    if (listenFd < 0) {
+        return;
+    }
+
+    running = false;
+    wake();
+
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+
+    for (auto& client : clients) {
+        UnixSocket::close(client.fd);
+    }
+    clients.clear();
+    clientCount = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pendingOrders.clear();
+        outgoingReports.clear();
+    }
+
+    UnixSocket::close(listenFd);
+    UnixSocket::close(wakeFds[0]);
+    UnixSocket::close(wakeFds[1]);
+    listenFd = wakeFds[0] = wakeFds[1] = -1;
+    UnixSocket::unlink(socketPath);
+}
+
+bool OrderGateway::isRunning() const {
+    return running;
+}
+
+void OrderGateway::wake() {
+    char byte = 1;
+    ssize_t written = write(wakeFds[1], &byte, 1);
+    (void)written;
+}
+
+void OrderGateway::drainWakePipe() {
+    char buffer[64];
+    while (read(wakeFds[0], buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+size_t OrderGateway::executePendingOrders(Game& game) {
+    std::vector<PendingOrder> orders;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        orders.swap(pendingOrders);
+    }
+
+    if (orders.empty()) {
+        return 0;
+    }
+
+    std::map<uint64_t, std::vector<OrderReport>> reportsByClient;
+    for (const auto& order : orders) {
+        OrderReport report = execute(game, order.request);
+        if (report.status == OrderStatus::Filled) {
+            filledOrders++;
+        } else {
+            rejectedOrders++;
+        }
+        reportsByClient[order.clientId].push_back(std::move(report));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (const auto& entry : reportsByClient) {
+            std::string frame;
+            OrderGatewayProtocol::appendReports(frame, entry.second);
+            outgoingReports.emplace_back(entry.first, std::move(frame));
+        }
+    }
+    wake();
+
+    return orders.size();
+}
+
+OrderReport OrderGateway::execute(Game& game, const OrderRequest& request) {
+    auto market = game.getMarket();
+    auto player = game.getPlayer();
+    if (!market || !player) {
+        return OrderReport{request.clientOrderId, OrderStatus::Rejected, request.ticker,
+                           request.quantity, 0.0, 0, "Game not initialized"};
+    }
+
+    return OrderExecutor::execute(*player, *market, request);
+}
+
+void OrderGateway::ioLoop() {
+    std::vector<pollfd> fds;
+
+    while (running) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakeFds[0], POLLIN, 0});
+        for (const auto& client : clients) {
+            short events = POLLIN;
+            if (!client.outbound.empty()) {
+                events |= POLLOUT;
+            }
+            fds.push_back({client.fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            drainWakePipe();
+        }
+
+        std::vector<bool> closed(clients.size(), false);
+        for (size_t i = 0; i < clients.size(); ++i) {
+            short revents = fds[i + 2].revents;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                closed[i] = !readClient(clients[i]);
+            }
+            if (!closed[i] && (revents & POLLOUT)) {
+                closed[i] = !flushClient(clients[i]);
+            }
+        }
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (closed[i]) {
+                dropClient(i);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            acceptClients();
+        }
+
+        deliverReports();
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (clients[i].outbound.empty()) {
+                continue;
+            }
+            if (!flushClient(clients[i])) {
+                dropClient(i);
+            } else if (clients[i].outbound.size() > maxPendingBytes) {
+                disconnectedClients++;
+                dropClient(i);
+            }
+        }
+
+        clientCount = clients.size();
+    }
+}
+
+void OrderGateway::acceptClients() {
+    while (true) {
+        int fd = UnixSocket::accept(listenFd);
+        if (fd < 0) {
+            break;
+        }
+        clients.push_back(Client{nextClientId++, fd, {}, {}});
+    }
+    clientCount = clients.size();
+}
+
+void OrderGateway::dropClient(size_t index) {
+    uint64_t clientId = clients[index].id;
+    UnixSocket::close(clients[index].fd);
+    clients.erase(clients.begin() + index);
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    pendingOrders.erase(std::remove_if(pendingOrders.begin(), pendingOrders.end(),
+                                       [clientId](const PendingOrder& order) {
+                                           return order.clientId == clientId;
+                                       }),
+                        pendingOrders.end());
+}
+
+bool OrderGateway::readClient(Client& client) {
+    char buffer[8192];
+    while (true) {
+        ssize_t bytes = UnixSocket::receive(client.fd, buffer, sizeof(buffer));
+        if (bytes > 0) {
+            client.inbound.append(buffer, static_cast<size_t>(bytes));
+            continue;
+        }
+        if (bytes == 0) {
+            return false;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    try {
+        OrderGatewayMessage message;
+        std::vector<OrderReport> acknowledgements;
+
+        while (OrderGatewayProtocol::extractMessage(client.inbound, message)) {
+            if (message.type != OrderGatewayMessageType::SubmitOrders) {
+                continue;
+            }
+
+            acknowledgements.clear();
+            acknowledgements.reserve(message.orders.size());
+            receivedOrders += message.orders.size();
+
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (auto& order : message.orders) {
+                OrderReport ack{order.clientOrderId, OrderStatus::Accepted, order.ticker,
+                                order.quantity, 0.0, 0, ""};
+
+                if (order.quantity <= 0) {
+                    ack.reason = "Quantity must be positive";
+                } else if (order.ticker.empty()) {
+                    ack.reason = "Missing ticker";
+                } else if (order.side != OrderSide::Buy && order.side != OrderSide::Sell) {
+                    ack.reason = "Unknown order side";
+                } else if (pendingOrders.size() >= maxPendingOrders) {
+                    ack.reason = "Order queue full";
+                }
+
+                if (ack.reason.empty()) {
+                    pendingOrders.push_back(PendingOrder{client.id, std::move(order)});
+                } else {
+                    ack.status = OrderStatus::Rejected;
+                    rejectedOrders++;
+                }
+                acknowledgements.push_back(std::move(ack));
+            }
+
+            OrderGatewayProtocol::appendReports(client.outbound, acknowledgements);
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    return true;
+}
+
+bool OrderGateway::flushClient(Client& client) {
+    size_t sent = 0;
+    while (sent < client.outbound.size()) {
+        ssize_t bytes = UnixSocket::send(client.fd, client.outbound.data() + sent, client.outbound.size() - sent);
+        if (bytes > 0) {
+            sent += static_cast<size_t>(bytes);
+            continue;
+        }
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+
+    client.outbound.erase(0, sent);
+    return true;
+}
+
+void OrderGateway::deliverReports() {
+    std::vector<std::pair<uint64_t, std::string>> reports;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        reports.swap(outgoingReports);
+    }
+
+    for (auto& entry : reports) {
+        auto it = std::find_if(clients.begin(), clients.end(),
+                               [&entry](const Client& client) { return client.id == entry.first; });
+        if (it != clients.end()) {
+            it->outbound += entry.second;
+        }
+    }
+}
+
+const std::string& OrderGateway::getSocketPath() const {
+    return socketPath;
+}
+
+std::string OrderGateway::getLastError() const {
+    return lastError;
+}
+
+size_t OrderGateway::getClientCount() const {
+    return clientCount;
+}
+
+size_t OrderGateway::getPendingOrderCount() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return pendingOrders.size();
+}
+
+uint64_t OrderGateway::getReceivedOrders() const {
+    return receivedOrders;
+}
+
+uint64_t OrderGateway::getFilledOrders() const {
+    return filledOrders;
+}
+
+uint64_t OrderGateway::getRejectedOrders() const {
+    return rejectedOrders;
+}
+
+uint64_t OrderGateway::getDisconnectedClients() const {
+    return disconnectedClients;
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "OrderGatewayProtocol.hpp"
+
+namespace StockMarketSimulator {
+
+class Game;
+
+// Accepts order batches from external processes on a Unix socket. The I/O
+// thread only decodes and acknowledges; orders are validated against player
+// state and executed on the simulation thread by executePendingOrders().
+class OrderGateway {
+private:
+    struct Client {
+        uint64_t id;
+        int fd;
+        std::string inbound;
+        std::string outbound;
+    };
+
+    struct PendingOrder {
+        uint64_t clientId;
+        OrderRequest request;
+    };
+
+    std::string socketPath;
+    size_t maxPendingOrders;
+    size_t maxPendingBytes;
+    int listenFd;
+    int wakeFds[2];
+    std::thread ioThread;
+    std::atomic<bool> running;
+    std::string lastError;
+
+    std::mutex queueMutex;
+    std::vector<PendingOrder> pendingOrders;
+    std::vector<std::pair<uint64_t, std::string>> outgoingReports;
+
+    std::vector<Client> clients;
+    uint64_t nextClientId;
+    std::atomic<size_t> clientCount;
+    std::atomic<uint64_t> receivedOrders;
+    std::atomic<uint64_t> filledOrders;
+    std::atomic<uint64_t> rejectedOrders;
+    std::atomic<uint64_t> disconnectedClients;
+
+    void ioLoop();
+    void acceptClients();
+    bool readClient(Client& client);
+    bool flushClient(Client& client);
+    void dropClient(size_t index);
+    void deliverReports();
+    void drainWakePipe();
+    void wake();
+
+    OrderReport execute(Game& game, const OrderRequest& request);
+
+public:
+    static constexpr size_t DEFAULT_MAX_PENDING_ORDERS = 100000;
+    static constexpr size_t DEFAULT_MAX_PENDING_BYTES = 4u << 20;
+
+    // Clients whose unsent reports exceed maxPendingBytes are disconnected;
+    // unlike market data, reports cannot be skipped without losing fills.
+    explicit OrderGateway(const std::string& socketPath,
+                          size_t maxPendingOrders = DEFAULT_MAX_PENDING_ORDERS,
+                          size_t maxPendingBytes = DEFAULT_MAX_PENDING_BYTES);
+    ~OrderGateway();
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    // Runs every queued order in arrival order at the current day boundary
+    // and streams fills back to the submitting clients. Returns the number
+    // of orders processed.
+    size_t executePendingOrders(Game& game);
+
+    const std::string& getSocketPath() const;
+    std::string getLastError() const;
+    size_t getClientCount() const;
+    size_t getPendingOrderCount();
+    uint64_t getReceivedOrders() const;
+    uint64_t getFilledOrders() const;
+    uint64_t getRejectedOrders() const;
+    uint64_t getDisconnectedClients() const;
+};
+
+}
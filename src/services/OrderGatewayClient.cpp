@@ -0,0 +1,100 @@
+#include "OrderGatewayClient.hpp"
+#include "../utils/UnixSocket.hpp"
+#include <cerrno>
+#include <chrono>
+#include <poll.h>
+
+namespace StockMarketSimulator {
+
+OrderGatewayClient::OrderGatewayClient()
+    : fd(-1)
+{
+}
+
+OrderGatewayClient::~OrderGatewayClient() {
+    disconnect();
+}
+
+bool OrderGatewayClient::connect(const std::string& socketPath) {
+    disconnect();
+    fd = UnixSocket::connect(socketPath, lastError);
+    return fd >= 0;
+}
+
+void OrderGatewayClient::disconnect() {
+    UnixSocket::close(fd);
+    fd = -1;
+    inbound.clear();
+}
+
+bool OrderGatewayClient::isConnected() const {
+    return fd >= 0;
+}
+
+bool OrderGatewayClient::sendAll(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t bytes = UnixSocket::send(fd, data.data() + sent, data.size() - sent);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            lastError = "Failed to send to order gateway";
+            return false;
+        }
+        sent += static_cast<size_t>(bytes);
+    }
+    return true;
+}
+
+bool OrderGatewayClient::submit(const std::vector<OrderRequest>& orders) {
+    std::string frame;
+    OrderGatewayProtocol::appendOrders(frame, orders);
+    return isConnected() && sendAll(frame);
+}
+
+bool OrderGatewayClient::receive(OrderGatewayMessage& message, int timeoutMilliseconds) {
+    using Clock = std::chrono::steady_clock;
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+
+    while (isConnected()) {
+        if (OrderGatewayProtocol::extractMessage(inbound, message)) {
+            return true;
+        }
+
+        int timeout = -1;
+        if (timeoutMilliseconds >= 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            if (remaining.count() <= 0) {
+                return false;
+            }
+            timeout = static_cast<int>(remaining.count());
+        }
+
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            return false;
+        }
+
+        char buffer[8192];
+        ssize_t bytes = UnixSocket::receive(fd, buffer, sizeof(buffer));
+        if (bytes <= 0) {
+            lastError = "Order gateway closed the connection";
+            disconnect();
+            return false;
+        }
+        inbound.append(buffer, static_cast<size_t>(bytes));
+    }
+
+    return false;
+}
+
+std::string OrderGatewayClient::getLastError() const {
+    return lastError;
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "OrderGatewayProtocol.hpp"
+
+namespace StockMarketSimulator {
+
+class OrderGatewayClient {
+private:
+    int fd;
+    std::string inbound;
+    std::string lastError;
+
+    bool sendAll(const std::string& data);
+
+public:
+    OrderGatewayClient();
+    ~OrderGatewayClient();
+
+    OrderGatewayClient(const OrderGatewayClient&) = delete;
+    OrderGatewayClient& operator=(const OrderGatewayClient&) = delete;
+
+    bool connect(const std::string& socketPath);
+    void disconnect();
+    bool isConnected() const;
+
+    // Sends the batch as a single frame without waiting for acknowledgements,
+    // so callers may pipeline any number of batches before reading reports.
+    bool submit(const std::vector<OrderRequest>& orders);
+
+    // Waits up to timeoutMilliseconds for the next message; a negative
+    // timeout blocks until one arrives or the gateway disconnects.
+    bool receive(OrderGatewayMessage& message, int timeoutMilliseconds);
+
+    std::string getLastError() const;
+};
+
+}
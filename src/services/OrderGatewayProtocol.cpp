@@ -0,0 +1,99 @@
+#include "OrderGatewayProtocol.hpp"
+#include <stdexcept>
+
+namespace StockMarketSimulator {
+
+void OrderGatewayProtocol::appendOrders(std::string& out, const std::vector<OrderRequest>& orders) {
+    FrameWriter writer(out, static_cast<uint8_t>(OrderGatewayMessageType::SubmitOrders));
+    writer.putUnsigned(orders.size(), 4);
+    for (const auto& order : orders) {
+        writer.putUnsigned(order.clientOrderId, 8);
+        writer.putUnsigned(static_cast<uint8_t>(order.side), 1);
+        writer.putString(order.ticker, 1);
+        writer.putInt32(order.quantity);
+        writer.putUnsigned(order.useMargin ? 1 : 0, 1);
+    }
+}
+
+void OrderGatewayProtocol::appendReports(std::string& out, const std::vector<OrderReport>& reports) {
+    FrameWriter writer(out, static_cast<uint8_t>(OrderGatewayMessageType::Reports));
+    writer.putUnsigned(reports.size(), 4);
+    for (const auto& report : reports) {
+        writer.putUnsigned(report.clientOrderId, 8);
+        writer.putUnsigned(static_cast<uint8_t>(report.status), 1);
+        writer.putString(report.ticker, 1);
+        writer.putInt32(report.quantity);
+        writer.putDouble(report.price);
+        writer.putInt32(report.day);
+        writer.putString(report.reason, 2);
+    }
+}
+
+bool OrderGatewayProtocol::extractMessage(std::string& buffer, OrderGatewayMessage& message) {
+    uint8_t type = 0;
+    uint32_t length = 0;
+    if (!FrameWriter::peek(buffer, MAX_PAYLOAD_SIZE, type, length)) {
+        return false;
+    }
+
+    message = OrderGatewayMessage();
+    message.type = static_cast<OrderGatewayMessageType>(type);
+    FrameReader reader(buffer, HEADER_SIZE, HEADER_SIZE + length);
+
+    switch (message.type) {
+        case OrderGatewayMessageType::SubmitOrders: {
+            size_t count = reader.getUnsigned(4);
+            for (size_t i = 0; i < count; ++i) {
+                OrderRequest order;
+                order.clientOrderId = reader.getUnsigned(8);
+                order.side = static_cast<OrderSide>(reader.getUnsigned(1));
+                order.ticker = reader.getString(1);
+                order.quantity = reader.getInt32();
+                order.useMargin = reader.getUnsigned(1) != 0;
+                message.orders.push_back(std::move(order));
+            }
+            break;
+        }
+
+        case OrderGatewayMessageType::Reports: {
+            size_t count = reader.getUnsigned(4);
+            for (size_t i = 0; i < count; ++i) {
+                OrderReport report;
+                report.clientOrderId = reader.getUnsigned(8);
+                report.status = static_cast<OrderStatus>(reader.getUnsigned(1));
+                report.ticker = reader.getString(1);
+                report.quantity = reader.getInt32();
+                report.price = reader.getDouble();
+                report.day = reader.getInt32();
+                report.reason = reader.getString(2);
+                message.reports.push_back(std::move(report));
+            }
+            break;
+        }
+
+        default:
+            throw std::runtime_error("Unknown order gateway message type");
+    }
+
+    buffer.erase(0, HEADER_SIZE + length);
+    return true;
+}
+
+std::string OrderGatewayProtocol::sideToString(OrderSide side) {
+    switch (side) {
+        case OrderSide::Buy: return "Buy";
+        case OrderSide::Sell: return "Sell";
+        default: return "Unknown";
+    }
+}
+
+std::string OrderGatewayProtocol::statusToString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::Accepted: return "Accepted";
+        case OrderStatus::Rejected: return "Rejected";
+        case OrderStatus::Filled: return "Filled";
+        default: return "Unknown";
+    }
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../models/Order.hpp"
+#include "../utils/BinaryFrame.hpp"
+
+namespace StockMarketSimulator {
+
+enum class OrderGatewayMessageType : uint8_t {
+    SubmitOrders = 1,
+    Reports = 16
+};
+
+struct OrderGatewayMessage {
+    OrderGatewayMessageType type;
+    std::vector<OrderRequest> orders;
+    std::vector<OrderReport> reports;
+};
+
+// Messages use the length-prefixed framing from BinaryFrame.hpp. A single
+// frame carries a whole batch so clients can pipeline many orders per write.
+class OrderGatewayProtocol {
+public:
+    static constexpr size_t HEADER_SIZE = FrameWriter::HEADER_SIZE;
+    static constexpr uint32_t MAX_PAYLOAD_SIZE = 16u * 1024u * 1024u;
+
+    static void appendOrders(std::string& out, const std::vector<OrderRequest>& orders);
+    static void appendReports(std::string& out, const std::vector<OrderReport>& reports);
+
+    // Removes one complete frame from the front of buffer and decodes it.
+    // Returns false when the buffer holds only a partial frame; throws
+    // std::runtime_error on malformed input.
+    static bool extractMessage(std::string& buffer, OrderGatewayMessage& message);
+
+    static std::string sideToString(OrderSide side);
+    static std::string statusToString(OrderStatus status);
+};
+
+}
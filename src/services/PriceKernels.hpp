@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "../models/Company.hpp"
+#include "../core/Market.hpp"
+#include "../utils/Random.hpp"
+
+namespace StockMarketSimulator {
+
+constexpr double MAX_DAILY_MOVEMENT = 0.1;
+
+template<MarketTrend T>
+struct TrendKernel {
+    static constexpr double mean = 0.0;
+    static constexpr double spread = 1.0;
+    static constexpr double floor = -MAX_DAILY_MOVEMENT;
+
+    static double amplify(double sectorTrend) {
+        return sectorTrend;
+    }
+};
+
+template<>
+struct TrendKernel<MarketTrend::Bullish> {
+    static constexpr double mean = 0.005;
+    static constexpr double spread = 1.0;
+    static constexpr double floor = 0.001;
+
+    static double amplify(double sectorTrend) {
+        return sectorTrend * (sectorTrend > 0 ? 1.2 : 1.0);
+    }
+};
+
+template<>
+struct TrendKernel<MarketTrend::Bearish> {
+    static constexpr double mean = -0.004;
+    static constexpr double spread = 1.0;
+    static constexpr double floor = -MAX_DAILY_MOVEMENT;
+
+    static double amplify(double sectorTrend) {
+        return sectorTrend * (sectorTrend < 0 ? 1.2 : 1.0);
+    }
+};
+
+template<>
+struct TrendKernel<MarketTrend::Sideways> {
+    static constexpr double mean = 0.0;
+    static constexpr double spread = 0.5;
+    static constexpr double floor = -MAX_DAILY_MOVEMENT;
+
+    static double amplify(double sectorTrend) {
+        return sectorTrend;
+    }
+};
+
+template<>
+struct TrendKernel<MarketTrend::Volatile> {
+    static constexpr double mean = 0.0;
+    static constexpr double spread = 2.0;
+    static constexpr double floor = -MAX_DAILY_MOVEMENT;
+
+    static double amplify(double sectorTrend) {
+        return sectorTrend;
+    }
+};
+
+struct GlobalRandomSource {
+    double getNormal(double mean, double stdDev) {
+        return Random::getNormal(mean, stdDev);
+    }
+};
+
+template<Sector S>
+struct SectorKernel {
+    static constexpr double weight = 0.5;
+
+    template<typename Source>
+    static double noise(Source&) {
+        return 0.0;
+    }
+};
+
+template<>
+struct SectorKernel<Sector::Technology> {
+    static constexpr double weight = 0.5;
+
+    template<typename Source>
+    static double noise(Source& source) {
+        return source.getNormal(0.002, 0.01);
+    }
+};
+
+template<>
+struct SectorKernel<Sector::Unknown> {
+    static constexpr double weight = 0.0;
+
+    template<typename Source>
+    static double noise(Source&) {
+        return 0.0;
+    }
+};
+
+template<typename Source>
+using SectorNoiseKernel = double (*)(Source& source);
+
+template<typename Source, size_t... I>
+constexpr std::array<SectorNoiseKernel<Source>, SECTOR_COUNT> makeSectorNoiseTable(std::index_sequence<I...>) {
+    return {{ &SectorKernel<static_cast<Sector>(I)>::template noise<Source>... }};
+}
+
+template<size_t... I>
+constexpr std::array<double, SECTOR_COUNT> makeSectorWeightTable(std::index_sequence<I...>) {
+    return {{ SectorKernel<static_cast<Sector>(I)>::weight... }};
+}
+
+template<typename Source>
+inline constexpr std::array<SectorNoiseKernel<Source>, SECTOR_COUNT> SECTOR_NOISE =
+    makeSectorNoiseTable<Source>(std::make_index_sequence<SECTOR_COUNT>{});
+
+inline constexpr std::array<double, SECTOR_COUNT> SECTOR_WEIGHTS =
+    makeSectorWeightTable(std::make_index_sequence<SECTOR_COUNT>{});
+
+struct PriceKernelBatch {
+    std::vector<double> trendDraw;
+    std::vector<double> randomDraw;
+    std::vector<double> sectorComponent;
+    std::vector<double> marketSensitivity;
+    std::vector<double> cycleSensitivity;
+    std::vector<double> momentumAverage;
+    std::vector<double> momentumWeight;
+    std::vector<double> movement;
+
+    void resize(size_t count) {
+        trendDraw.resize(count);
+        randomDraw.resize(count);
+        sectorComponent.resize(count);
+        marketSensitivity.resize(count);
+        cycleSensitivity.resize(count);
+        momentumAverage.resize(count);
+        momentumWeight.resize(count);
+        movement.resize(count);
+    }
+
+    size_t size() const {
+        return movement.size();
+    }
+};
+
+struct PriceKernelParams {
+    double trendStrength;
+    double randomnessFactor;
+    double cyclicalComponent;
+};
+
+template<MarketTrend T>
+void combinePriceMovements(PriceKernelBatch& batch, const PriceKernelParams& params) {
+    const size_t count = batch.size();
+    const double* trendDraw = batch.trendDraw.data();
+    const double* randomDraw = batch.randomDraw.data();
+    const double* sectorComponent = batch.sectorComponent.data();
+    const double* marketSensitivity = batch.marketSensitivity.data();
+    const double* cycleSensitivity = batch.cycleSensitivity.data();
+    const double* momentumAverage = batch.momentumAverage.data();
+    const double* momentumWeight = batch.momentumWeight.data();
+    double* movement = batch.movement.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        double total = trendDraw[i] * params.trendStrength * marketSensitivity[i] +
+                       params.cyclicalComponent * cycleSensitivity[i] +
+                       randomDraw[i] * params.randomnessFactor +
+                       sectorComponent[i];
+
+        total = total * (1.0 - momentumWeight[i]) + momentumAverage[i] * momentumWeight[i];
+
+        total = std::max(total, TrendKernel<T>::floor);
+        movement[i] = std::max(std::min(total, MAX_DAILY_MOVEMENT), -MAX_DAILY_MOVEMENT);
+    }
+}
+
+}
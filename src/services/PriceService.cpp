@@ -1,4 +1,5 @@
 #include "PriceService.hpp"
+#include "../utils/Profiler.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -45,7 +46,8 @@ PriceService::PriceService()
       trendStrength(0.6),
       momentumFactor(0.3),
       randomnessFactor(0.5),
-      economicCycle(365, 0, 0.02, 0.0)
+      economicCycle(365, 0, 0.02, 0.0),
+      parallelSeed(0)
 {
     initializeSectorProfiles();
 }
@@ -56,7 +58,8 @@ PriceService::PriceService(std::weak_ptr<Market> market)
       trendStrength(0.6),
       momentumFactor(0.3),
       randomnessFactor(0.5),
-      economicCycle(365, 0, 0.02, 0.0)
+      economicCycle(365, 0, 0.02, 0.0),
+      parallelSeed(0)
 {
     initializeSectorProfiles();
 }
@@ -70,40 +73,121 @@ void PriceService::setMarket(std::weak_ptr<Market> market) {
 }
 
 void PriceService::initializeSectorProfiles() {
-    sectorProfiles[Sector::Technology] = SectorVolatilityProfile(0.05, 0.8, 0.9, 0.3);
-
-    sectorProfiles[Sector::Energy] = SectorVolatilityProfile(0.015, 0.5, 0.6, 0.8);
-
-    sectorProfiles[Sector::Finance] = SectorVolatilityProfile(0.008, 0.8, 0.7, 0.4);
+    sectorProfiles = DEFAULT_SECTOR_PROFILES;
+}
 
-    sectorProfiles[Sector::Consumer] = SectorVolatilityProfile(0.008, 0.4, 0.7, 0.3);
+void PriceService::updatePrices() {
+    SMP_PROFILE_SCOPE("prices.update");
 
-    sectorProfiles[Sector::Manufacturing] = SectorVolatilityProfile(0.012, 0.6, 0.5, 0.6);
+    auto marketPtr = market.lock();
+    if (!marketPtr) {
+        return;
+    }
 
-    sectorProfiles[Sector::Unknown] = SectorVolatilityProfile(0.01, 0.5, 0.5, 0.5);
+    applyDailyMovements(generateDailyMovements());
 }
 
-void PriceService::updatePrices() {
+void PriceService::applyDailyMovements(const std::vector<double>& movements) {
+    SMP_PROFILE_SCOPE("prices.apply");
+
     auto marketPtr = market.lock();
     if (!marketPtr) {
         return;
     }
 
-    MarketTrend currentTrend = marketPtr->getCurrentTrend();
     const auto& companies = marketPtr->getCompanies();
 
-    for (const auto& company : companies) {
-        double priceMovement = generatePriceMovement(company, currentTrend);
+    for (size_t i = 0; i < movements.size() && i < companies.size(); ++i) {
+        double currentPrice = companies[i]->getStock()->getCurrentPrice();
 
-        Stock* stock = company->getStock();
-        double currentPrice = stock->getCurrentPrice();
+        double newPrice = currentPrice * (1.0 + movements[i]);
+
+        companies[i]->updatePrice(newPrice);
+    }
+}
 
-        double newPrice = currentPrice * (1.0 + priceMovement);
+const std::vector<double>& PriceService::generateDailyMovements() {
+    SMP_PROFILE_SCOPE("prices.generate");
 
-        stock->updatePrice(newPrice);
+    auto marketPtr = market.lock();
+    if (!marketPtr) {
+        kernelBatch.resize(0);
+        return kernelBatch.movement;
+    }
+
+    switch (marketPtr->getCurrentTrend()) {
+        case MarketTrend::Bullish:
+            generateMovementsWithKernel<MarketTrend::Bullish>(*marketPtr);
+            break;
+        case MarketTrend::Bearish:
+            generateMovementsWithKernel<MarketTrend::Bearish>(*marketPtr);
+            break;
+        case MarketTrend::Sideways:
+            generateMovementsWithKernel<MarketTrend::Sideways>(*marketPtr);
+            break;
+        case MarketTrend::Volatile:
+            generateMovementsWithKernel<MarketTrend::Volatile>(*marketPtr);
+            break;
     }
 
     advanceEconomicCycle();
+
+    return kernelBatch.movement;
+}
+
+template<MarketTrend T, typename Source>
+void PriceService::gatherKernelInputs(size_t i, const Company& company, double sectorTrend, Source& source) {
+    size_t sector = sectorIndex(company.getSector());
+    const auto& profile = sectorProfiles[sector];
+
+    kernelBatch.trendDraw[i] = generateTrendComponent<T>(source);
+    kernelBatch.randomDraw[i] = generateRandomComponent(profile.baseVolatility, source);
+    kernelBatch.sectorComponent[i] =
+        (TrendKernel<T>::amplify(sectorTrend) + SECTOR_NOISE<Source>[sector](source)) * SECTOR_WEIGHTS[sector];
+    kernelBatch.marketSensitivity[i] = profile.marketSensitivity;
+    kernelBatch.cycleSensitivity[i] = profile.cycleSensitivity;
+}
+
+template<MarketTrend T>
+void PriceService::generateMovementsWithKernel(const Market& marketRef) {
+    const auto& companies = marketRef.getCompanies();
+    const size_t count = companies.size();
+
+    kernelBatch.resize(count);
+    bindMovementHistories(companies);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& history = movementHistories[i].movements;
+        kernelBatch.momentumAverage[i] = recentMovementAverage(history);
+        kernelBatch.momentumWeight[i] = history.empty() ? 0.0 : momentumFactor;
+    }
+
+    if (pool) {
+        uint64_t day = static_cast<uint64_t>(marketRef.getCurrentDay());
+
+        pool->parallelFor(0, count, PARALLEL_GRAIN_SIZE, [&](size_t i) {
+            const Company& company = *companies[i];
+            RandomStream stream = RandomStream::derive(parallelSeed, day,
+                                                       RandomStream::keyFor(company.getTicker()),
+                                                       PRICE_STREAM_STAGE);
+            gatherKernelInputs<T>(i, company, marketRef.getSectorTrend(company.getSector()), stream);
+        });
+    } else {
+        GlobalRandomSource source;
+        for (size_t i = 0; i < count; ++i) {
+            const Company& company = *companies[i];
+            gatherKernelInputs<T>(i, company, marketRef.getSectorTrend(company.getSector()), source);
+        }
+    }
+
+    SMP_PROFILE_SCOPE("prices.combine");
+
+    PriceKernelParams params{trendStrength, randomnessFactor, generateCyclicalComponent()};
+    combinePriceMovements<T>(kernelBatch, params);
+
+    for (size_t i = 0; i < count; ++i) {
+        recordMovement(movementHistories[i].movements, kernelBatch.movement[i]);
+    }
 }
 
 double PriceService::generatePriceMovement(const std::shared_ptr<Company>& company, MarketTrend trend) {
@@ -111,52 +195,109 @@ double PriceService::generatePriceMovement(const std::shared_ptr<Company>& compa
         return 0.0;
     }
 
-    Sector sector = company->getSector();
+    auto marketPtr = market.lock();
+
+    switch (trend) {
+        case MarketTrend::Bullish:
+            return computePriceMovement<MarketTrend::Bullish>(*company, marketPtr.get());
+        case MarketTrend::Bearish:
+            return computePriceMovement<MarketTrend::Bearish>(*company, marketPtr.get());
+        case MarketTrend::Volatile:
+            return computePriceMovement<MarketTrend::Volatile>(*company, marketPtr.get());
+        default:
+            return computePriceMovement<MarketTrend::Sideways>(*company, marketPtr.get());
+    }
+}
+
+template<MarketTrend T>
+double PriceService::computePriceMovement(const Company& company, const Market* marketRef) {
+    Sector sector = company.getSector();
 
-    const auto& profile = sectorProfiles[sector];
+    const auto& profile = sectorProfiles[sectorIndex(sector)];
 
-    double trendComponent = generateTrendComponent(trend) * trendStrength * profile.marketSensitivity;
+    GlobalRandomSource source;
+    double trendComponent = generateTrendComponent<T>(source) * trendStrength * profile.marketSensitivity;
     double cyclicalComponent = generateCyclicalComponent() * profile.cycleSensitivity;
-    double randomComponent = generateRandomComponent(profile.baseVolatility) * randomnessFactor;
-    double sectorComponent = generateSectorComponent(sector, trend);
+    double randomComponent = generateRandomComponent(profile.baseVolatility, source) * randomnessFactor;
+    double sectorComponent = marketRef ? generateSectorComponent<T>(sector, marketRef->getSectorTrend(sector)) : 0.0;
 
     double totalMovement = trendComponent + cyclicalComponent + randomComponent + sectorComponent;
 
-    totalMovement = calculateMomentumEffect(company->getTicker(), totalMovement);
+    const std::string& ticker = company.getTicker();
+
+    totalMovement = calculateMomentumEffect(ticker, totalMovement);
+
+    totalMovement = std::max(totalMovement, TrendKernel<T>::floor);
+    totalMovement = std::max(std::min(totalMovement, MAX_DAILY_MOVEMENT), -MAX_DAILY_MOVEMENT);
+
+    recordMovement(movementHistoryFor(ticker), totalMovement);
 
-    if (trend == MarketTrend::Bullish) {
-        totalMovement = std::max(totalMovement, 0.001);
+    return totalMovement;
+}
+
+std::vector<double>& PriceService::movementHistoryFor(const std::string& ticker) {
+    auto it = movementSlots.find(ticker);
+    if (it != movementSlots.end()) {
+        return movementHistories[it->second].movements;
     }
 
-    double maxChange = 0.1;
-    totalMovement = std::max(std::min(totalMovement, maxChange), -maxChange);
+    movementSlots.emplace(ticker, movementHistories.size());
+    movementHistories.push_back(MovementHistory{ticker, {}, {}});
+    return movementHistories.back().movements;
+}
+
+// Only a change in membership or order pays for the ticker lookups; histories
+// of companies no longer in the market are kept after the bound slots.
+void PriceService::bindMovementHistories(const std::vector<std::shared_ptr<Company>>& companies) {
+    bool bound = movementHistories.size() >= companies.size();
+    for (size_t i = 0; bound && i < companies.size(); ++i) {
+        const auto& owner = movementHistories[i].company;
+        bound = !owner.owner_before(companies[i]) && !companies[i].owner_before(owner);
+    }
+    if (bound) {
+        return;
+    }
 
-    priceMovementHistory[company->getTicker()].push_back(totalMovement);
+    std::vector<MovementHistory> reordered;
+    reordered.reserve(std::max(movementHistories.size(), companies.size()));
+    std::vector<bool> taken(movementHistories.size(), false);
 
-    const size_t MAX_HISTORY_SIZE = 100;
-    if (priceMovementHistory[company->getTicker()].size() > MAX_HISTORY_SIZE) {
-        priceMovementHistory[company->getTicker()].erase(
-            priceMovementHistory[company->getTicker()].begin());
+    for (const auto& company : companies) {
+        MovementHistory entry{company->getTicker(), company, {}};
+        auto it = movementSlots.find(entry.ticker);
+        if (it != movementSlots.end() && !taken[it->second]) {
+            entry.movements = std::move(movementHistories[it->second].movements);
+            taken[it->second] = true;
+        }
+        reordered.push_back(std::move(entry));
+    }
+    for (size_t i = 0; i < movementHistories.size(); ++i) {
+        if (!taken[i]) {
+            reordered.push_back(std::move(movementHistories[i]));
+        }
     }
 
-    return totalMovement;
+    movementHistories = std::move(reordered);
+    movementSlots.clear();
+    for (size_t i = 0; i < movementHistories.size(); ++i) {
+        movementSlots.emplace(movementHistories[i].ticker, i);
+    }
 }
 
-double PriceService::generateTrendComponent(MarketTrend trend) const {
-    switch (trend) {
-        case MarketTrend::Bullish:
-            return Random::getNormal(0.005, marketVolatilityFactor);
-        case MarketTrend::Bearish:
-            return Random::getNormal(-0.004, marketVolatilityFactor);
-        case MarketTrend::Sideways:
-            return Random::getNormal(0.0, marketVolatilityFactor * 0.5);
-        case MarketTrend::Volatile:
-            return Random::getNormal(0.0, marketVolatilityFactor * 2.0);
-        default:
-            return Random::getNormal(0.0, marketVolatilityFactor);
+void PriceService::recordMovement(std::vector<double>& history, double movement) {
+    history.push_back(movement);
+
+    const size_t MAX_HISTORY_SIZE = 100;
+    if (history.size() > MAX_HISTORY_SIZE) {
+        history.erase(history.begin());
     }
 }
 
+template<MarketTrend T, typename Source>
+double PriceService::generateTrendComponent(Source& source) const {
+    return source.getNormal(TrendKernel<T>::mean, marketVolatilityFactor * TrendKernel<T>::spread);
+}
+
 double PriceService::generateCyclicalComponent() const {
     double phase = (static_cast<double>(economicCycle.currentPosition) / economicCycle.cycleLength) * 2.0 * M_PI;
     phase += economicCycle.phaseShift;
@@ -164,53 +305,41 @@ double PriceService::generateCyclicalComponent() const {
     return std::sin(phase) * economicCycle.amplitude;
 }
 
-double PriceService::generateRandomComponent(double volatility) const {
-    return Random::getNormal(0.0, volatility);
+template<typename Source>
+double PriceService::generateRandomComponent(double volatility, Source& source) const {
+    return source.getNormal(0.0, volatility);
 }
 
-double PriceService::generateSectorComponent(Sector sector, MarketTrend trend) const {
-    auto marketPtr = market.lock();
-    if (!marketPtr) {
+template<MarketTrend T>
+double PriceService::generateSectorComponent(Sector sector, double sectorTrend) const {
+    size_t idx = sectorIndex(sector);
+    GlobalRandomSource source;
+    return (TrendKernel<T>::amplify(sectorTrend) + SECTOR_NOISE<GlobalRandomSource>[idx](source)) * SECTOR_WEIGHTS[idx];
+}
+
+double PriceService::recentMovementAverage(const std::vector<double>& history) {
+    if (history.empty()) {
         return 0.0;
     }
 
-    const auto& sectorTrends = marketPtr->getSectorTrends();
-    auto it = sectorTrends.find(sector);
-
-    if (it != sectorTrends.end()) {
-        double sectorTrend = it->second;
-
-        if (trend == MarketTrend::Bullish && sectorTrend > 0) {
-            sectorTrend *= 1.2;
-        } else if (trend == MarketTrend::Bearish && sectorTrend < 0) {
-            sectorTrend *= 1.2;
-        }
+    int lookback = std::min(5, static_cast<int>(history.size()));
+    double recentAverage = 0.0;
 
-        if (sector == Sector::Technology) {
-            sectorTrend += Random::getNormal(0.002, 0.01);
-        }
-        
-        return sectorTrend * 0.5;
+    for (int i = static_cast<int>(history.size()) - 1; i >= static_cast<int>(history.size()) - lookback; --i) {
+        recentAverage += history[i];
     }
-    
-    return 0.0;
+
+    return recentAverage / lookback;
 }
 
 double PriceService::calculateMomentumEffect(const std::string& ticker, double newMovement) {
-    const auto& history = priceMovementHistory[ticker];
+    const auto& history = movementHistoryFor(ticker);
     
     if (history.empty()) {
         return newMovement;
     }
     
-    int lookback = std::min(5, static_cast<int>(history.size()));
-    double recentAverage = 0.0;
-    
-    for (int i = static_cast<int>(history.size()) - 1; i >= static_cast<int>(history.size()) - lookback; --i) {
-        recentAverage += history[i];
-    }
-    
-    recentAverage /= lookback;
+    double recentAverage = recentMovementAverage(history);
     
     return newMovement * (1.0 - momentumFactor) + recentAverage * momentumFactor;
 }
@@ -219,6 +348,15 @@ void PriceService::advanceEconomicCycle(int days) {
     economicCycle.currentPosition = (economicCycle.currentPosition + days) % economicCycle.cycleLength;
 }
 
+void PriceService::setParallelMode(std::shared_ptr<WorkStealingPool> pool, uint64_t seed) {
+    this->pool = pool;
+    parallelSeed = seed;
+}
+
+bool PriceService::isParallelMode() const {
+    return pool != nullptr;
+}
+
 void PriceService::simulateMarketShock(double magnitude, bool positive) {
     auto marketPtr = market.lock();
     if (!marketPtr) {
@@ -299,22 +437,17 @@ void PriceService::setEconomicCycleParams(const EconomicCycleParams& params) {
 }
 
 const SectorVolatilityProfile& PriceService::getSectorProfile(Sector sector) const {
-    auto it = sectorProfiles.find(sector);
-    if (it != sectorProfiles.end()) {
-        return it->second;
-    }
-    
-    return sectorProfiles.at(Sector::Unknown);
+    return sectorProfiles[sectorIndex(sector)];
 }
 
 void PriceService::setSectorProfile(Sector sector, const SectorVolatilityProfile& profile) {
-    sectorProfiles[sector] = profile;
+    sectorProfiles[sectorIndex(sector)] = profile;
 }
 
 const std::vector<double>& PriceService::getPriceMovementHistory(const std::string& ticker) const {
-    auto it = priceMovementHistory.find(ticker);
-    if (it != priceMovementHistory.end()) {
-        return it->second;
+    auto it = movementSlots.find(ticker);
+    if (it != movementSlots.end()) {
+        return movementHistories[it->second].movements;
     }
     
     static const std::vector<double> emptyHistory;
@@ -331,13 +464,13 @@ nlohmann::json PriceService::toJson() const {
     j["economic_cycle"] = economicCycle.toJson();
     
     j["sector_profiles"] = nlohmann::json::object();
-    for (const auto& [sector, profile] : sectorProfiles) {
-        j["sector_profiles"][Market::sectorToString(sector)] = profile.toJson();
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        j["sector_profiles"][Market::sectorToString(static_cast<Sector>(i))] = sectorProfiles[i].toJson();
     }
     
     j["price_movement_history"] = nlohmann::json::object();
-    for (const auto& [ticker, history] : priceMovementHistory) {
-        j["price_movement_history"][ticker] = history;
+    for (const auto& history : movementHistories) {
+        j["price_movement_history"][history.ticker] = history.movements;
     }
     
     return j;
@@ -354,12 +487,11 @@ PriceService PriceService::fromJson(const nlohmann::json& json, std::weak_ptr<Ma
     
     for (auto it = json["sector_profiles"].begin(); it != json["sector_profiles"].end(); ++it) {
         Sector sector = Market::sectorFromString(it.key());
-        service.sectorProfiles[sector] = SectorVolatilityProfile::fromJson(it.value());
+        service.sectorProfiles[sectorIndex(sector)] = SectorVolatilityProfile::fromJson(it.value());
     }
     
     for (auto it = json["price_movement_history"].begin(); it != json["price_movement_history"].end(); ++it) {
-        std::string ticker = it.key();
-        service.priceMovementHistory[ticker] = it.value().get<std::vector<double>>();
+        service.movementHistoryFor(it.key()) = it.value().get<std::vector<double>>();
     }
     
     return service;
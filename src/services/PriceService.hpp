@@ -4,11 +4,16 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <array>
 #include <nlohmann/json.hpp>
 #include "../models/Company.hpp"
 #include "../core/Market.hpp"
 #include "../utils/Random.hpp"
 #include "../utils/FileIO.hpp"
+#include "../utils/RandomStream.hpp"
+#include "../utils/WorkStealingPool.hpp"
+#include "PriceKernels.hpp"
 
 namespace StockMarketSimulator {
 
@@ -18,8 +23,8 @@ struct SectorVolatilityProfile {
     double newsSensitivity;
     double cycleSensitivity;
 
-    SectorVolatilityProfile(double base = 0.01, double market = 0.5,
-                            double news = 0.8, double cycle = 0.3)
+    constexpr SectorVolatilityProfile(double base = 0.01, double market = 0.5,
+                                      double news = 0.8, double cycle = 0.3)
         : baseVolatility(base), marketSensitivity(market),
           newsSensitivity(news), cycleSensitivity(cycle)
     {}
@@ -28,6 +33,21 @@ struct SectorVolatilityProfile {
     static SectorVolatilityProfile fromJson(const nlohmann::json& json);
 };
 
+using SectorProfileTable = std::array<SectorVolatilityProfile, SECTOR_COUNT>;
+
+constexpr SectorProfileTable makeDefaultSectorProfiles() {
+    SectorProfileTable table{};
+    table[sectorIndex(Sector::Technology)] = SectorVolatilityProfile(0.05, 0.8, 0.9, 0.3);
+    table[sectorIndex(Sector::Energy)] = SectorVolatilityProfile(0.015, 0.5, 0.6, 0.8);
+    table[sectorIndex(Sector::Finance)] = SectorVolatilityProfile(0.008, 0.8, 0.7, 0.4);
+    table[sectorIndex(Sector::Consumer)] = SectorVolatilityProfile(0.008, 0.4, 0.7, 0.3);
+    table[sectorIndex(Sector::Manufacturing)] = SectorVolatilityProfile(0.012, 0.6, 0.5, 0.6);
+    table[sectorIndex(Sector::Unknown)] = SectorVolatilityProfile(0.01, 0.5, 0.5, 0.5);
+    return table;
+}
+
+inline constexpr SectorProfileTable DEFAULT_SECTOR_PROFILES = makeDefaultSectorProfiles();
+
 struct EconomicCycleParams {
     int cycleLength;
     int currentPosition;
@@ -44,6 +64,12 @@ struct EconomicCycleParams {
     static EconomicCycleParams fromJson(const nlohmann::json& json);
 };
 
+struct MovementHistory {
+    std::string ticker;
+    std::weak_ptr<Company> company;
+    std::vector<double> movements;
+};
+
 class PriceService {
 private:
     std::weak_ptr<Market> market;
@@ -53,16 +79,40 @@ private:
     double momentumFactor;
     double randomnessFactor;
 
-    std::map<Sector, SectorVolatilityProfile> sectorProfiles;
+    SectorProfileTable sectorProfiles;
     EconomicCycleParams economicCycle;
 
-    std::map<std::string, std::vector<double>> priceMovementHistory;
+    // Kept in the market's company order so the daily kernel reaches each
+    // history by slot; movementSlots maps tickers for everything else.
+    std::vector<MovementHistory> movementHistories;
+    std::unordered_map<std::string, size_t> movementSlots;
 
-    double generateTrendComponent(MarketTrend trend) const;
+    PriceKernelBatch kernelBatch;
+
+    std::shared_ptr<WorkStealingPool> pool;
+    uint64_t parallelSeed;
+
+    static constexpr size_t PARALLEL_GRAIN_SIZE = 256;
+    static constexpr uint64_t PRICE_STREAM_STAGE = 1;
+
+    template<MarketTrend T, typename Source>
+    void gatherKernelInputs(size_t i, const Company& company, double sectorTrend, Source& source);
+    template<MarketTrend T>
+    void generateMovementsWithKernel(const Market& marketRef);
+    template<MarketTrend T>
+    double computePriceMovement(const Company& company, const Market* marketRef);
+    template<MarketTrend T, typename Source>
+    double generateTrendComponent(Source& source) const;
     double generateCyclicalComponent() const;
-    double generateRandomComponent(double volatility) const;
-    double generateSectorComponent(Sector sector, MarketTrend trend) const;
+    template<typename Source>
+    double generateRandomComponent(double volatility, Source& source) const;
+    template<MarketTrend T>
+    double generateSectorComponent(Sector sector, double sectorTrend) const;
     double calculateMomentumEffect(const std::string& ticker, double newMovement);
+    static double recentMovementAverage(const std::vector<double>& history);
+    static void recordMovement(std::vector<double>& history, double movement);
+    std::vector<double>& movementHistoryFor(const std::string& ticker);
+    void bindMovementHistories(const std::vector<std::shared_ptr<Company>>& companies);
 
     void initializeSectorProfiles();
 
@@ -74,9 +124,14 @@ public:
     void setMarket(std::weak_ptr<Market> market);
 
     void updatePrices();
+    const std::vector<double>& generateDailyMovements();
+    void applyDailyMovements(const std::vector<double>& movements);
     double generatePriceMovement(const std::shared_ptr<Company>& company, MarketTrend trend);
     void advanceEconomicCycle(int days = 1);
 
+    void setParallelMode(std::shared_ptr<WorkStealingPool> pool, uint64_t seed);
+    bool isParallelMode() const;
+
     void simulateMarketShock(double magnitude, bool positive = false);
     void simulateSectorShock(Sector sector, double magnitude, bool positive = false);
 
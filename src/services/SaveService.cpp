@@ -1,4 +1,8 @@
 #include "SaveService.hpp"
+#include "SaveStreamLoader.hpp"
+#include "../utils/Profiler.hpp"
+#include "../utils/SectionedJsonFile.hpp"
+#include "../utils/Compression.hpp"
 #include <chrono>
 #include <iomanip>
 #include <sstream>
@@ -58,7 +62,9 @@ SaveService::SaveService()
     : savesDirectory("data/saves"),
       autosaveEnabled(true),
       autosaveInterval(5),
-      lastAutosaveDate()
+      lastAutosaveDate(),
+      saveDurability(Durability::Full),
+      autosaveDurability(Durability::Data)
 {
 }
 
@@ -73,7 +79,9 @@ SaveService::SaveService(std::weak_ptr<Market> market,
       savesDirectory("data/saves"),
       autosaveEnabled(true),
       autosaveInterval(5),
-      lastAutosaveDate()
+      lastAutosaveDate(),
+      saveDurability(Durability::Full),
+      autosaveDurability(Durability::Data)
 {
 }
 
@@ -85,69 +93,103 @@ void SaveService::initialize(const std::string& savesDirectory) {
     }
 }
 
+size_t SaveService::removeUnfinishedSaves(int minimumAgeSeconds) {
+    size_t removed = FileIO::removeTemporaryFiles(savesDirectory, minimumAgeSeconds);
+    if (removed > 0) {
+        FileIO::appendToLog("Removed " + std::to_string(removed) + " unfinished save file(s) from " + savesDirectory);
+    }
+    return removed;
+}
+
 bool SaveService::saveGame(const std::string& displayName, bool isAutosave) {
-    nlohmann::json saveData = createSaveData();
-    if (saveData.empty()) {
+    SMP_PROFILE_SCOPE("save.total");
+
+    auto playerPtr = player.lock();
+    if (!playerPtr) {
         return false;
     }
 
     std::string filename = generateSaveFilename(displayName, isAutosave);
     std::string filePath = FileIO::combineFilePath(savesDirectory, filename);
 
+    SaveMetadata metadata(filename,
+                        displayName,
+                        playerPtr->getCurrentDate(),
+                        playerPtr->getNetWorth(),
+                        getCurrentDateTimeString(),
+                        isAutosave);
+
+    // A history that cannot be paged in from the loaded save throws here, so
+    // the save is refused instead of being written without it.
+    std::string saveData;
     try {
-        FileIO::writeJsonFile(filePath, saveData, true);
-
-        auto playerPtr = player.lock();
-        if (playerPtr) {
-            SaveMetadata metadata(filename,
-                                displayName,
-                                playerPtr->getCurrentDate(),
-                                playerPtr->getNetWorth(),
-                                getCurrentDateTimeString(),
-                                isAutosave);
-
-            std::string metadataPath = FileIO::combineFilePath(savesDirectory, filename + ".meta");
-            FileIO::writeJsonFile(metadataPath, metadata.toJson(), true);
-        }
+        SMP_PROFILE_SCOPE("save.serialize");
+        saveData = createSaveData(metadata);
+    } catch (const std::exception& e) {
+        FileIO::appendToLog("Failed to save " + filename + ": " + e.what());
+        return false;
+    }
+    if (saveData.empty()) {
+        return false;
+    }
+
+    try {
+        SMP_PROFILE_SCOPE("save.write");
+
+        // The save is renamed into place before its metadata, so a .meta file
+        // never describes a save that is not fully on disk. The .meta file only
+        // caches the save's own metadata section, so it skips the data sync and
+        // each save costs a single one.
+        std::string metadataPath = FileIO::combineFilePath(savesDirectory, filename + ".meta");
+        FileIO::writeFileAtomically(filePath, saveData, getDurability(isAutosave));
+        FileIO::writeFileAtomically(metadataPath, metadata.toJson().dump(4), Durability::Atomic);
 
         return true;
     } catch (const std::exception& e) {
+        FileIO::appendToLog("Failed to save " + filename + ": " + e.what());
         return false;
     }
 }
 
 bool SaveService::loadGame(const std::string& filename) {
+    SMP_PROFILE_SCOPE("load.total");
     std::string filePath = FileIO::combineFilePath(savesDirectory, filename);
 
     if (!FileIO::fileExists(filePath)) {
         return false;
     }
 
-    try {
-        nlohmann::json saveData = FileIO::readJsonFile(filePath);
-
-        if (!validateSaveData(saveData)) {
-            return false;
-        }
+    auto marketPtr = market.lock();
+    auto playerPtr = player.lock();
+    auto newsServicePtr = newsService.lock();
+    auto priceServicePtr = priceService.lock();
 
-        auto marketPtr = market.lock();
-        auto playerPtr = player.lock();
-        auto newsServicePtr = newsService.lock();
-        auto priceServicePtr = priceService.lock();
+    if (!marketPtr || !playerPtr) {
+        return false;
+    }
 
-        if (!marketPtr || !playerPtr) {
+    try {
+        SaveStreamLoader loader;
+        if (!loader.loadFile(filePath)) {
+            FileIO::appendToLog("Failed to load " + filename + ": " + loader.getLastError());
             return false;
         }
 
-        *marketPtr = Market::fromJson(saveData["market"]);
-        *playerPtr = Player::fromJson(saveData["player"], marketPtr);
+        // The staged objects are moved into the live ones so that everything
+        // holding the game's services keeps pointing at valid state.
+        *marketPtr = std::move(*loader.getMarket());
+
+        *playerPtr = *loader.getPlayer();
+        playerPtr->setMarket(marketPtr);
 
-        if (newsServicePtr && saveData.contains("news_service")) {
-            *newsServicePtr = NewsService::fromJson(saveData["news_service"], marketPtr);
+        if (newsServicePtr && loader.getNewsService()) {
+            *newsServicePtr = *loader.getNewsService();
+            newsServicePtr->setMarket(marketPtr);
         }
 
-        if (priceServicePtr && saveData.contains("price_service")) {
-            *priceServicePtr = PriceService::fromJson(saveData["price_service"], marketPtr);
+        if (priceServicePtr && loader.getPriceService()) {
+            *priceServicePtr = *loader.getPriceService();
+            priceServicePtr->setMarket(marketPtr);
         }
 
         lastAutosaveDate = playerPtr->getCurrentDate();
@@ -187,21 +229,7 @@ std::vector<SaveMetadata> SaveService::listSaves() const {
             continue;
         }
 
-        std::string metadataPath = FileIO::combineFilePath(savesDirectory, file + ".meta");
-
-        if (FileIO::fileExists(metadataPath)) {
-            try {
-                nlohmann::json metadataJson = FileIO::readJsonFile(metadataPath);
-                saves.push_back(SaveMetadata::fromJson(metadataJson));
-            } catch (const std::exception& e) {
-                std::string displayName = "Metadata error: " + file;
-                SaveMetadata errorMetadata(file, displayName, Date(), 0.0, "Damaged file", false);
-                saves.push_back(errorMetadata);
-            }
-        } else {
-            std::string displayName = file;
-            saves.push_back(SaveMetadata(file, displayName, Date(), 0.0, "", false));
-        }
+        saves.push_back(getSaveMetadata(file));
     }
 
     return saves;
@@ -210,18 +238,38 @@ std::vector<SaveMetadata> SaveService::listSaves() const {
 SaveMetadata SaveService::getSaveMetadata(const std::string& filename) const {
     std::string metadataPath = FileIO::combineFilePath(savesDirectory, filename + ".meta");
 
+    // A .meta file left damaged by a crash falls back to the save's section.
+    std::string metadataError;
     if (FileIO::fileExists(metadataPath)) {
         try {
             nlohmann::json metadataJson = FileIO::readJsonFile(metadataPath);
             return SaveMetadata::fromJson(metadataJson);
         } catch (const std::exception& e) {
-            SaveMetadata errorMetadata(filename, filename, Date(), 0.0, "", false);
-            errorMetadata.errorMessage = "Failed to read metadata: " + std::string(e.what());
-            return errorMetadata;
+            metadataError = "Failed to read metadata: " + std::string(e.what());
+        }
+    }
+
+    nlohmann::json metadataJson;
+    if (readSaveSection(filename, "metadata", metadataJson)) {
+        try {
+            SaveMetadata metadata = SaveMetadata::fromJson(metadataJson);
+            metadata.filename = filename;
+            return metadata;
+        } catch (const std::exception& e) {
         }
     }
 
-    return SaveMetadata(filename, filename, Date(), 0.0, "", false);
+    SaveMetadata fallback(filename, filename, Date(), 0.0, "", false);
+    fallback.errorMessage = metadataError;
+    return fallback;
+}
+
+bool SaveService::readSaveSection(const std::string& filename, const std::string& section, nlohmann::json& value) const {
+    SMP_PROFILE_SCOPE("load.section");
+    SectionedJsonReader reader;
+    nlohmann::json stored;
+    return reader.open(FileIO::combineFilePath(savesDirectory, filename)) &&
+           reader.readSection(section, stored) && Compression::unpackJson(stored, value);
 }
 
 void SaveService::setAutosave(bool enabled, int interval) {
@@ -268,6 +316,15 @@ bool SaveService::checkAndCreateAutosave() {
     return false;
 }
 
+void SaveService::setDurability(Durability saves, Durability autosaves) {
+    saveDurability = saves;
+    autosaveDurability = autosaves;
+}
+
+Durability SaveService::getDurability(bool isAutosave) const {
+    return isAutosave ? autosaveDurability : saveDurability;
+}
+
 std::string SaveService::getSavesDirectory() const {
     return savesDirectory;
 }
@@ -296,48 +353,62 @@ void SaveService::setPriceService(std::weak_ptr<PriceService> priceService) {
     this->priceService = priceService;
 }
 
-nlohmann::json SaveService::createSaveData() const {
-    nlohmann::json saveData;
-
+std::string SaveService::createSaveData(const SaveMetadata& metadata) const {
     auto marketPtr = market.lock();
     auto playerPtr = player.lock();
     auto newsServicePtr = newsService.lock();
     auto priceServicePtr = priceService.lock();
 
     if (!marketPtr || !playerPtr) {
-        return nlohmann::json();
+        return std::string();
     }
 
-    saveData["market"] = marketPtr->toJson();
-    saveData["player"] = playerPtr->toJson();
-
-    if (newsServicePtr) {
-        saveData["news_service"] = newsServicePtr->toJson();
+    // Histories get sections of their own so that loading the rest of the
+    // save never has to parse them. Price series are XOR-encoded and the news
+    // history is LZ-compressed; both read back through Compression::unpack*.
+    nlohmann::json marketJson = marketPtr->toJson();
+    nlohmann::json priceHistories = nlohmann::json::array();
+    for (auto& companyJson : marketJson["companies"]) {
+        if (!companyJson.contains("stock")) {
+            continue;
+        }
+        nlohmann::json& stockJson = companyJson["stock"];
+        std::vector<double> prices = stockJson["price_history"].get<std::vector<double>>();
+        priceHistories.push_back({{"ticker", companyJson["ticker"]},
+                                  {"prices", Compression::packDoubles(prices)}});
+        stockJson.erase("price_history");
     }
 
+    SectionedJsonWriter writer;
+    writer.addSection("save_version", SaveStreamLoader::LATEST_SAVE_VERSION);
+    writer.addSection("save_date", metadata.saveDate);
+    writer.addSection("metadata", metadata.toJson());
+    writer.addSection("player", playerPtr->toJson());
+    writer.addSection("market", marketJson);
+
     if (priceServicePtr) {
-        saveData["price_service"] = priceServicePtr->toJson();
+        nlohmann::json priceJson = priceServicePtr->toJson();
+        for (auto& history : priceJson["price_movement_history"]) {
+            history = Compression::packDoubles(history.get<std::vector<double>>());
+        }
+        writer.addSection("price_service", priceJson);
     }
 
-    saveData["save_version"] = 1;
-    saveData["save_date"] = getCurrentDateTimeString();
-
-    return saveData;
-}
-
-bool SaveService::validateSaveData(const nlohmann::json& saveData) const {
-    if (!saveData.contains("market") || !saveData.contains("player")) {
-        return false;
+    if (newsServicePtr) {
+        nlohmann::json newsJson = newsServicePtr->toJson();
+        nlohmann::json newsHistory = Compression::packJson(newsJson["news_history"]);
+        newsJson.erase("news_history");
+        writer.addSection("news_service", newsJson);
+        writer.addSection("news_history", newsHistory);
     }
 
-    if (saveData.contains("save_version")) {
-        int version = saveData["save_version"];
-        if (version > 1) {
-            return false;
-        }
+    writer.beginArray("price_histories");
+    for (auto& entry : priceHistories) {
+        writer.addElement(entry["ticker"].get<std::string>(), entry);
     }
+    writer.endArray();
 
-    return true;
+    return writer.finish();
 }
 
 std::string SaveService::generateSaveFilename(const std::string& displayName, bool isAutosave) const {
@@ -34,6 +34,9 @@ struct SaveMetadata {
 };
 
 class SaveService {
+public:
+    static constexpr int UNFINISHED_SAVE_AGE_SECONDS = 60;
+
 private:
     std::weak_ptr<Market> market;
     std::weak_ptr<Player> player;
@@ -44,9 +47,10 @@ private:
     bool autosaveEnabled;
     int autosaveInterval;
     Date lastAutosaveDate;
+    Durability saveDurability;
+    Durability autosaveDurability;
 
-    nlohmann::json createSaveData() const;
-    bool validateSaveData(const nlohmann::json& saveData) const;
+    std::string createSaveData(const SaveMetadata& metadata) const;
     std::string generateSaveFilename(const std::string& displayName, bool isAutosave) const;
     std::string getCurrentDateTimeString() const;
 
@@ -58,6 +62,9 @@ public:
                 std::weak_ptr<PriceService> priceService);
 
     void initialize(const std::string& savesDirectory = "data/saves");
+    // Deletes save temporaries a crash left behind. Meant for startup; the
+    // age threshold spares files another running instance is still writing.
+    size_t removeUnfinishedSaves(int minimumAgeSeconds = UNFINISHED_SAVE_AGE_SECONDS);
 
     bool saveGame(const std::string& displayName, bool isAutosave = false);
     bool loadGame(const std::string& filename);
@@ -65,11 +72,21 @@ public:
     
     std::vector<SaveMetadata> listSaves() const;
     SaveMetadata getSaveMetadata(const std::string& filename) const;
+
+    // Reads one section ("metadata", "market", "player", ...) of a sectioned
+    // save without parsing the others. Legacy saves are not sectioned.
+    bool readSaveSection(const std::string& filename, const std::string& section, nlohmann::json& value) const;
     
     void setAutosave(bool enabled, int interval = 5);
     bool isAutosaveEnabled() const;
     int getAutosaveInterval() const;
     bool checkAndCreateAutosave();
+
+    // Applies to the save file; its .meta preview is always written Atomic.
+    // Manual saves default to Full; autosaves to Data, which skips the
+    // directory sync since each autosave goes to a fresh file anyway.
+    void setDurability(Durability saves, Durability autosaves);
+    Durability getDurability(bool isAutosave) const;
     
     std::string getSavesDirectory() const;
     void setSavesDirectory(const std::string& directory);
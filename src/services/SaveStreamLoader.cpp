@@ -0,0 +1,298 @@
+#include "SaveStreamLoader.hpp"
+#include "../utils/JsonStreamReader.hpp"
+#include "../utils/FileIO.hpp"
+#include "../utils/Compression.hpp"
+#include "../utils/Profiler.hpp"
+#include <fstream>
+#include <stdexcept>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+// Price movement series may be XOR-encoded; PriceService::fromJson wants arrays.
+bool unpackPriceService(nlohmann::json& priceJson) {
+    if (!priceJson.contains("price_movement_history")) {
+        return true;
+    }
+    for (auto& history : priceJson["price_movement_history"]) {
+        std::vector<double> values;
+        if (!Compression::unpackDoubles(history, values)) {
+            return false;
+        }
+        history = values;
+    }
+    return true;
+}
+
+}
+
+SaveStreamLoader::SaveStreamLoader()
+    : saveVersion(0)
+{
+}
+
+void SaveStreamLoader::reset() {
+    market.reset();
+    player.reset();
+    newsService.reset();
+    priceService.reset();
+    companies.clear();
+    companiesByTicker.clear();
+    portfolioHistory.clear();
+    transactions.clear();
+    deferred.clear();
+    saveVersion = 0;
+    lastError.clear();
+}
+
+NewsService& SaveStreamLoader::ensureNewsService() {
+    if (!newsService) {
+        newsService = std::make_shared<NewsService>(market);
+        newsService->initialize();
+    }
+    return *newsService;
+}
+
+void SaveStreamLoader::finishMarket(nlohmann::json& marketJson) {
+    for (const auto& company : companies) {
+        companiesByTicker[company->getTicker()] = company;
+    }
+
+    market = std::make_shared<Market>(Market::fromJson(marketJson, std::move(companies)));
+    companies.clear();
+
+    // Sections written ahead of the market wait until its companies exist.
+    for (auto& entry : deferred) {
+        handle(entry.first, entry.second);
+    }
+    deferred.clear();
+}
+
+void SaveStreamLoader::handle(Pending kind, nlohmann::json& value) {
+    if (!market) {
+        deferred.emplace_back(kind, std::move(value));
+        return;
+    }
+
+    switch (kind) {
+        case Pending::NewsItem:
+            ensureNewsService().appendNewsFromJson(value);
+            break;
+        case Pending::PackedNews: {
+            nlohmann::json history;
+            if (value.is_object() && Compression::unpackJson(value, history) && history.is_array()) {
+                for (const auto& newsJson : history) {
+                    ensureNewsService().appendNewsFromJson(newsJson);
+                }
+            }
+            break;
+        }
+        case Pending::PriceHistory: {
+            auto it = companiesByTicker.find(value.value("ticker", std::string()));
+            std::vector<double> prices;
+            if (it != companiesByTicker.end() && value.contains("prices") &&
+                Compression::unpackDoubles(value["prices"], prices)) {
+                it->second->getStock()->setLazyPriceHistory([prices]() { return prices; });
+            }
+            break;
+        }
+        case Pending::HistoryEntry:
+            portfolioHistory.push_back(PortfolioHistory::fromJson(value));
+            break;
+        case Pending::TransactionEntry: {
+            Transaction transaction = Transaction::fromJson(value);
+            auto it = companiesByTicker.find(value.value("company_ticker", std::string()));
+            if (it != companiesByTicker.end()) {
+                transaction.setCompany(it->second);
+            }
+            transactions.push_back(transaction);
+            break;
+        }
+        case Pending::PlayerSection:
+            player = std::make_shared<Player>(Player::fromJson(value, market));
+            player->getPortfolio()->restoreLedgers(std::move(portfolioHistory), std::move(transactions));
+            break;
+        case Pending::NewsSection:
+            ensureNewsService().restoreFromJson(value);
+            break;
+        case Pending::PriceSection:
+            if (unpackPriceService(value)) {
+                priceService = std::make_shared<PriceService>(PriceService::fromJson(value, market));
+            }
+            break;
+    }
+}
+
+bool SaveStreamLoader::load(std::istream& input) {
+    SMP_PROFILE_SCOPE("load.stream");
+    reset();
+
+    JsonStreamReader reader;
+    reader.onValue({"market", "companies", "*"}, [this](nlohmann::json& value) {
+        companies.push_back(Company::fromJson(value));
+    });
+    reader.onValue({"market"}, [this](nlohmann::json& value) {
+        finishMarket(value);
+    });
+    reader.onValue({"news_service", "news_history", "*"}, [this](nlohmann::json& value) {
+        handle(Pending::NewsItem, value);
+    });
+    reader.onValue({"news_history", "*"}, [this](nlohmann::json& value) {
+        handle(Pending::NewsItem, value);
+    });
+    reader.onValue({"news_history"}, [this](nlohmann::json& value) {
+        handle(Pending::PackedNews, value);
+    });
+    reader.onValue({"price_histories", "*"}, [this](nlohmann::json& value) {
+        handle(Pending::PriceHistory, value);
+    });
+    reader.onValue({"news_service"}, [this](nlohmann::json& value) {
+        handle(Pending::NewsSection, value);
+    });
+    reader.onValue({"player", "portfolio", "history", "*"}, [this](nlohmann::json& value) {
+        handle(Pending::HistoryEntry, value);
+    });
+    reader.onValue({"player", "portfolio", "transactions", "*"}, [this](nlohmann::json& value) {
+        handle(Pending::TransactionEntry, value);
+    });
+    reader.onValue({"player"}, [this](nlohmann::json& value) {
+        handle(Pending::PlayerSection, value);
+    });
+    reader.onValue({"price_service"}, [this](nlohmann::json& value) {
+        handle(Pending::PriceSection, value);
+    });
+
+    nlohmann::json remainder;
+    if (!reader.parse(input, remainder)) {
+        lastError = "Failed to parse save: " + reader.getLastError();
+        return false;
+    }
+
+    if (!market || !player) {
+        lastError = "Save is missing the market or player section";
+        return false;
+    }
+
+    saveVersion = remainder.value("save_version", 1);
+    return checkVersion();
+}
+
+bool SaveStreamLoader::checkVersion() {
+    if (saveVersion > LATEST_SAVE_VERSION) {
+        lastError = "Unsupported save version " + std::to_string(saveVersion);
+        return false;
+    }
+    return true;
+}
+
+bool SaveStreamLoader::loadSections(const std::string& filePath) {
+    SMP_PROFILE_SCOPE("load.sections");
+    reset();
+
+    auto reader = std::make_shared<SectionedJsonReader>();
+    if (!reader->open(filePath)) {
+        lastError = reader->getLastError();
+        return false;
+    }
+
+    nlohmann::json section;
+    saveVersion = reader->readSection("save_version", section) ? section.get<int>() : 1;
+    if (!checkVersion()) {
+        return false;
+    }
+
+    if (!reader->readSection("market", section)) {
+        lastError = "Save is missing the market or player section";
+        return false;
+    }
+    market = std::make_shared<Market>(Market::fromJson(section));
+
+    if (!reader->readSection("player", section)) {
+        market.reset();
+        lastError = "Save is missing the market or player section";
+        return false;
+    }
+    player = std::make_shared<Player>(Player::fromJson(section, market));
+
+    if (reader->readSection("news_service", section)) {
+        ensureNewsService().restoreFromJson(section);
+    }
+    if (reader->hasSection("news_history")) {
+        ensureNewsService().setLazyNewsHistory([reader]() {
+            nlohmann::json stored;
+            nlohmann::json history;
+            if (!reader->readSection("news_history", stored) || !Compression::unpackJson(stored, history)) {
+                std::string error = "Failed to page in news history from " + reader->getFilePath();
+                FileIO::appendToLog(error);
+                throw std::runtime_error(error);
+            }
+            return history;
+        });
+    }
+
+    if (reader->readSection("price_service", section) && unpackPriceService(section)) {
+        priceService = std::make_shared<PriceService>(PriceService::fromJson(section, market));
+    }
+
+    for (const auto& company : market->getCompanies()) {
+        std::string name = "price_histories/" + company->getTicker();
+        if (!reader->hasSection(name) || !company->getStock()) {
+            continue;
+        }
+
+        company->getStock()->setLazyPriceHistory([reader, name]() {
+            nlohmann::json entry;
+            std::vector<double> prices;
+            if (!reader->readSection(name, entry) || !entry.contains("prices") ||
+                !Compression::unpackDoubles(entry["prices"], prices)) {
+                std::string error = "Failed to page in " + name + " from " + reader->getFilePath();
+                FileIO::appendToLog(error);
+                throw std::runtime_error(error);
+            }
+            return prices;
+        });
+    }
+
+    return true;
+}
+
+bool SaveStreamLoader::loadFile(const std::string& filePath) {
+    if (SectionedJsonReader::isSectioned(filePath)) {
+        return loadSections(filePath);
+    }
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        reset();
+        lastError = "Failed to open save: " + filePath;
+        return false;
+    }
+    return load(file);
+}
+
+std::shared_ptr<Market> SaveStreamLoader::getMarket() const {
+    return market;
+}
+
+std::shared_ptr<Player> SaveStreamLoader::getPlayer() const {
+    return player;
+}
+
+std::shared_ptr<NewsService> SaveStreamLoader::getNewsService() const {
+    return newsService;
+}
+
+std::shared_ptr<PriceService> SaveStreamLoader::getPriceService() const {
+    return priceService;
+}
+
+int SaveStreamLoader::getSaveVersion() const {
+    return saveVersion;
+}
+
+std::string SaveStreamLoader::getLastError() const {
+    return lastError;
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../core/Market.hpp"
+#include "../core/Player.hpp"
+#include "NewsService.hpp"
+#include "PriceService.hpp"
+#include "../utils/PersistentVector.hpp"
+#include "../utils/SectionedJsonFile.hpp"
+
+namespace StockMarketSimulator {
+
+// Builds the game objects of a save file while it is being parsed. Companies,
+// news items and portfolio ledger entries are converted one at a time, so the
+// DOM never holds more than the element in flight plus the small sections.
+// Sectioned saves skip parsing altogether for what is not needed: loadFile()
+// seeks to the sections it restores and leaves price and news histories to be
+// paged in on first access. Everything is staged on private objects; nothing
+// live is touched.
+class SaveStreamLoader {
+public:
+    static constexpr int LATEST_SAVE_VERSION = 3;
+
+private:
+    enum class Pending {
+        NewsItem,
+        PackedNews,
+        PriceHistory,
+        HistoryEntry,
+        TransactionEntry,
+        PlayerSection,
+        NewsSection,
+        PriceSection
+    };
+
+    std::shared_ptr<Market> market;
+    std::shared_ptr<Player> player;
+    std::shared_ptr<NewsService> newsService;
+    std::shared_ptr<PriceService> priceService;
+
+    std::vector<std::shared_ptr<Company>> companies;
+    std::unordered_map<std::string, std::shared_ptr<Company>> companiesByTicker;
+    PersistentVector<PortfolioHistory> portfolioHistory;
+    PersistentVector<Transaction> transactions;
+    std::vector<std::pair<Pending, nlohmann::json>> deferred;
+
+    int saveVersion;
+    std::string lastError;
+
+    void reset();
+    void finishMarket(nlohmann::json& marketJson);
+    void handle(Pending kind, nlohmann::json& value);
+    NewsService& ensureNewsService();
+    bool checkVersion();
+    bool loadSections(const std::string& filePath);
+
+public:
+    SaveStreamLoader();
+
+    bool load(std::istream& input);
+    bool loadFile(const std::string& filePath);
+
+    std::shared_ptr<Market> getMarket() const;
+    std::shared_ptr<Player> getPlayer() const;
+    std::shared_ptr<NewsService> getNewsService() const;
+    std::shared_ptr<PriceService> getPriceService() const;
+    int getSaveVersion() const;
+    std::string getLastError() const;
+};
+
+}
@@ -0,0 +1,465 @@
+#include "SharedMarketFeed.hpp"
+#include "../utils/FileIO.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace StockMarketSimulator {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared feed sequence must be lock-free to be shared across processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "Shared feed retired flag must be lock-free to be shared across processes");
+
+namespace {
+
+constexpr size_t CACHE_LINE = 64;
+
+size_t alignUp(size_t value) {
+    return (value + CACHE_LINE - 1) & ~(CACHE_LINE - 1);
+}
+
+std::string segmentPath(const std::string& name) {
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+std::string systemError(const char* call) {
+    return std::string(call) + ": " + std::strerror(errno);
+}
+
+bool processAlive(int32_t pid) {
+    return pid > 0 && (kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+// True while `name` still refers to the object behind `fd`, i.e. nobody has
+// unlinked it and published their own segment under the same name since.
+bool namesSegment(const std::string& name, int fd) {
+    struct stat ours;
+    if (fstat(fd, &ours) != 0) {
+        return false;
+    }
+
+    int namedFd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (namedFd < 0) {
+        return false;
+    }
+
+    struct stat named;
+    bool same = fstat(namedFd, &named) == 0
+        && named.st_dev == ours.st_dev
+        && named.st_ino == ours.st_ino;
+    ::close(namedFd);
+    return same;
+}
+
+}
+
+size_t SharedFeedSnapshot::size() const {
+    return tickers.size();
+}
+
+int SharedFeedSnapshot::indexOf(const std::string& ticker) const {
+    auto it = std::find(tickers.begin(), tickers.end(), ticker);
+    return (it != tickers.end()) ? static_cast<int>(it - tickers.begin()) : -1;
+}
+
+size_t SharedMarketFeedLayout::tickerOffset() {
+    return alignUp(sizeof(SharedFeedHeader));
+}
+
+size_t SharedMarketFeedLayout::columnOffset(uint32_t capacity, SharedFeedColumn column) {
+    size_t first = alignUp(tickerOffset() + static_cast<size_t>(capacity) * TICKER_WIDTH);
+    return first + static_cast<size_t>(column) * alignUp(static_cast<size_t>(capacity) * sizeof(double));
+}
+
+size_t SharedMarketFeedLayout::segmentSize(uint32_t capacity) {
+    return columnOffset(capacity, SharedFeedColumn::CurrentPrice)
+         + COLUMN_COUNT * alignUp(static_cast<size_t>(capacity) * sizeof(double));
+}
+
+SharedMarketFeed::SharedMarketFeed(const std::string& name, uint32_t capacity)
+    : name(segmentPath(name)),
+      capacity(std::max<uint32_t>(capacity, 1)),
+      fd(-1),
+      mapping(nullptr),
+      mappingSize(0),
+      header(nullptr)
+{
+}
+
+SharedMarketFeed::~SharedMarketFeed() {
+    close();
+}
+
+bool SharedMarketFeed::open() {
+    if (header) {
+        return true;
+    }
+
+    if (!map(capacity)) {
+        return false;
+    }
+
+    FileIO::appendToLog("Shared market feed published at " + name);
+    return true;
+}
+
+void SharedMarketFeed::close() {
+    unmap();
+}
+
+bool SharedMarketFeed::isOpen() const {
+    return header != nullptr;
+}
+
+bool SharedMarketFeed::map(uint32_t requestedCapacity) {
+    unmap();
+
+    // A fresh object per mapping: readers still attached to a retired segment
+    // keep a valid (unlinked) mapping until they notice and re-open by name.
+    lastError.clear();
+    int newFd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (newFd < 0 && errno == EEXIST && claimStaleSegment()) {
+        newFd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (newFd < 0) {
+        if (lastError.empty()) {
+            lastError = systemError("shm_open");
+        }
+        return false;
+    }
+
+    size_t size = SharedMarketFeedLayout::segmentSize(requestedCapacity);
+    if (ftruncate(newFd, static_cast<off_t>(size)) != 0) {
+        lastError = systemError("ftruncate");
+        ::close(newFd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, newFd, 0);
+    if (address == MAP_FAILED) {
+        lastError = systemError("mmap");
+        ::close(newFd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    std::memset(address, 0, size);
+    header = new (address) SharedFeedHeader();
+    header->capacity = requestedCapacity;
+    header->layoutVersion = SharedMarketFeedLayout::VERSION;
+    header->writerPid = static_cast<int32_t>(getpid());
+    header->retired.store(0, std::memory_order_relaxed);
+    header->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SharedMarketFeedLayout::MAGIC;
+
+    fd = newFd;
+    mapping = address;
+    mappingSize = size;
+    capacity = requestedCapacity;
+    return true;
+}
+
+// Another segment already holds the name. It is only taken over when the
+// writer that published it has retired it or is no longer running; a live
+// writer, or one still initializing, keeps the name and open() fails.
+bool SharedMarketFeed::claimStaleSegment() {
+    int existingFd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (existingFd < 0) {
+        // Unlinked between the two calls; let the caller retry the create.
+        return errno == ENOENT;
+    }
+
+    bool stale = false;
+    struct stat info;
+    if (fstat(existingFd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedFeedHeader)) {
+        void* address = mmap(nullptr, sizeof(SharedFeedHeader), PROT_READ, MAP_SHARED, existingFd, 0);
+        if (address != MAP_FAILED) {
+            const auto* existing = static_cast<const SharedFeedHeader*>(address);
+            bool published = existing->magic == SharedMarketFeedLayout::MAGIC;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            stale = published
+                && existing->layoutVersion == SharedMarketFeedLayout::VERSION
+                && (existing->retired.load(std::memory_order_acquire)
+                    || !processAlive(existing->writerPid));
+            munmap(address, sizeof(SharedFeedHeader));
+        }
+    }
+
+    if (!stale) {
+        lastError = "Shared market feed " + name + " is held by another writer";
+        ::close(existingFd);
+        return false;
+    }
+
+    if (namesSegment(name, existingFd)) {
+        shm_unlink(name.c_str());
+    }
+    ::close(existingFd);
+    FileIO::appendToLog("Replaced stale shared market feed at " + name);
+    return true;
+}
+
+void SharedMarketFeed::unmap() {
+    if (!header) {
+        return;
+    }
+
+    header->retired.store(1, std::memory_order_release);
+    munmap(mapping, mappingSize);
+    if (namesSegment(name, fd)) {
+        shm_unlink(name.c_str());
+    }
+    ::close(fd);
+
+    header = nullptr;
+    mapping = nullptr;
+    mappingSize = 0;
+    fd = -1;
+}
+
+double* SharedMarketFeed::column(SharedFeedColumn column) {
+    return reinterpret_cast<double*>(static_cast<char*>(mapping)
+                                     + SharedMarketFeedLayout::columnOffset(capacity, column));
+}
+
+bool SharedMarketFeed::publish(const Market& market) {
+    if (!header) {
+        lastError = "Shared market feed is not open";
+        return false;
+    }
+
+    const auto& companies = market.getCompanies();
+    if (companies.size() > capacity) {
+        uint32_t grown = std::max<uint32_t>(static_cast<uint32_t>(companies.size()), capacity * 2);
+        if (!map(grown)) {
+            return false;
+        }
+    }
+
+    char* tickers = static_cast<char*>(mapping) + SharedMarketFeedLayout::tickerOffset();
+    double* current = column(SharedFeedColumn::CurrentPrice);
+    double* open = column(SharedFeedColumn::OpenPrice);
+    double* previousClose = column(SharedFeedColumn::PreviousClose);
+    double* high = column(SharedFeedColumn::HighPrice);
+    double* low = column(SharedFeedColumn::LowPrice);
+
+    uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const MarketState& state = market.getState();
+    header->count = static_cast<uint32_t>(companies.size());
+    header->day = market.getCurrentDay();
+    header->indexValue = state.indexValue;
+    header->dailyChange = state.dailyChange;
+    header->dailyChangePercent = state.dailyChangePercent;
+    header->currentTrend = static_cast<int32_t>(state.currentTrend);
+    header->trendDuration = state.trendDuration;
+    header->interestRate = state.interestRate;
+    header->inflationRate = state.inflationRate;
+    header->unemploymentRate = state.unemploymentRate;
+
+    for (size_t i = 0; i < companies.size(); ++i) {
+        const auto& ticker = companies[i]->getTicker();
+        char* slot = tickers + i * SharedMarketFeedLayout::TICKER_WIDTH;
+        size_t length = std::min(ticker.size(), SharedMarketFeedLayout::TICKER_WIDTH - 1);
+        std::memcpy(slot, ticker.data(), length);
+        std::memset(slot + length, 0, SharedMarketFeedLayout::TICKER_WIDTH - length);
+
+        const auto& stock = companies[i]->getStock();
+        current[i] = stock->getCurrentPrice();
+        open[i] = stock->getOpenPrice();
+        previousClose[i] = stock->getPreviousClosePrice();
+        high[i] = stock->getHighestPrice();
+        low[i] = stock->getLowestPrice();
+    }
+
+    header->sequence.store(sequence + 2, std::memory_order_release);
+    return true;
+}
+
+const std::string& SharedMarketFeed::getName() const {
+    return name;
+}
+
+uint32_t SharedMarketFeed::getCapacity() const {
+    return capacity;
+}
+
+uint64_t SharedMarketFeed::getSequence() const {
+    return header ? header->sequence.load(std::memory_order_acquire) : 0;
+}
+
+std::string SharedMarketFeed::getLastError() const {
+    return lastError;
+}
+
+SharedMarketFeedReader::SharedMarketFeedReader(const std::string& name)
+    : name(segmentPath(name)),
+      fd(-1),
+      mapping(nullptr),
+      mappingSize(0),
+      header(nullptr)
+{
+}
+
+SharedMarketFeedReader::~SharedMarketFeedReader() {
+    close();
+}
+
+bool SharedMarketFeedReader::open() {
+    close();
+
+    int newFd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (newFd < 0) {
+        lastError = systemError("shm_open");
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(newFd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedFeedHeader)) {
+        lastError = "Shared market feed segment is not initialized";
+        ::close(newFd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, newFd, 0);
+    if (address == MAP_FAILED) {
+        lastError = systemError("mmap");
+        ::close(newFd);
+        return false;
+    }
+
+    const auto* candidate = static_cast<const SharedFeedHeader*>(address);
+    bool valid = candidate->magic == SharedMarketFeedLayout::MAGIC;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    valid = valid
+        && candidate->layoutVersion == SharedMarketFeedLayout::VERSION
+        && SharedMarketFeedLayout::segmentSize(candidate->capacity) <= size;
+
+    if (!valid) {
+        lastError = "Shared market feed segment has an unexpected layout";
+        munmap(address, size);
+        ::close(newFd);
+        return false;
+    }
+
+    fd = newFd;
+    mapping = address;
+    mappingSize = size;
+    header = candidate;
+    return true;
+}
+
+void SharedMarketFeedReader::close() {
+    if (!header) {
+        return;
+    }
+
+    munmap(mapping, mappingSize);
+    ::close(fd);
+
+    header = nullptr;
+    mapping = nullptr;
+    mappingSize = 0;
+    fd = -1;
+}
+
+bool SharedMarketFeedReader::isOpen() const {
+    return header != nullptr;
+}
+
+const double* SharedMarketFeedReader::column(SharedFeedColumn column) const {
+    return reinterpret_cast<const double*>(static_cast<const char*>(mapping)
+                                           + SharedMarketFeedLayout::columnOffset(header->capacity, column));
+}
+
+bool SharedMarketFeedReader::read(SharedFeedSnapshot& snapshot, int maxAttempts) {
+    if (!header || header->retired.load(std::memory_order_acquire)) {
+        if (!open()) {
+            return false;
+        }
+    }
+
+    const char* tickers = static_cast<const char*>(mapping) + SharedMarketFeedLayout::tickerOffset();
+    const double* columns[SharedMarketFeedLayout::COLUMN_COUNT] = {
+        column(SharedFeedColumn::CurrentPrice),
+        column(SharedFeedColumn::OpenPrice),
+        column(SharedFeedColumn::PreviousClose),
+        column(SharedFeedColumn::HighPrice),
+        column(SharedFeedColumn::LowPrice)
+    };
+    std::vector<double>* targets[SharedMarketFeedLayout::COLUMN_COUNT] = {
+        &snapshot.currentPrices,
+        &snapshot.openPrices,
+        &snapshot.previousClosePrices,
+        &snapshot.highPrices,
+        &snapshot.lowPrices
+    };
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        uint64_t begin = header->sequence.load(std::memory_order_acquire);
+        if (begin & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        size_t count = std::min(header->count, header->capacity);
+        int day = header->day;
+        MarketState state;
+        state.indexValue = header->indexValue;
+        state.dailyChange = header->dailyChange;
+        state.dailyChangePercent = header->dailyChangePercent;
+        state.currentTrend = static_cast<MarketTrend>(header->currentTrend);
+        state.trendDuration = header->trendDuration;
+        state.interestRate = header->interestRate;
+        state.inflationRate = header->inflationRate;
+        state.unemploymentRate = header->unemploymentRate;
+
+        tickerBuffer.resize(count * SharedMarketFeedLayout::TICKER_WIDTH);
+        std::memcpy(tickerBuffer.data(), tickers, tickerBuffer.size());
+        for (size_t c = 0; c < SharedMarketFeedLayout::COLUMN_COUNT; ++c) {
+            targets[c]->resize(count);
+            std::memcpy(targets[c]->data(), columns[c], count * sizeof(double));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->sequence.load(std::memory_order_relaxed) != begin) {
+            continue;
+        }
+
+        snapshot.sequence = begin;
+        snapshot.day = day;
+        snapshot.state = state;
+        snapshot.tickers.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const char* slot = tickerBuffer.data() + i * SharedMarketFeedLayout::TICKER_WIDTH;
+            snapshot.tickers[i].assign(slot, strnlen(slot, SharedMarketFeedLayout::TICKER_WIDTH));
+        }
+        return true;
+    }
+
+    lastError = "Shared market feed did not settle after " + std::to_string(maxAttempts) + " attempts";
+    return false;
+}
+
+uint64_t SharedMarketFeedReader::getSequence() const {
+    return header ? header->sequence.load(std::memory_order_acquire) : 0;
+}
+
+std::string SharedMarketFeedReader::getLastError() const {
+    return lastError;
+}
+
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../core/Market.hpp"
+
+namespace StockMarketSimulator {
+
+// Layout of the shared segment: this header followed by a fixed-width ticker
+// column and one double column per price field, each sized to `capacity`.
+// `sequence` is a seqlock counter that is odd while the writer is mid-update.
+struct SharedFeedHeader {
+    uint32_t magic;
+    uint32_t layoutVersion;
+    uint32_t capacity;
+    std::atomic<uint32_t> retired;
+    std::atomic<uint64_t> sequence;
+    uint32_t count;
+    int32_t day;
+    double indexValue;
+    double dailyChange;
+    double dailyChangePercent;
+    int32_t currentTrend;
+    int32_t trendDuration;
+    double interestRate;
+    double inflationRate;
+    double unemploymentRate;
+    int32_t writerPid;
+};
+
+enum class SharedFeedColumn {
+    CurrentPrice,
+    OpenPrice,
+    PreviousClose,
+    HighPrice,
+    LowPrice
+};
+
+struct SharedFeedSnapshot {
+    uint64_t sequence = 0;
+    int day = 0;
+    MarketState state{};
+    std::vector<std::string> tickers;
+    std::vector<double> currentPrices;
+    std::vector<double> openPrices;
+    std::vector<double> previousClosePrices;
+    std::vector<double> highPrices;
+    std::vector<double> lowPrices;
+
+    size_t size() const;
+    int indexOf(const std::string& ticker) const;
+};
+
+class SharedMarketFeedLayout {
+public:
+    static constexpr uint32_t MAGIC = 0x534d5046;
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t TICKER_WIDTH = 16;
+    static constexpr size_t COLUMN_COUNT = 5;
+
+    static size_t tickerOffset();
+    static size_t columnOffset(uint32_t capacity, SharedFeedColumn column);
+    static size_t segmentSize(uint32_t capacity);
+};
+
+class SharedMarketFeed {
+private:
+    std::string name;
+    uint32_t capacity;
+    int fd;
+    void* mapping;
+    size_t mappingSize;
+    SharedFeedHeader* header;
+    std::string lastError;
+
+    bool map(uint32_t requestedCapacity);
+    bool claimStaleSegment();
+    void unmap();
+    double* column(SharedFeedColumn column);
+
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 1024;
+
+    explicit SharedMarketFeed(const std::string& name, uint32_t capacity = DEFAULT_CAPACITY);
+    ~SharedMarketFeed();
+
+    SharedMarketFeed(const SharedMarketFeed&) = delete;
+    SharedMarketFeed& operator=(const SharedMarketFeed&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    bool publish(const Market& market);
+
+    const std::string& getName() const;
+    uint32_t getCapacity() const;
+    uint64_t getSequence() const;
+    std::string getLastError() const;
+};
+
+class SharedMarketFeedReader {
+private:
+    std::string name;
+    int fd;
+    void* mapping;
+    size_t mappingSize;
+    const SharedFeedHeader* header;
+    std::vector<char> tickerBuffer;
+    std::string lastError;
+
+    const double* column(SharedFeedColumn column) const;
+
+public:
+    static constexpr int DEFAULT_MAX_ATTEMPTS = 1000;
+
+    explicit SharedMarketFeedReader(const std::string& name);
+    ~SharedMarketFeedReader();
+
+    SharedMarketFeedReader(const SharedMarketFeedReader&) = delete;
+    SharedMarketFeedReader& operator=(const SharedMarketFeedReader&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    bool read(SharedFeedSnapshot& snapshot, int maxAttempts = DEFAULT_MAX_ATTEMPTS);
+    uint64_t getSequence() const;
+    std::string getLastError() const;
+};
+
+}
@@ -1,5 +1,8 @@
 #include "Screen.hpp"
+#include "../utils/EventLoop.hpp"
+#include "../utils/TerminalGeometry.hpp"
 #include <algorithm>
+#include <tuple>
 
 namespace StockMarketSimulator {
 
@@ -8,7 +11,11 @@ Screen::Screen()
       visible(true), active(false),
       titleFg(TextColor::White), titleBg(TextColor::Blue),
       bodyFg(TextColor::Default), bodyBg(TextColor::Default),
-      type(ScreenType::Custom)
+      type(ScreenType::Custom),
+      tickInterval(0),
+      preferredX(0), preferredY(0),
+      preferredWidth(80), preferredHeight(24),
+      layoutColumns(0), layoutRows(0)
 {
 }
 
@@ -17,7 +24,11 @@ Screen::Screen(const std::string& title, ScreenType type)
       visible(true), active(false),
       titleFg(TextColor::White), titleBg(TextColor::Blue),
       bodyFg(TextColor::Default), bodyBg(TextColor::Default),
-      type(type)
+      type(type),
+      tickInterval(0),
+      preferredX(0), preferredY(0),
+      preferredWidth(80), preferredHeight(24),
+      layoutColumns(0), layoutRows(0)
 {
 }
 
@@ -30,8 +41,8 @@ std::string Screen::getTitle() const {
 }
 
 void Screen::setPosition(int x, int y) {
-    this->x = x;
-    this->y = y;
+    this->x = preferredX = x;
+    this->y = preferredY = y;
 }
 
 int Screen::getX() const {
@@ -44,8 +55,8 @@ int Screen::getY() const {
 
 void Screen::setSize(int width, int height) {
     if (width > 0 && height > 0) {
-        this->width = width;
-        this->height = height;
+        this->width = preferredWidth = width;
+        this->height = preferredHeight = height;
     }
 }
 
@@ -103,6 +114,14 @@ ScreenType Screen::getType() const {
     return type;
 }
 
+void Screen::setTickInterval(int milliseconds) {
+    tickInterval = milliseconds > 0 ? milliseconds : 0;
+}
+
+int Screen::getTickInterval() const {
+    return tickInterval;
+}
+
 void Screen::setGame(std::weak_ptr<Game> game) {
     this->game = game;
 }
@@ -161,6 +180,30 @@ void Screen::draw() const {
     Console::resetAttributes();
 }
 
+void Screen::layout() {
+}
+
+// Keeps the screen inside the terminal: it moves up and left only as far as
+// it has to and shrinks only below its requested size, so a larger terminal
+// restores the requested geometry.
+void Screen::fitToTerminal(int columns, int rows) {
+    width = std::max(1, std::min(preferredWidth, columns));
+    height = std::max(1, std::min(preferredHeight, rows));
+    x = std::max(0, std::min(preferredX, columns - width));
+    y = std::max(0, std::min(preferredY, rows - height));
+    layoutColumns = columns;
+    layoutRows = rows;
+
+    layout();
+}
+
+void Screen::onResize(int columns, int rows) {
+    fitToTerminal(columns, rows);
+
+    Console::clear();
+    draw();
+}
+
 bool Screen::handleInput(int key) {
     return false;
 }
@@ -169,26 +212,45 @@ void Screen::run() {
     if (!visible) return;
 
     active = true;
+    if (layoutColumns == 0) {
+        std::tie(layoutColumns, layoutRows) = TerminalGeometry::getSize();
+    }
     draw();
 
-    while (active) {
-        if (Console::keyPressed()) {
-            int key = Console::readChar();
+    EventLoop loop;
+    loop.setTickInterval(tickInterval);
+    loop.setWakeHandler([this]() {
+        if (TerminalGeometry::consumeResize()) {
+            auto [columns, rows] = TerminalGeometry::getSize();
+            onResize(columns, rows);
+        }
+    });
+    loop.run(
+        [this](int key) {
             if (!handleInput(key)) {
-                break;
+                return false;
             }
-            draw();
-        }
-        update();
 
-        Console::sleep(50);
-    }
+            // A screen opened from handleInput() may have consumed a resize
+            // that this one has not laid out for yet.
+            auto [columns, rows] = TerminalGeometry::getSize();
+            if (columns != layoutColumns || rows != layoutRows) {
+                onResize(columns, rows);
+            } else {
+                draw();
+            }
+            update();
+            return active;
+        },
+        [this]() {
+            update();
+            return active;
+        });
 
     active = false;
 }
 
 void Screen::close() {
-    Console::clear();
     active = false;
 }
 
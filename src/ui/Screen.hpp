@@ -31,6 +31,10 @@ protected:
     TextColor titleFg, titleBg;
     TextColor bodyFg, bodyBg;
     ScreenType type;
+    int tickInterval;
+    int preferredX, preferredY;
+    int preferredWidth, preferredHeight;
+    int layoutColumns, layoutRows;
 
     std::weak_ptr<Game> game;
     std::weak_ptr<Market> market;
@@ -39,6 +43,8 @@ protected:
     virtual void drawTitle() const;
     virtual void drawBorder() const;
     virtual void drawContent() const = 0;
+    virtual void layout();
+    void fitToTerminal(int columns, int rows);
 
 public:
     Screen();
@@ -72,6 +78,9 @@ public:
 
     ScreenType getType() const;
 
+    void setTickInterval(int milliseconds);
+    int getTickInterval() const;
+
     void setGame(std::weak_ptr<Game> game);
     void setMarket(std::weak_ptr<Market> market);
     void setPlayer(std::weak_ptr<Player> player);
@@ -80,6 +89,7 @@ public:
     virtual void update();
     virtual void draw() const;
     virtual bool handleInput(int key);
+    virtual void onResize(int columns, int rows);
     virtual void run();
     virtual void close();
 };
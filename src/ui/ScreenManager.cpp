@@ -0,0 +1,86 @@
+#include "ScreenManager.hpp"
+#include <algorithm>
+
+namespace StockMarketSimulator {
+
+void ScreenManager::add(std::shared_ptr<Screen> screen) {
+    if (!screen) {
+        return;
+    }
+
+    screens[screen->getType()] = Entry{screen, false};
+}
+
+std::shared_ptr<Screen> ScreenManager::get(ScreenType type) const {
+    auto it = screens.find(type);
+    return it != screens.end() ? it->second.screen : nullptr;
+}
+
+bool ScreenManager::contains(ScreenType type) const {
+    return screens.find(type) != screens.end();
+}
+
+size_t ScreenManager::size() const {
+    return screens.size();
+}
+
+void ScreenManager::clear() {
+    screens.clear();
+}
+
+bool ScreenManager::show(ScreenType type, const Screen& from) {
+    auto it = screens.find(type);
+    if (it == screens.end()) {
+        return false;
+    }
+
+    Entry& entry = it->second;
+    Screen& screen = *entry.screen;
+
+    if (!entry.initialized) {
+        screen.initialize();
+        entry.initialized = true;
+    } else {
+        screen.update();
+    }
+
+    eraseUncovered(from, screen);
+    screen.run();
+    eraseUncovered(screen, from);
+
+    return true;
+}
+
+void ScreenManager::eraseUncovered(const Screen& from, const Screen& to) {
+    int toLeft = to.getX();
+    int toRight = to.getX() + to.getWidth();
+    int toTop = to.getY();
+    int toBottom = to.getY() + to.getHeight();
+
+    Console::resetAttributes();
+
+    for (int row = from.getY(); row < from.getY() + from.getHeight(); ++row) {
+        int left = from.getX();
+        int right = from.getX() + from.getWidth();
+
+        if (row < toTop || row >= toBottom) {
+            Console::setCursorPosition(left, row);
+            Console::print(std::string(right - left, ' '));
+            continue;
+        }
+
+        if (left < toLeft) {
+            int end = std::min(right, toLeft);
+            Console::setCursorPosition(left, row);
+            Console::print(std::string(end - left, ' '));
+        }
+
+        if (right > toRight) {
+            int start = std::max(left, toRight);
+            Console::setCursorPosition(start, row);
+            Console::print(std::string(right - start, ' '));
+        }
+    }
+}
+
+}
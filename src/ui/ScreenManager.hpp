@@ -0,0 +1,30 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include "Screen.hpp"
+
+namespace StockMarketSimulator {
+
+class ScreenManager {
+private:
+    struct Entry {
+        std::shared_ptr<Screen> screen;
+        bool initialized;
+    };
+
+    std::map<ScreenType, Entry> screens;
+
+public:
+    void add(std::shared_ptr<Screen> screen);
+    std::shared_ptr<Screen> get(ScreenType type) const;
+    bool contains(ScreenType type) const;
+    size_t size() const;
+    void clear();
+
+    bool show(ScreenType type, const Screen& from);
+
+    static void eraseUncovered(const Screen& from, const Screen& to);
+};
+
+}
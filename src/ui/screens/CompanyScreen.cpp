@@ -35,11 +35,16 @@ void CompanyScreen::setNewsService(std::weak_ptr<NewsService> newsService) {
     this->newsService = newsService;
 }
 
+void CompanyScreen::layout() {
+    priceChart.setPosition(x + 2, y + 8);
+    priceChart.setSize(width - 4, 10);
+}
+
 void CompanyScreen::initialize() {
     Screen::initialize();
 
-    priceChart.setPosition(x + 2, y + 8);
-    priceChart.setSize(width - 4, 10);
+    layout();
+
     priceChart.setTitle("Price Chart");
     priceChart.setColor(TextColor::Green);
 
@@ -248,7 +253,7 @@ void CompanyScreen::drawLatestNews() const {
         return;
     }
 
-    const std::vector<News>& allNews = newsServicePtr->getNewsHistory();
+    const auto& allNews = newsServicePtr->getNewsHistory();
     std::vector<News> companyNews;
 
     for (const auto& news : allNews) {
@@ -260,10 +265,16 @@ void CompanyScreen::drawLatestNews() const {
                 continue;
             }
 
-            if (news.getTitle().find(company->getName()) != std::string::npos ||
-                news.getTitle().find(company->getTicker()) != std::string::npos ||
-                news.getContent().find(company->getName()) != std::string::npos ||
-                news.getContent().find(company->getTicker()) != std::string::npos) {
+            if (news.isTemplated()) {
+                continue;
+            }
+
+            std::string title = newsServicePtr->getNewsTitle(news);
+            std::string content = newsServicePtr->getNewsContent(news);
+            if (title.find(company->getName()) != std::string::npos ||
+                title.find(company->getTicker()) != std::string::npos ||
+                content.find(company->getName()) != std::string::npos ||
+                content.find(company->getTicker()) != std::string::npos) {
                 companyNews.push_back(news);
             }
         }
@@ -295,7 +306,7 @@ void CompanyScreen::drawLatestNews() const {
         Console::setColor(TextColor::Cyan, bodyBg);
         Console::print(news.getPublishDate().toString() + ": ");
         Console::setColor(bodyFg, bodyBg);
-        Console::print(news.getTitle());
+        Console::print(newsServicePtr->getNewsTitle(news));
     }
 
     Console::setCursorPosition(x, y + 23);
@@ -28,6 +28,7 @@ namespace StockMarketSimulator {
 
     protected:
         virtual void drawContent() const override;
+        void layout() override;
 
     public:
         CompanyScreen();
@@ -11,15 +11,23 @@ const int MAX_LOANS = 4;
 FinancialScreen::FinancialScreen()
     : Screen("FINANCIAL INSTRUMENTS", ScreenType::Financial),
       currentSection(FinancialSection::Loans),
-      selectedLoanIndex(-1)
+      selectedLoanIndex(-1),
+      renderedLoansVersion(0),
+      renderedPortfolioVersion(0)
 {
     setSize(52, 30);
 }
 
+void FinancialScreen::layout() {
+    loansTable.setPosition(x, y + 7);
+    marginTable.setPosition(x + 2, y + 11);
+}
+
 void FinancialScreen::initialize() {
     Screen::initialize();
 
-    loansTable.setPosition(x, y + 7);
+    layout();
+
     std::vector<std::string> loanHeaders = {"Loan #", "Amount", "Interest", "Due In", "Total Due"};
     loansTable.setHeaders(loanHeaders);
     std::vector<int> loanColumnWidths = {7, 10, 9, 10, 10};
@@ -27,7 +35,6 @@ void FinancialScreen::initialize() {
     loansTable.setHeaderColors(TextColor::White, TextColor::Blue);
     loansTable.setBodyColors(bodyFg, bodyBg);
 
-    marginTable.setPosition(x + 2, y + 11);
     std::vector<std::string> marginHeaders = {"Amount", "Available", "Rate"};
     marginTable.setHeaders(marginHeaders);
     std::vector<int> marginColumnWidths = {12, 12, 8};
@@ -40,6 +47,23 @@ void FinancialScreen::initialize() {
 
 void FinancialScreen::update() {
     Screen::update();
+
+    auto playerPtr = player.lock();
+    if (!playerPtr) {
+        return;
+    }
+
+    // Days remaining depend on the date, which moves without touching the loans.
+    uint64_t portfolioVersion = playerPtr->getPortfolio()->getVersion();
+    Date currentDate = playerPtr->getCurrentDate();
+    if (playerPtr->getLoansVersion() == renderedLoansVersion && portfolioVersion == renderedPortfolioVersion &&
+        currentDate == renderedDate) {
+        return;
+    }
+    renderedLoansVersion = playerPtr->getLoansVersion();
+    renderedPortfolioVersion = portfolioVersion;
+    renderedDate = currentDate;
+
     updateLoansTable();
     updateMarginTable();
 }
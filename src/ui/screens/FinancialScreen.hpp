@@ -20,6 +20,9 @@ namespace StockMarketSimulator {
         Table loansTable;
         Table marginTable;
         int selectedLoanIndex;
+        uint64_t renderedLoansVersion;
+        uint64_t renderedPortfolioVersion;
+        Date renderedDate;
 
         void updateLoansTable();
         void updateMarginTable();
@@ -40,6 +43,7 @@ namespace StockMarketSimulator {
 
     protected:
         virtual void drawContent() const override;
+        void layout() override;
 
     public:
         FinancialScreen();
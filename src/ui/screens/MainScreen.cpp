@@ -11,13 +11,16 @@ namespace StockMarketSimulator {
 
 MainScreen::MainScreen()
     : Screen("STOCK PLAYER - MAIN MENU", ScreenType::Main),
-      game(nullptr)
+      game(nullptr),
+      renderedMarketVersion(0),
+      renderedNewsVersion(0)
 {
-    setSize(48, 33);
+    setSize(48, 34);
 }
 
 void MainScreen::setGame(std::shared_ptr<Game> game) {
     this->game = game;
+    screens.clear();
 
     if (game) {
         setMarket(game->getMarket());
@@ -120,6 +123,11 @@ void MainScreen::updateTopStocks() {
         return;
     }
 
+    if (marketPtr->getVersion() == renderedMarketVersion) {
+        return;
+    }
+    renderedMarketVersion = marketPtr->getVersion();
+
     topStocks = companies;
     std::sort(topStocks.begin(), topStocks.end(),
               [](const auto& a, const auto& b) {
@@ -140,6 +148,11 @@ void MainScreen::updateLatestNews() {
         return;
     }
 
+    if (newsServicePtr->getVersion() == renderedNewsVersion) {
+        return;
+    }
+    renderedNewsVersion = newsServicePtr->getVersion();
+
     latestNews = newsServicePtr->getLatestNews(2);
 }
 
@@ -336,11 +349,13 @@ void MainScreen::drawLatestNews() const {
         return;
     }
 
+    auto newsServicePtr = newsService.lock();
+
     for (const auto& news : latestNews) {
         newsY += 1;
         Console::setCursorPosition(x + 2, newsY);
         Console::setColor(TextColor::Cyan, bodyBg);
-        Console::print("- " + news.getTitle());
+        Console::print("- " + (newsServicePtr ? newsServicePtr->getNewsTitle(news) : news.getTitle()));
     }
 
     int separatorY = newsY + 2;
@@ -377,6 +392,10 @@ void MainScreen::drawNavigationMenu() const {
     Console::print("5. Save Game");
     menuY += 1;
 
+    Console::setCursorPosition(x + 2, menuY);
+    Console::print("8. Rewind to Earlier Day");
+    menuY += 1;
+
     Console::setCursorPosition(x + 2, menuY);
     Console::print("9. Advance to Next Day");
     menuY += 1;
@@ -392,25 +411,29 @@ void MainScreen::drawNavigationMenu() const {
 bool MainScreen::handleInput(int key) {
     switch (key) {
         case '1':
-            openMarketScreen();
+            openScreen(ScreenType::Market);
             return true;
 
         case '2':
-            openPortfolioScreen();
+            openScreen(ScreenType::Portfolio);
             return true;
 
         case '3':
-            openNewsScreen();
+            openScreen(ScreenType::News);
             return true;
 
         case '4':
-            openFinancialScreen();
+            openScreen(ScreenType::Financial);
             return true;
 
         case '5':
             saveGame();
             return true;
 
+        case '8':
+            rewindGame();
+            return true;
+
         case '9':
             advanceDay();
             return true;
@@ -425,58 +448,46 @@ bool MainScreen::handleInput(int key) {
     }
 }
 
-void MainScreen::openMarketScreen() const {
-    auto marketScreen = std::make_shared<MarketScreen>();
-    marketScreen->setMarket(market);
-    marketScreen->setPlayer(player);
-    marketScreen->setNewsService(newsService);
-    Console::clear();
-    marketScreen->setPosition(x, y);
-
-    marketScreen->initialize();
-    marketScreen->run();
-    Console::clear();
-    draw();
-}
-
-void MainScreen::openPortfolioScreen() const {
-    auto portfolioScreen = std::make_shared<PortfolioScreen>();
-    portfolioScreen->setMarket(market);
-    portfolioScreen->setPlayer(player);
-    Console::clear();
-    portfolioScreen->setPosition(x, y);
-
-    portfolioScreen->initialize();
-    portfolioScreen->run();
-    Console::clear();
-    draw();
-}
+std::shared_ptr<Screen> MainScreen::createScreen(ScreenType type) const {
+    std::shared_ptr<Screen> screen;
 
-void MainScreen::openNewsScreen() const {
-    auto newsScreen = std::make_shared<NewsScreen>();
-    newsScreen->setMarket(market);
-    newsScreen->setPlayer(player);
-    newsScreen->setNewsService(newsService);
-    Console::clear();
-    newsScreen->setPosition(x, y);
+    switch (type) {
+        case ScreenType::Market: {
+            auto marketScreen = std::make_shared<MarketScreen>();
+            marketScreen->setNewsService(newsService);
+            screen = marketScreen;
+            break;
+        }
+        case ScreenType::Portfolio:
+            screen = std::make_shared<PortfolioScreen>();
+            break;
+        case ScreenType::News: {
+            auto newsScreen = std::make_shared<NewsScreen>();
+            newsScreen->setNewsService(newsService);
+            screen = newsScreen;
+            break;
+        }
+        case ScreenType::Financial:
+            screen = std::make_shared<FinancialScreen>();
+            break;
+        default:
+            return nullptr;
+    }
 
-    newsScreen->initialize();
-    newsScreen->run();
-    Console::clear();
-    draw();
+    screen->setMarket(market);
+    screen->setPlayer(player);
+    screen->setPosition(x, y);
+    return screen;
 }
 
-void MainScreen::openFinancialScreen() const {
-    auto financialScreen = std::make_shared<FinancialScreen>();
-    financialScreen->setMarket(market);
-    financialScreen->setPlayer(player);
-    Console::clear();
-    financialScreen->setPosition(x, y);
+void MainScreen::openScreen(ScreenType type) {
+    if (!screens.contains(type)) {
+        screens.add(createScreen(type));
+    }
 
-    financialScreen->initialize();
-    financialScreen->run();
-    Console::clear();
-    draw();
+    if (screens.show(type, *this)) {
+        draw();
+    }
 }
 
 void MainScreen::saveGame() const {
@@ -554,4 +565,59 @@ void MainScreen::advanceDay() {
     Console::sleep(1500);
 }
 
+void MainScreen::rewindGame() {
+    if (!game) {
+        Console::setCursorPosition(x + 2, y + 31);
+        Console::setColor(TextColor::Red, bodyBg);
+        Console::print("Error: Game not initialized!");
+        Console::sleep(1500);
+        return;
+    }
+
+    auto checkpoints = game->getCheckpointStore();
+    if (!checkpoints || checkpoints->getCheckpointCount() == 0) {
+        Console::setCursorPosition(x + 2, y + 31);
+        Console::setColor(TextColor::Yellow, bodyBg);
+        Console::print("No recorded days to rewind to.");
+        Console::sleep(1500);
+        return;
+    }
+
+    Console::setCursorPosition(x + 2, y + 31);
+    Console::setColor(bodyFg, bodyBg);
+    Console::print("Rewind to day (" + std::to_string(checkpoints->getEarliestDay()) + "-" +
+                   std::to_string(checkpoints->getLatestDay()) + ", 0 to cancel): ");
+    Console::setColor(TextColor::Yellow, bodyBg);
+
+    std::string input = Console::readLine();
+    int day = 0;
+
+    try {
+        day = std::stoi(input);
+    } catch (...) {
+        day = 0;
+    }
+
+    if (day == 0) {
+        Console::clear();
+        return;
+    }
+
+    Console::setCursorPosition(x + 2, y + 32);
+    if (game->rewindTo(day)) {
+        // The market's companies were replaced, so cached sub-screens are rebuilt.
+        setGame(game);
+        update();
+
+        Console::setColor(TextColor::Green, bodyBg);
+        Console::print("Rewound to day " + std::to_string(day) + "!");
+    } else {
+        Console::setColor(TextColor::Red, bodyBg);
+        Console::print("Error rewinding: " + game->getLastError());
+    }
+
+    Console::sleep(1500);
+    Console::clear();
+}
+
 }
\ No newline at end of file
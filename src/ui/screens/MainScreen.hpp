@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Screen.hpp"
+#include "../ScreenManager.hpp"
 #include "../../models/Company.hpp"
 #include "../../core/Game.hpp"
 #include "../../services/NewsService.hpp"
@@ -19,6 +20,9 @@ namespace StockMarketSimulator {
         std::weak_ptr<NewsService> newsService;
         std::vector<std::shared_ptr<Company>> topStocks;
         std::vector<News> latestNews;
+        ScreenManager screens;
+        uint64_t renderedMarketVersion;
+        uint64_t renderedNewsVersion;
 
         void drawDateAndMarket() const;
         void drawPlayerInfo() const;
@@ -31,12 +35,11 @@ namespace StockMarketSimulator {
         void checkGameOverConditions();
         void gameOver(const std::string& message);
 
-        void openMarketScreen() const;
-        void openPortfolioScreen() const;
-        void openNewsScreen() const;
-        void openFinancialScreen() const;
+        std::shared_ptr<Screen> createScreen(ScreenType type) const;
+        void openScreen(ScreenType type);
         void saveGame() const;
         void advanceDay();
+        void rewindGame();
 
     protected:
         virtual void drawContent() const override;
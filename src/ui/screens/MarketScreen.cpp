@@ -9,15 +9,20 @@ namespace StockMarketSimulator {
 MarketScreen::MarketScreen()
     : Screen("Market", ScreenType::Market),
       sortCriteria(MarketSortCriteria::PriceChangePercent),
-      sortAscending(false)
+      sortAscending(false),
+      renderedMarketVersion(0)
 {
     setSize(47, 31);
 }
 
+void MarketScreen::layout() {
+    companiesTable.setPosition(x, y + 3);
+}
+
 void MarketScreen::initialize() {
     Screen::initialize();
 
-    companiesTable.setPosition(x, y + 3);
+    layout();
 
     std::vector<std::string> headers = {"Company", "Price", "Change", "Sector"};
     companiesTable.setHeaders(headers);
@@ -33,6 +38,12 @@ void MarketScreen::initialize() {
 
 void MarketScreen::update() {
     Screen::update();
+
+    auto marketPtr = market.lock();
+    if (marketPtr && marketPtr->getVersion() == renderedMarketVersion) {
+        return;
+    }
+
     updateDisplayedCompanies();
 }
 
@@ -44,6 +55,7 @@ void MarketScreen::updateDisplayedCompanies() {
     }
 
     displayedCompanies = marketPtr->getCompanies();
+    renderedMarketVersion = marketPtr->getVersion();
 
     sortCompanies();
     updateTableData();
@@ -25,6 +25,7 @@ namespace StockMarketSimulator {
         MarketSortCriteria sortCriteria;
         bool sortAscending;
         std::weak_ptr<NewsService> newsService;
+        uint64_t renderedMarketVersion;
 
         void updateDisplayedCompanies();
         void updateTableData();
@@ -35,6 +36,7 @@ namespace StockMarketSimulator {
 
     protected:
         virtual void drawContent() const override;
+        void layout() override;
 
     public:
         MarketScreen();
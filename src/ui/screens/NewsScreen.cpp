@@ -10,7 +10,8 @@ NewsScreen::NewsScreen()
     : Screen("NEWS", ScreenType::News),
       currentFilter(NewsFilter::All),
       currentPage(0),
-      newsPerPage(6)
+      newsPerPage(6),
+      renderedNewsVersion(0)
 {
     setSize(46, 31);
 
@@ -27,6 +28,12 @@ void NewsScreen::initialize() {
 
 void NewsScreen::update() {
     Screen::update();
+
+    auto newsServicePtr = newsService.lock();
+    if (newsServicePtr && newsServicePtr->getVersion() == renderedNewsVersion) {
+        return;
+    }
+
     updateDisplayedNews();
 }
 
@@ -37,7 +44,8 @@ void NewsScreen::update() {
         return;
     }
 
-    const std::vector<News>& allNews = newsServicePtr->getNewsHistory();
+    const auto& allNews = newsServicePtr->getNewsHistory();
+    renderedNewsVersion = newsServicePtr->getVersion();
 
     std::vector<News> filteredNews;
 
@@ -65,9 +73,9 @@ void NewsScreen::update() {
     }
 
     std::sort(filteredNews.begin(), filteredNews.end(),
-             [](const News& a, const News& b) {
+             [&newsServicePtr](const News& a, const News& b) {
                  if (a.getPublishDate() == b.getPublishDate()) {
-                     return a.getTitle() > b.getTitle();
+                     return newsServicePtr->getNewsTitle(a) > newsServicePtr->getNewsTitle(b);
                  }
                  return a.getPublishDate() > b.getPublishDate();
              });
@@ -123,6 +131,7 @@ void NewsScreen::drawFilterInfo() const {
 
 void NewsScreen::drawNewsList() const {
     int newsY = y + 4;
+    auto newsServicePtr = newsService.lock();
 
     if (displayedNews.empty()) {
         Console::setCursorPosition(x + 2, newsY + 2);
@@ -170,7 +179,7 @@ void NewsScreen::drawNewsList() const {
 
         Console::setCursorPosition(x + 2, newsY + 1);
         Console::setColor(bodyFg, bodyBg);
-        Console::print(news.getTitle());
+        Console::print(newsServicePtr ? newsServicePtr->getNewsTitle(news) : news.getTitle());
 
         Console::setCursorPosition(x + 2, newsY + 2);
         Console::print(std::string(width - 4, ' '));
@@ -300,13 +309,15 @@ void NewsScreen::displayNewsDetails(const News& news) {
 
     Console::setCursorPosition(x + 2, contentY);
     Console::setColor(TextColor::White, bodyBg);
+    auto newsServicePtr = newsService.lock();
+
     Console::setStyle(TextStyle::Bold);
-    Console::print(news.getTitle());
+    Console::print(newsServicePtr ? newsServicePtr->getNewsTitle(news) : news.getTitle());
     Console::setStyle(TextStyle::Regular);
     contentY += 2;
 
     Console::setColor(bodyFg, bodyBg);
-    std::string content = news.getContent();
+    std::string content = newsServicePtr ? newsServicePtr->getNewsContent(news) : news.getContent();
 
     if (content.empty()) {
         content = "No detailed content available.";
@@ -511,7 +522,7 @@ int NewsScreen::getTotalPages() const {
         return 1;
     }
 
-    const std::vector<News>& allNews = newsServicePtr->getNewsHistory();
+    const auto& allNews = newsServicePtr->getNewsHistory();
 
     int filteredCount = 0;
     for (const auto& news : allNews) {
@@ -24,6 +24,7 @@ private:
     int currentPage;
     int newsPerPage;
     std::vector<News> displayedNews;
+    uint64_t renderedNewsVersion;
 
     void updateDisplayedNews();
     void displayNewsDetails(const News& news);
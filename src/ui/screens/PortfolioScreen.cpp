@@ -12,14 +12,23 @@ PortfolioScreen::PortfolioScreen()
     : Screen("MY PORTFOLIO", ScreenType::Portfolio),
       currentPage(0),
       itemsPerPage(3),
-      totalPages(1) {
+      totalPages(1),
+      renderedPortfolioVersion(0),
+      renderedMarketVersion(0) {
     setSize(50, 38);
 }
 
+void PortfolioScreen::layout() {
+    portfolioTable.setPosition(x, y + 8);
+    valueChart.setPosition(x + 2, y + 25);
+    valueChart.setSize(width - 4, 6);
+}
+
 void PortfolioScreen::initialize() {
     Screen::initialize();
 
-    portfolioTable.setPosition(x, y + 8);
+    layout();
+
     std::vector<std::string> headers = {"Stock", "Qty", "Avg.Price", "Cur.Price", "P/L"};
     portfolioTable.setHeaders(headers);
     std::vector<int> columnWidths = {11, 6, 9, 10, 8};
@@ -27,8 +36,6 @@ void PortfolioScreen::initialize() {
     portfolioTable.setHeaderColors(TextColor::White, TextColor::Blue);
     portfolioTable.setBodyColors(bodyFg, bodyBg);
 
-    valueChart.setPosition(x + 2, y + 25);
-    valueChart.setSize(width - 4, 6);
     valueChart.setTitle("");
     valueChart.setColor(TextColor::Green);
 
@@ -49,6 +56,14 @@ void PortfolioScreen::update() {
         return;
     }
 
+    auto marketPtr = market.lock();
+    uint64_t marketVersion = marketPtr ? marketPtr->getVersion() : 0;
+    if (portfolio->getVersion() == renderedPortfolioVersion && marketVersion == renderedMarketVersion) {
+        return;
+    }
+    renderedPortfolioVersion = portfolio->getVersion();
+    renderedMarketVersion = marketVersion;
+
     int totalPositions = static_cast<int>(portfolio->getPositions().size());
     totalPages = std::max(1, (totalPositions + itemsPerPage - 1) / itemsPerPage);
 
@@ -74,7 +89,6 @@ void PortfolioScreen::update() {
     valueChart.setData(displayData);
 
     std::vector<std::string> labels;
-    auto marketPtr = market.lock();
 
     if (marketPtr && numPoints > 0) {
         Date currentDate = marketPtr->getCurrentDate();
@@ -278,7 +292,7 @@ void PortfolioScreen::drawSectorDistribution() const {
     Console::print("Sector Distribution:");
     Console::setStyle(TextStyle::Regular);
 
-    std::map<Sector, double> allocation = portfolio->getSectorAllocation();
+    std::array<double, SECTOR_COUNT> allocation = portfolio->getSectorValues();
     double totalStocksValue = portfolio->getTotalStocksValue();
 
     if (totalStocksValue <= 0.0) {
@@ -289,7 +303,9 @@ void PortfolioScreen::drawSectorDistribution() const {
     }
 
     int currentY = y + 20;
-    for (const auto& [sector, value] : allocation) {
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        Sector sector = static_cast<Sector>(i);
+        double value = allocation[i];
         if (value > 0) {
             Console::setCursorPosition(x + 4, currentY);
             Console::setColor(bodyFg, bodyBg);
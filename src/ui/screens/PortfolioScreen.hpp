@@ -17,6 +17,8 @@ private:
     int currentPage;
     int itemsPerPage;
     int totalPages;
+    uint64_t renderedPortfolioVersion;
+    uint64_t renderedMarketVersion;
 
     void drawPortfolioInfo() const;
     void drawPortfolioTable() const;
@@ -33,6 +35,7 @@ private:
 
 protected:
     virtual void drawContent() const override;
+    void layout() override;
 
 public:
     PortfolioScreen();
@@ -0,0 +1,345 @@
+#include "AllocationTracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <sstream>
+
+namespace StockMarketSimulator {
+
+struct TagCounters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> deallocations;
+    std::atomic<uint64_t> bytesAllocated;
+    std::atomic<uint64_t> currentBytes;
+    std::atomic<uint64_t> peakBytes;
+};
+
+static TagCounters tagCounters[AllocationTracker::MAX_TAGS];
+static std::atomic<const char*> tagNames[AllocationTracker::MAX_TAGS];
+static std::atomic<size_t> tagCount{1};
+static std::mutex registrationMutex;
+static thread_local size_t currentTag = AllocationTracker::UNTAGGED;
+
+nlohmann::json AllocationStats::toJson() const {
+    nlohmann::json j;
+    j["allocations"] = allocations;
+    j["deallocations"] = deallocations;
+    j["bytes_allocated"] = bytesAllocated;
+    j["current_bytes"] = currentBytes;
+    j["peak_bytes"] = peakBytes;
+    return j;
+}
+
+bool AllocationTracker::isEnabled() {
+#ifdef SMP_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t AllocationTracker::registerTag(const char* name) {
+    std::lock_guard<std::mutex> lock(registrationMutex);
+
+    size_t count = tagCount.load();
+    for (size_t i = 1; i < count; ++i) {
+        if (std::strcmp(tagNames[i].load(), name) == 0) {
+            return i;
+        }
+    }
+
+    if (count >= MAX_TAGS) {
+        return UNTAGGED;
+    }
+
+    tagNames[count] = name;
+    tagCount = count + 1;
+    return count;
+}
+
+size_t AllocationTracker::getCurrentTag() {
+    return currentTag;
+}
+
+size_t AllocationTracker::setCurrentTag(size_t tag) {
+    size_t previous = currentTag;
+    currentTag = (tag < MAX_TAGS) ? tag : UNTAGGED;
+    return previous;
+}
+
+void AllocationTracker::recordAllocation(size_t tag, size_t bytes) {
+    TagCounters& counters = tagCounters[tag];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+
+    uint64_t current = counters.currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void AllocationTracker::recordDeallocation(size_t tag, size_t bytes) {
+    TagCounters& counters = tagCounters[tag];
+    counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    counters.currentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+std::vector<AllocationStats> AllocationTracker::snapshot() {
+    std::vector<AllocationStats> stats;
+    size_t count = tagCount.load();
+
+    for (size_t i = 0; i < count; ++i) {
+        const TagCounters& counters = tagCounters[i];
+        if (counters.allocations.load() == 0 && counters.deallocations.load() == 0) {
+            continue;
+        }
+
+        stats.push_back({i == UNTAGGED ? "untagged" : tagNames[i].load(),
+                         counters.allocations.load(),
+                         counters.deallocations.load(),
+                         counters.bytesAllocated.load(),
+                         counters.currentBytes.load(),
+                         counters.peakBytes.load()});
+    }
+
+    return stats;
+}
+
+AllocationStats AllocationTracker::getTotals() {
+    AllocationStats totals{"total", 0, 0, 0, 0, 0};
+
+    for (const auto& stats : snapshot()) {
+        totals.allocations += stats.allocations;
+        totals.deallocations += stats.deallocations;
+        totals.bytesAllocated += stats.bytesAllocated;
+        totals.currentBytes += stats.currentBytes;
+        totals.peakBytes = std::max(totals.peakBytes, stats.peakBytes);
+    }
+
+    return totals;
+}
+
+void AllocationTracker::reset() {
+    for (auto& counters : tagCounters) {
+        counters.allocations = 0;
+        counters.deallocations = 0;
+        counters.bytesAllocated = 0;
+        counters.peakBytes = counters.currentBytes.load();
+    }
+}
+
+std::string AllocationTracker::report() {
+    auto stats = snapshot();
+
+    std::stringstream ss;
+    ss << std::left << std::setw(28) << "Scope"
+       << std::right << std::setw(12) << "Allocs"
+       << std::setw(12) << "Frees"
+       << std::setw(16) << "Bytes"
+       << std::setw(14) << "Live"
+       << std::setw(14) << "Peak" << "\n";
+
+    for (const auto& entry : stats) {
+        ss << std::left << std::setw(28) << entry.tag
+           << std::right << std::setw(12) << entry.allocations
+           << std::setw(12) << entry.deallocations
+           << std::setw(16) << entry.bytesAllocated
+           << std::setw(14) << static_cast<int64_t>(entry.currentBytes)
+           << std::setw(14) << entry.peakBytes << "\n";
+    }
+
+    return ss.str();
+}
+
+nlohmann::json AllocationTracker::toJson() {
+    nlohmann::json j = nlohmann::json::object();
+
+    for (const auto& entry : snapshot()) {
+        j[entry.tag] = entry.toJson();
+    }
+
+    return j;
+}
+
+AllocationScope::AllocationScope(size_t tag)
+    : previousTag(AllocationTracker::setCurrentTag(tag))
+{
+}
+
+AllocationScope::~AllocationScope() {
+    AllocationTracker::setCurrentTag(previousTag);
+}
+
+}
+
+#ifdef SMP_ALLOCATION_TRACKING
+
+namespace {
+
+struct alignas(16) AllocationHeader {
+    size_t bytes;
+    size_t tag;
+};
+
+void* trackedAllocate(size_t bytes) {
+    using StockMarketSimulator::AllocationTracker;
+
+    void* block = std::malloc(sizeof(AllocationHeader) + bytes);
+    if (!block) {
+        return nullptr;
+    }
+
+    auto* header = static_cast<AllocationHeader*>(block);
+    header->bytes = bytes;
+    header->tag = AllocationTracker::getCurrentTag();
+    AllocationTracker::recordAllocation(header->tag, bytes);
+
+    return header + 1;
+}
+
+void trackedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+
+    auto* header = static_cast<AllocationHeader*>(pointer) - 1;
+    StockMarketSimulator::AllocationTracker::recordDeallocation(header->tag, header->bytes);
+    std::free(header);
+}
+
+// Over-aligned blocks keep the start of the malloc block in their header,
+// which sits right before the aligned pointer handed out.
+struct AlignedAllocationHeader {
+    void* block;
+    size_t bytes;
+    size_t tag;
+};
+
+void* trackedAllocateAligned(size_t bytes, std::align_val_t alignment) {
+    using StockMarketSimulator::AllocationTracker;
+
+    size_t align = std::max(static_cast<size_t>(alignment), alignof(AlignedAllocationHeader));
+    void* block = std::malloc(sizeof(AlignedAllocationHeader) + align - 1 + bytes);
+    if (!block) {
+        return nullptr;
+    }
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(block) + sizeof(AlignedAllocationHeader);
+    uintptr_t aligned = (start + align - 1) & ~static_cast<uintptr_t>(align - 1);
+
+    auto* header = reinterpret_cast<AlignedAllocationHeader*>(aligned) - 1;
+    header->block = block;
+    header->bytes = bytes;
+    header->tag = AllocationTracker::getCurrentTag();
+    AllocationTracker::recordAllocation(header->tag, bytes);
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+void trackedFreeAligned(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+
+    auto* header = static_cast<AlignedAllocationHeader*>(pointer) - 1;
+    StockMarketSimulator::AllocationTracker::recordDeallocation(header->tag, header->bytes);
+    std::free(header->block);
+}
+
+}
+
+void* operator new(size_t bytes) {
+    void* pointer = trackedAllocate(bytes);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t bytes) {
+    return operator new(bytes);
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept {
+    return trackedAllocate(bytes);
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept {
+    return trackedAllocate(bytes);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+void* operator new(size_t bytes, std::align_val_t alignment) {
+    void* pointer = trackedAllocateAligned(bytes, alignment);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t bytes, std::align_val_t alignment) {
+    return operator new(bytes, alignment);
+}
+
+void* operator new(size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocateAligned(bytes, alignment);
+}
+
+void* operator new[](size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocateAligned(bytes, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    trackedFreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    trackedFreeAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    trackedFreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+    trackedFreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    trackedFreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    trackedFreeAligned(pointer);
+}
+
+#endif
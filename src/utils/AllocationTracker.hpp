@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace StockMarketSimulator {
+
+struct AllocationStats {
+    std::string tag;
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t bytesAllocated;
+    uint64_t currentBytes;
+    uint64_t peakBytes;
+
+    nlohmann::json toJson() const;
+};
+
+class AllocationTracker {
+public:
+    static constexpr size_t MAX_TAGS = 64;
+    static constexpr size_t UNTAGGED = 0;
+
+    static bool isEnabled();
+
+    static size_t registerTag(const char* name);
+    static size_t getCurrentTag();
+    static size_t setCurrentTag(size_t tag);
+
+    static void recordAllocation(size_t tag, size_t bytes);
+    static void recordDeallocation(size_t tag, size_t bytes);
+
+    static std::vector<AllocationStats> snapshot();
+    static AllocationStats getTotals();
+    static void reset();
+
+    static std::string report();
+    static nlohmann::json toJson();
+};
+
+class AllocationScope {
+private:
+    size_t previousTag;
+
+public:
+    explicit AllocationScope(size_t tag);
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+}
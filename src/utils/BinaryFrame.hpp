@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace StockMarketSimulator {
+
+// Frames are a little-endian uint32 payload length, a one byte message type and
+// the payload. Strings are length-prefixed, doubles are IEEE-754 bit patterns.
+class FrameWriter {
+private:
+    std::string& out;
+    size_t headerOffset;
+
+public:
+    static constexpr size_t HEADER_SIZE = 5;
+
+    FrameWriter(std::string& out, uint8_t type)
+        : out(out), headerOffset(out.size())
+    {
+        out.append(HEADER_SIZE, '\0');
+        out[headerOffset + 4] = static_cast<char>(type);
+    }
+
+    ~FrameWriter() {
+        uint32_t length = static_cast<uint32_t>(out.size() - headerOffset - HEADER_SIZE);
+        for (int i = 0; i < 4; ++i) {
+            out[headerOffset + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+        }
+    }
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    void putUnsigned(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void putInt32(int32_t value) {
+        putUnsigned(static_cast<uint32_t>(value), 4);
+    }
+
+    void putDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putUnsigned(bits, 8);
+    }
+
+    void putString(const std::string& value, int lengthBytes) {
+        size_t limit = (lengthBytes == 1) ? 0xFF : 0xFFFF;
+        size_t length = std::min(value.size(), limit);
+        putUnsigned(length, lengthBytes);
+        out.append(value, 0, length);
+    }
+
+    // Reads the header at the front of buffer. Returns false until the whole
+    // frame has arrived; throws std::runtime_error when it exceeds maxPayload.
+    static bool peek(const std::string& buffer, uint32_t maxPayload, uint8_t& type, uint32_t& length) {
+        if (buffer.size() < HEADER_SIZE) {
+            return false;
+        }
+
+        length = 0;
+        for (int i = 0; i < 4; ++i) {
+            length |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+        }
+
+        if (length > maxPayload) {
+            throw std::runtime_error("Frame exceeds maximum size");
+        }
+
+        type = static_cast<uint8_t>(buffer[4]);
+        return buffer.size() >= HEADER_SIZE + length;
+    }
+};
+
+class FrameReader {
+private:
+    const std::string& data;
+    size_t position;
+    size_t end;
+
+    void require(size_t bytes) const {
+        if (position + bytes > end) {
+            throw std::runtime_error("Truncated frame");
+        }
+    }
+
+public:
+    FrameReader(const std::string& data, size_t begin, size_t end)
+        : data(data), position(begin), end(end)
+    {
+    }
+
+    uint64_t getUnsigned(int bytes) {
+        require(bytes);
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data[position++])) << (8 * i);
+        }
+        return value;
+    }
+
+    int32_t getInt32() {
+        return static_cast<int32_t>(static_cast<uint32_t>(getUnsigned(4)));
+    }
+
+    double getDouble() {
+        uint64_t bits = getUnsigned(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string getString(int lengthBytes) {
+        size_t length = getUnsigned(lengthBytes);
+        require(length);
+        std::string value = data.substr(position, length);
+        position += length;
+        return value;
+    }
+};
+
+}
@@ -0,0 +1,34 @@
+#include "ChangeVersion.hpp"
+#include <atomic>
+
+namespace StockMarketSimulator {
+
+uint64_t ChangeVersion::next() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+ChangeVersion::ChangeVersion()
+    : value(next())
+{
+}
+
+ChangeVersion::ChangeVersion(const ChangeVersion&)
+    : value(next())
+{
+}
+
+ChangeVersion& ChangeVersion::operator=(const ChangeVersion&) {
+    value = next();
+    return *this;
+}
+
+void ChangeVersion::bump() {
+    value = next();
+}
+
+uint64_t ChangeVersion::get() const {
+    return value;
+}
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace StockMarketSimulator {
+
+// Values come from one process-wide counter, so a copied, moved or reloaded
+// object never reports a version an observer has already seen.
+class ChangeVersion {
+private:
+    uint64_t value;
+
+    static uint64_t next();
+
+public:
+    ChangeVersion();
+    ChangeVersion(const ChangeVersion& other);
+    ChangeVersion& operator=(const ChangeVersion& other);
+
+    void bump();
+    uint64_t get() const;
+};
+
+}
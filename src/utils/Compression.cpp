@@ -0,0 +1,593 @@
+#include "Compression.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+const size_t MIN_MATCH = 4;
+const size_t MAX_OFFSET = 0xFFFF;
+const int HASH_BITS = 14;
+const uint32_t NO_POSITION = 0xFFFFFFFF;
+const uint64_t MAX_BLOCK_SIZE = 256ull * 1024 * 1024;
+
+const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int countLeadingZeros(uint64_t value) {
+    int count = 0;
+    for (uint64_t mask = 1ull << 63; mask != 0 && (value & mask) == 0; mask >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+int countTrailingZeros(uint64_t value) {
+    int count = 0;
+    for (uint64_t mask = 1; mask != 0 && (value & mask) == 0; mask <<= 1) {
+        ++count;
+    }
+    return count;
+}
+
+uint32_t read32(const std::string& data, size_t position) {
+    uint32_t value;
+    std::memcpy(&value, data.data() + position, sizeof(value));
+    return value;
+}
+
+size_t hashSequence(uint32_t sequence) {
+    return static_cast<size_t>((sequence * 2654435761u) >> (32 - HASH_BITS));
+}
+
+void writeLength(std::string& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+bool readLength(const std::string& in, size_t& position, size_t& length) {
+    uint8_t byte;
+    do {
+        if (position >= in.size()) {
+            return false;
+        }
+        byte = static_cast<uint8_t>(in[position++]);
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+void emitSequence(std::string& out, const std::string& input, size_t literalStart, size_t literalLength,
+                  size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15));
+    out.push_back(static_cast<char>(token));
+
+    if (literalLength >= 15) {
+        writeLength(out, literalLength - 15);
+    }
+    out.append(input, literalStart, literalLength);
+
+    if (matchLength == 0) {
+        return;
+    }
+
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>((offset >> 8) & 0xFF));
+    if (matchCode >= 15) {
+        writeLength(out, matchCode - 15);
+    }
+}
+
+void writeVarint(std::ostream& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+bool readVarint(std::istream& in, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = in.get();
+        if (byte == std::char_traits<char>::eof()) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+FloatSeriesEncoder::FloatSeriesEncoder()
+    : bitsUsed(0),
+      count(0),
+      previous(0),
+      previousLeading(-1),
+      previousTrailing(0)
+{
+}
+
+void FloatSeriesEncoder::writeBits(uint64_t value, int bits) {
+    while (bits > 0) {
+        if (bitsUsed == 0) {
+            out.push_back('\0');
+        }
+
+        int space = 8 - bitsUsed;
+        int take = std::min(space, bits);
+        uint8_t chunk = static_cast<uint8_t>((value >> (bits - take)) & ((1u << take) - 1));
+        out.back() = static_cast<char>(static_cast<uint8_t>(out.back()) | (chunk << (space - take)));
+
+        bitsUsed = static_cast<uint8_t>((bitsUsed + take) % 8);
+        bits -= take;
+    }
+}
+
+void FloatSeriesEncoder::add(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    if (count == 0) {
+        writeBits(bits, 64);
+    } else {
+        uint64_t delta = bits ^ previous;
+        if (delta == 0) {
+            writeBits(0, 1);
+        } else {
+            int leading = std::min(countLeadingZeros(delta), 31);
+            int trailing = countTrailingZeros(delta);
+
+            if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+                writeBits(0x2, 2);
+                writeBits(delta >> previousTrailing, 64 - previousLeading - previousTrailing);
+            } else {
+                int meaningful = 64 - leading - trailing;
+                writeBits(0x3, 2);
+                writeBits(static_cast<uint64_t>(leading), 5);
+                writeBits(static_cast<uint64_t>(meaningful == 64 ? 0 : meaningful), 6);
+                writeBits(delta >> trailing, meaningful);
+                previousLeading = leading;
+                previousTrailing = trailing;
+            }
+        }
+    }
+
+    previous = bits;
+    ++count;
+}
+
+const std::string& FloatSeriesEncoder::bytes() const {
+    return out;
+}
+
+size_t FloatSeriesEncoder::size() const {
+    return count;
+}
+
+FloatSeriesDecoder::FloatSeriesDecoder(const std::string& bytes, size_t count)
+    : in(bytes),
+      bitPosition(0),
+      remaining(count),
+      first(true),
+      previous(0),
+      previousLeading(-1),
+      previousTrailing(0)
+{
+}
+
+bool FloatSeriesDecoder::readBits(int bits, uint64_t& value) {
+    if (bitPosition + static_cast<size_t>(bits) > in.size() * 8) {
+        return false;
+    }
+
+    value = 0;
+    while (bits > 0) {
+        int offset = static_cast<int>(bitPosition % 8);
+        int available = 8 - offset;
+        int take = std::min(available, bits);
+        uint8_t byte = static_cast<uint8_t>(in[bitPosition / 8]);
+
+        value = (value << take) | ((byte >> (available - take)) & ((1u << take) - 1));
+        bitPosition += static_cast<size_t>(take);
+        bits -= take;
+    }
+    return true;
+}
+
+bool FloatSeriesDecoder::next(double& value) {
+    if (remaining == 0) {
+        return false;
+    }
+
+    uint64_t bits;
+    if (first) {
+        if (!readBits(64, bits)) {
+            return false;
+        }
+        first = false;
+    } else {
+        uint64_t flag;
+        if (!readBits(1, flag)) {
+            return false;
+        }
+
+        if (flag == 0) {
+            bits = previous;
+        } else {
+            if (!readBits(1, flag)) {
+                return false;
+            }
+
+            if (flag == 1) {
+                uint64_t leading, meaningful;
+                if (!readBits(5, leading) || !readBits(6, meaningful)) {
+                    return false;
+                }
+                if (meaningful == 0) {
+                    meaningful = 64;
+                }
+                if (leading + meaningful > 64) {
+                    return false;
+                }
+                previousLeading = static_cast<int>(leading);
+                previousTrailing = static_cast<int>(64 - leading - meaningful);
+            } else if (previousLeading < 0) {
+                return false;
+            }
+
+            uint64_t delta;
+            if (!readBits(64 - previousLeading - previousTrailing, delta)) {
+                return false;
+            }
+            bits = previous ^ (delta << previousTrailing);
+        }
+    }
+
+    previous = bits;
+    --remaining;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+LzEncoder::LzEncoder(std::ostream& out, size_t blockSize)
+    : out(out),
+      blockSize(std::max<size_t>(blockSize, 1)),
+      finished(false)
+{
+}
+
+LzEncoder::~LzEncoder() {
+    finish();
+}
+
+void LzEncoder::flushBlock() {
+    if (pending.empty()) {
+        return;
+    }
+
+    // Blocks that do not shrink are stored as they are; a compressed length
+    // equal to the raw length marks them.
+    std::string compressed = Compression::compressBlock(pending);
+    const std::string& payload = compressed.size() < pending.size() ? compressed : pending;
+
+    writeVarint(out, pending.size());
+    writeVarint(out, payload.size());
+    out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    pending.clear();
+}
+
+void LzEncoder::write(const char* data, size_t length) {
+    while (length > 0) {
+        size_t take = std::min(length, blockSize - pending.size());
+        pending.append(data, take);
+        data += take;
+        length -= take;
+
+        if (pending.size() == blockSize) {
+            flushBlock();
+        }
+    }
+}
+
+void LzEncoder::write(const std::string& data) {
+    write(data.data(), data.size());
+}
+
+void LzEncoder::finish() {
+    if (finished) {
+        return;
+    }
+    flushBlock();
+    writeVarint(out, 0);
+    out.flush();
+    finished = true;
+}
+
+LzDecoder::LzDecoder(std::istream& in)
+    : in(in),
+      finished(false)
+{
+}
+
+bool LzDecoder::read(std::string& chunk) {
+    if (finished) {
+        return false;
+    }
+
+    uint64_t rawLength;
+    if (!readVarint(in, rawLength)) {
+        lastError = "Compressed stream ends without a terminator";
+        finished = true;
+        return false;
+    }
+    if (rawLength == 0) {
+        finished = true;
+        return false;
+    }
+
+    uint64_t storedLength;
+    if (!readVarint(in, storedLength) || rawLength > MAX_BLOCK_SIZE || storedLength > rawLength) {
+        lastError = "Damaged compressed block header";
+        finished = true;
+        return false;
+    }
+
+    std::string stored(static_cast<size_t>(storedLength), '\0');
+    in.read(&stored[0], static_cast<std::streamsize>(storedLength));
+    if (in.gcount() != static_cast<std::streamsize>(storedLength)) {
+        lastError = "Truncated compressed block";
+        finished = true;
+        return false;
+    }
+
+    if (storedLength == rawLength) {
+        chunk = std::move(stored);
+        return true;
+    }
+
+    if (!Compression::decompressBlock(stored, static_cast<size_t>(rawLength), chunk)) {
+        lastError = "Damaged compressed block";
+        finished = true;
+        return false;
+    }
+    return true;
+}
+
+std::string LzDecoder::getLastError() const {
+    return lastError;
+}
+
+std::string Compression::compressBlock(const std::string& input) {
+    std::string out;
+    out.reserve(input.size() / 2 + 16);
+
+    std::vector<uint32_t> table(static_cast<size_t>(1) << HASH_BITS, NO_POSITION);
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position + MIN_MATCH <= input.size()) {
+        uint32_t sequence = read32(input, position);
+        size_t slot = hashSequence(sequence);
+        uint32_t candidate = table[slot];
+        table[slot] = static_cast<uint32_t>(position);
+
+        if (candidate == NO_POSITION || position - candidate > MAX_OFFSET || read32(input, candidate) != sequence) {
+            ++position;
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (position + length < input.size() && input[candidate + length] == input[position + length]) {
+            ++length;
+        }
+
+        emitSequence(out, input, anchor, position - anchor, position - candidate, length);
+        position += length;
+        anchor = position;
+    }
+
+    emitSequence(out, input, anchor, input.size() - anchor, 0, 0);
+    return out;
+}
+
+bool Compression::decompressBlock(const std::string& input, size_t rawLength, std::string& output) {
+    output.clear();
+    output.reserve(rawLength);
+
+    size_t position = 0;
+    while (position < input.size()) {
+        uint8_t token = static_cast<uint8_t>(input[position++]);
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(input, position, literalLength)) {
+            return false;
+        }
+        if (position + literalLength > input.size() || output.size() + literalLength > rawLength) {
+            return false;
+        }
+        output.append(input, position, literalLength);
+        position += literalLength;
+
+        // The last sequence carries literals only.
+        if (position == input.size()) {
+            break;
+        }
+
+        if (position + 2 > input.size()) {
+            return false;
+        }
+        size_t offset = static_cast<uint8_t>(input[position]) |
+                        (static_cast<size_t>(static_cast<uint8_t>(input[position + 1])) << 8);
+        position += 2;
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readLength(input, position, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > output.size() || output.size() + matchLength > rawLength) {
+            return false;
+        }
+
+        // Byte by byte, since a match may overlap the bytes it produces.
+        size_t start = output.size() - offset;
+        for (size_t i = 0; i < matchLength; ++i) {
+            output.push_back(output[start + i]);
+        }
+    }
+
+    return output.size() == rawLength;
+}
+
+std::string Compression::compressText(const std::string& text) {
+    std::ostringstream out;
+    LzEncoder encoder(out);
+    encoder.write(text);
+    encoder.finish();
+    return out.str();
+}
+
+bool Compression::decompressText(const std::string& data, std::string& text) {
+    std::istringstream in(data);
+    LzDecoder decoder(in);
+
+    text.clear();
+    std::string chunk;
+    while (decoder.read(chunk)) {
+        text += chunk;
+    }
+    return decoder.getLastError().empty();
+}
+
+std::string Compression::encodeDoubles(const std::vector<double>& values) {
+    FloatSeriesEncoder encoder;
+    for (double value : values) {
+        encoder.add(value);
+    }
+    return encoder.bytes();
+}
+
+bool Compression::decodeDoubles(const std::string& bytes, size_t count, std::vector<double>& values) {
+    values.clear();
+
+    // Every value takes at least one bit, so a larger count is damaged input
+    // and must not size the reservation.
+    if (count / 8 > bytes.size()) {
+        return false;
+    }
+    values.reserve(count);
+
+    FloatSeriesDecoder decoder(bytes, count);
+    double value;
+    while (decoder.next(value)) {
+        values.push_back(value);
+    }
+    return values.size() == count;
+}
+
+std::string Compression::toBase64(const std::string& bytes) {
+    std::string text;
+    text.reserve((bytes.size() + 2) / 3 * 4);
+
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        uint32_t group = static_cast<uint32_t>(static_cast<uint8_t>(bytes[i])) << 16;
+        if (i + 1 < bytes.size()) {
+            group |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[i + 1])) << 8;
+        }
+        if (i + 2 < bytes.size()) {
+            group |= static_cast<uint8_t>(bytes[i + 2]);
+        }
+
+        text.push_back(BASE64_ALPHABET[(group >> 18) & 0x3F]);
+        text.push_back(BASE64_ALPHABET[(group >> 12) & 0x3F]);
+        text.push_back(i + 1 < bytes.size() ? BASE64_ALPHABET[(group >> 6) & 0x3F] : '=');
+        text.push_back(i + 2 < bytes.size() ? BASE64_ALPHABET[group & 0x3F] : '=');
+    }
+    return text;
+}
+
+bool Compression::fromBase64(const std::string& text, std::string& bytes) {
+    bytes.clear();
+    if (text.size() % 4 != 0) {
+        return false;
+    }
+    bytes.reserve(text.size() / 4 * 3);
+
+    for (size_t i = 0; i < text.size(); i += 4) {
+        uint32_t group = 0;
+        int padding = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            char c = text[i + j];
+            const char* found = std::strchr(BASE64_ALPHABET, c);
+            if (c == '=' && i + 4 == text.size() && j >= 2) {
+                ++padding;
+                group <<= 6;
+            } else if (c != '\0' && found != nullptr && padding == 0) {
+                group = (group << 6) | static_cast<uint32_t>(found - BASE64_ALPHABET);
+            } else {
+                return false;
+            }
+        }
+
+        bytes.push_back(static_cast<char>((group >> 16) & 0xFF));
+        if (padding < 2) {
+            bytes.push_back(static_cast<char>((group >> 8) & 0xFF));
+        }
+        if (padding < 1) {
+            bytes.push_back(static_cast<char>(group & 0xFF));
+        }
+    }
+    return true;
+}
+
+nlohmann::json Compression::packJson(const nlohmann::json& value) {
+    return {{"codec", "lz"}, {"data", toBase64(compressText(value.dump()))}};
+}
+
+bool Compression::unpackJson(const nlohmann::json& value, nlohmann::json& unpacked) {
+    if (!value.is_object() || value.value("codec", std::string()) != "lz") {
+        unpacked = value;
+        return true;
+    }
+
+    std::string bytes;
+    std::string text;
+    if (!value.contains("data") || !value["data"].is_string() ||
+        !fromBase64(value["data"].get<std::string>(), bytes) || !decompressText(bytes, text)) {
+        return false;
+    }
+
+    unpacked = nlohmann::json::parse(text, nullptr, false);
+    return !unpacked.is_discarded();
+}
+
+nlohmann::json Compression::packDoubles(const std::vector<double>& values) {
+    return {{"count", values.size()}, {"xor", toBase64(encodeDoubles(values))}};
+}
+
+bool Compression::unpackDoubles(const nlohmann::json& value, std::vector<double>& values) {
+    if (value.is_array()) {
+        values = value.get<std::vector<double>>();
+        return true;
+    }
+
+    std::string bytes;
+    if (!value.is_object() || !value.contains("xor") || !value["xor"].is_string() || !value.contains("count") ||
+        !value["count"].is_number_unsigned() || !fromBase64(value["xor"].get<std::string>(), bytes)) {
+        return false;
+    }
+    return decodeDoubles(bytes, value["count"].get<size_t>(), values);
+}
+
+}
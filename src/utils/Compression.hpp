@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace StockMarketSimulator {
+
+// Gorilla-style XOR encoding for a series of doubles. Each value is stored as
+// the XOR with its predecessor: a single bit when unchanged, otherwise only
+// the meaningful bits, reusing the previous leading/trailing zero window when
+// it still fits. Values are appended one at a time; bytes() is valid at any
+// point and grows as the series does.
+class FloatSeriesEncoder {
+private:
+    std::string out;
+    uint8_t bitsUsed;
+    size_t count;
+    uint64_t previous;
+    int previousLeading;
+    int previousTrailing;
+
+    void writeBits(uint64_t value, int bits);
+
+public:
+    FloatSeriesEncoder();
+
+    void add(double value);
+
+    const std::string& bytes() const;
+    size_t size() const;
+};
+
+class FloatSeriesDecoder {
+private:
+    const std::string& in;
+    size_t bitPosition;
+    size_t remaining;
+    bool first;
+    uint64_t previous;
+    int previousLeading;
+    int previousTrailing;
+
+    bool readBits(int bits, uint64_t& value);
+
+public:
+    // The count is not part of the encoding; it travels next to the bytes.
+    FloatSeriesDecoder(const std::string& bytes, size_t count);
+
+    // Returns false once the series is exhausted or the bytes run out.
+    bool next(double& value);
+};
+
+// Byte-oriented LZ77 codec in the spirit of LZ4: sequences of literals followed
+// by a back reference into a 64 KiB window. The stream form is a series of
+// independently compressed blocks, each framed as varint raw length, varint
+// compressed length and the compressed bytes, terminated by a zero raw length.
+class LzEncoder {
+private:
+    std::ostream& out;
+    std::string pending;
+    size_t blockSize;
+    bool finished;
+
+    void flushBlock();
+
+public:
+    explicit LzEncoder(std::ostream& out, size_t blockSize = 64 * 1024);
+    ~LzEncoder();
+
+    LzEncoder(const LzEncoder&) = delete;
+    LzEncoder& operator=(const LzEncoder&) = delete;
+
+    void write(const char* data, size_t length);
+    void write(const std::string& data);
+
+    // Flushes the last block and writes the terminator. Called by the
+    // destructor if not called explicitly.
+    void finish();
+};
+
+class LzDecoder {
+private:
+    std::istream& in;
+    bool finished;
+    std::string lastError;
+
+public:
+    explicit LzDecoder(std::istream& in);
+
+    // Decodes the next block into chunk. Returns false at the end of the
+    // stream or on damaged input; getLastError() tells the two apart.
+    bool read(std::string& chunk);
+
+    std::string getLastError() const;
+};
+
+class Compression {
+public:
+    static std::string compressBlock(const std::string& input);
+    static bool decompressBlock(const std::string& input, size_t rawLength, std::string& output);
+
+    static std::string compressText(const std::string& text);
+    static bool decompressText(const std::string& data, std::string& text);
+
+    static std::string encodeDoubles(const std::vector<double>& values);
+    static bool decodeDoubles(const std::string& bytes, size_t count, std::vector<double>& values);
+
+    static std::string toBase64(const std::string& bytes);
+    static bool fromBase64(const std::string& text, std::string& bytes);
+
+    // Wraps a JSON value as {"codec":"lz","data":<base64>} so it can sit inside
+    // another JSON document; unpackJson() accepts packed and plain values alike.
+    static nlohmann::json packJson(const nlohmann::json& value);
+    static bool unpackJson(const nlohmann::json& value, nlohmann::json& unpacked);
+
+    // Stores a price series as {"count":n,"xor":<base64>} and back; plain arrays
+    // are accepted by unpackDoubles() as well.
+    static nlohmann::json packDoubles(const std::vector<double>& values);
+    static bool unpackDoubles(const nlohmann::json& value, std::vector<double>& values);
+};
+
+}
@@ -1,7 +1,10 @@
 #include "Console.hpp"
+#include "EventLoop.hpp"
+#include "TerminalGeometry.hpp"
 #include <thread>
 #include <chrono>
 #include <cstdio>
+#include <cerrno>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -86,6 +89,7 @@ void Console::initializeConsole() {
 #else
     setupTerminalMode();
 #endif
+    TerminalGeometry::installResizeHandler();
     isInitialized = true;
 }
 
@@ -117,25 +121,7 @@ void Console::setCursorPosition(int x, int y) {
 
 std::pair<int, int> Console::getSize() {
     initialize();
-    int width = 80;
-    int height = 24;
-
-#ifdef _WIN32
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    if (GetConsoleScreenBufferInfo(hOut, &csbi)) {
-        width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
-        height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
-    }
-#else
-    struct winsize w;
-    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) != -1) {
-        width = w.ws_col;
-        height = w.ws_row;
-    }
-#endif
-
-    return {width, height};
+    return TerminalGeometry::getSize();
 }
 
 void Console::setColor(TextColor fg, TextColor bg) {
@@ -212,9 +198,15 @@ bool Console::keyPressed() {
 }
 
 char Console::readChar() {
+    char key = 0;
+    return readKey(key) ? key : 0;
+}
+
+bool Console::readKey(char& key) {
     initialize();
 #ifdef _WIN32
-    return _getch();
+    key = static_cast<char>(_getch());
+    return true;
 #else
     char c = 0;
 
@@ -224,10 +216,17 @@ char Console::readChar() {
 
     select(STDIN_FILENO + 1, &readfds, NULL, NULL, NULL);
 
-    if (read(STDIN_FILENO, &c, 1) < 0) {
-        return 0;
+    ssize_t bytes = read(STDIN_FILENO, &c, 1);
+    if (bytes < 0 && (errno == EINTR || errno == EAGAIN)) {
+        key = 0;
+        return true;
+    }
+    if (bytes <= 0) {
+        return false;
     }
 
+    key = c;
+
     if (c == 27) {
         struct timeval tv;
         tv.tv_sec = 0;
@@ -237,6 +236,7 @@ char Console::readChar() {
         FD_SET(STDIN_FILENO, &readfds);
         int result = select(STDIN_FILENO + 1, &readfds, NULL, NULL, &tv);
 
+        key = static_cast<char>(Key::Escape);
         if (result > 0) {
             char seq[2] = {0, 0};
             if (read(STDIN_FILENO, &seq[0], 1) == 1) {
@@ -244,10 +244,10 @@ char Console::readChar() {
                     if (select(STDIN_FILENO + 1, &readfds, NULL, NULL, &tv) > 0) {
                         if (read(STDIN_FILENO, &seq[1], 1) == 1) {
                             switch (seq[1]) {
-                                case 'A': return static_cast<char>(Key::ArrowUp);
-                                case 'B': return static_cast<char>(Key::ArrowDown);
-                                case 'C': return static_cast<char>(Key::ArrowRight);
-                                case 'D': return static_cast<char>(Key::ArrowLeft);
+                                case 'A': key = static_cast<char>(Key::ArrowUp); break;
+                                case 'B': key = static_cast<char>(Key::ArrowDown); break;
+                                case 'C': key = static_cast<char>(Key::ArrowRight); break;
+                                case 'D': key = static_cast<char>(Key::ArrowLeft); break;
                             }
                         }
                     }
@@ -255,14 +255,14 @@ char Console::readChar() {
             }
         }
 
-        return static_cast<char>(Key::Escape);
+        return true;
     }
 
     if (c == 10) {
-        return static_cast<char>(Key::Enter);
+        key = static_cast<char>(Key::Enter);
     }
 
-    return c;
+    return true;
 #endif
 }
 
@@ -543,6 +543,16 @@ void Console::drawProgressBar(int x, int y, int width, double progress,
     resetAttributes();
 }
 
+// Without onWake, wakeups such as terminal resizes go to the enclosing loop.
+void Console::handleInput(const std::function<bool(char)>& callback,
+                          const std::function<void()>& onWake) {
+    EventLoop loop;
+    loop.setWakeHandler(onWake);
+    loop.run([&callback](int key) {
+        return callback(static_cast<char>(key));
+    });
+}
+
 void Console::sleep(int milliseconds) {
     std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
 }
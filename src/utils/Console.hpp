@@ -89,6 +89,9 @@ public:
 
     static char readChar();
 
+    // Like readChar(), but returns false once input has ended.
+    static bool readKey(char& key);
+
     static bool keyPressed();
 
     static void drawBox(int x, int y, int width, int height,
@@ -119,19 +122,8 @@ public:
 
     static void waitForKey();
 
-    template<typename Func>
-    static void handleInput(Func callback) {
-        char key;
-        while (true) {
-            if (keyPressed()) {
-                key = readChar();
-                if (!callback(key)) {
-                    break;
-                }
-            }
-            sleep(50);
-        }
-    }
+    static void handleInput(const std::function<bool(char)>& callback,
+                            const std::function<void()>& onWake = nullptr);
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "EventLoop.hpp"
+#include "Console.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+namespace StockMarketSimulator {
+
+std::mutex EventLoop::currentMutex;
+EventLoop* EventLoop::currentLoop = nullptr;
+std::atomic<int> EventLoop::currentWakeFd{-1};
+
+EventLoop::EventLoop(int inputFd)
+    : inputFd(inputFd),
+      wakeFds{-1, -1},
+      timerFd(-1),
+      tickInterval(0),
+      running(false),
+      enclosingLoop(nullptr)
+{
+#ifndef _WIN32
+    if (pipe(wakeFds) == 0) {
+        for (int fd : wakeFds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        wakeFds[0] = wakeFds[1] = -1;
+    }
+#endif
+
+#ifdef __linux__
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+#endif
+}
+
+EventLoop::~EventLoop() {
+#ifndef _WIN32
+    for (int fd : wakeFds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    if (timerFd >= 0) {
+        close(timerFd);
+    }
+#endif
+}
+
+void EventLoop::setTickInterval(int milliseconds) {
+    tickInterval = milliseconds > 0 ? milliseconds : 0;
+    if (running) {
+        armTimer();
+    }
+}
+
+int EventLoop::getTickInterval() const {
+    return tickInterval;
+}
+
+void EventLoop::setWakeHandler(WakeHandler handler) {
+    wakeHandler = std::move(handler);
+}
+
+bool EventLoop::isRunning() const {
+    return running;
+}
+
+void EventLoop::armTimer() {
+#ifdef __linux__
+    if (timerFd < 0) {
+        return;
+    }
+
+    struct itimerspec spec {};
+    spec.it_interval.tv_sec = tickInterval / 1000;
+    spec.it_interval.tv_nsec = static_cast<long>(tickInterval % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+#endif
+}
+
+void EventLoop::disarmTimer() {
+#ifdef __linux__
+    if (timerFd >= 0) {
+        struct itimerspec spec {};
+        timerfd_settime(timerFd, 0, &spec, nullptr);
+    }
+#endif
+}
+
+void EventLoop::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        pendingTasks.push_back(std::move(task));
+    }
+    wake();
+}
+
+void EventLoop::wake() {
+#ifndef _WIN32
+    if (wakeFds[1] >= 0) {
+        char byte = 1;
+        ssize_t written = write(wakeFds[1], &byte, 1);
+        (void)written;
+    }
+#endif
+}
+
+void EventLoop::stop() {
+    running = false;
+    wake();
+}
+
+void EventLoop::drainWakePipe() {
+#ifndef _WIN32
+    char buffer[64];
+    while (read(wakeFds[0], buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+}
+
+void EventLoop::runPendingTasks() {
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        tasks.swap(pendingTasks);
+    }
+
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+bool EventLoop::readKey(int& key) {
+    if (inputFd == STDIN_INPUT) {
+        char c = 0;
+        if (!Console::readKey(c)) {
+            return false;
+        }
+        key = c;
+        return true;
+    }
+
+#ifndef _WIN32
+    unsigned char c = 0;
+    if (read(inputFd, &c, 1) <= 0) {
+        return false;
+    }
+    key = c;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void EventLoop::enter() {
+    std::lock_guard<std::mutex> lock(currentMutex);
+    enclosingLoop = currentLoop;
+    currentLoop = this;
+    currentWakeFd = wakeFds[1];
+}
+
+void EventLoop::leave() {
+    std::lock_guard<std::mutex> lock(currentMutex);
+    if (currentLoop == this) {
+        currentLoop = enclosingLoop;
+        currentWakeFd = currentLoop ? currentLoop->wakeFds[1] : -1;
+    }
+    enclosingLoop = nullptr;
+}
+
+// Only touches a lock-free atomic and write(), so it is safe from signal handlers.
+void EventLoop::signalWake() {
+#ifndef _WIN32
+    int fd = currentWakeFd.load();
+    if (fd >= 0) {
+        char byte = 1;
+        ssize_t written = write(fd, &byte, 1);
+        (void)written;
+    }
+#endif
+}
+
+bool EventLoop::postToCurrent(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(currentMutex);
+    if (!currentLoop) {
+        return false;
+    }
+
+    currentLoop->post(std::move(task));
+    return true;
+}
+
+void EventLoop::run(const KeyHandler& onKey, const TickHandler& onTick) {
+    // Register first: once isRunning() reports true, postToCurrent() must reach this loop.
+    enter();
+    running = true;
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point nextTick = Clock::now() + std::chrono::milliseconds(tickInterval);
+    const bool hasInput = inputFd != NO_INPUT;
+
+    if (tickInterval > 0) {
+        armTimer();
+    }
+
+    while (running) {
+        bool inputReady = false;
+        bool tickDue = false;
+        bool woken = false;
+
+#ifndef _WIN32
+        struct pollfd fds[3];
+        nfds_t count = 0;
+        int inputSlot = -1, wakeSlot = -1, timerSlot = -1;
+
+        if (hasInput) {
+            inputSlot = static_cast<int>(count);
+            fds[count++] = {inputFd, POLLIN, 0};
+        }
+        if (wakeFds[0] >= 0) {
+            wakeSlot = static_cast<int>(count);
+            fds[count++] = {wakeFds[0], POLLIN, 0};
+        }
+        if (tickInterval > 0 && timerFd >= 0) {
+            timerSlot = static_cast<int>(count);
+            fds[count++] = {timerFd, POLLIN, 0};
+        }
+
+        int timeout = -1;
+        if (tickInterval > 0 && timerFd < 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(nextTick - Clock::now());
+            timeout = static_cast<int>(std::max<int64_t>(0, remaining.count()));
+        }
+
+        int ready = poll(fds, count, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        if (wakeSlot >= 0 && (fds[wakeSlot].revents & POLLIN)) {
+            drainWakePipe();
+            woken = true;
+        }
+
+        if (inputSlot >= 0 && (fds[inputSlot].revents & (POLLIN | POLLHUP | POLLERR))) {
+            inputReady = true;
+        }
+
+        if (timerSlot >= 0 && (fds[timerSlot].revents & POLLIN)) {
+            uint64_t expirations = 0;
+            ssize_t bytes = read(timerFd, &expirations, sizeof(expirations));
+            tickDue = bytes == sizeof(expirations) && expirations > 0;
+        }
+#else
+        inputReady = hasInput && Console::keyPressed();
+        if (!inputReady) {
+            Console::sleep(10);
+        }
+#endif
+
+        if (tickInterval > 0 && timerFd < 0 && Clock::now() >= nextTick) {
+            tickDue = true;
+            nextTick = Clock::now() + std::chrono::milliseconds(tickInterval);
+        }
+
+        runPendingTasks();
+
+        // A nested loop without its own handler passes wakeups on, so the
+        // enclosing loop handles them once it polls again.
+        if (running && woken) {
+            if (wakeHandler) {
+                wakeHandler();
+            } else if (enclosingLoop) {
+                enclosingLoop->wake();
+            }
+        }
+
+        // End of input (EOF or a hung-up terminal) ends the loop: polling the
+        // input again would spin, and nothing else would ever stop it.
+        if (running && inputReady) {
+            int key = 0;
+            if (!readKey(key) || !onKey(key)) {
+                running = false;
+            }
+        }
+
+        if (running && tickDue && onTick && !onTick()) {
+            running = false;
+        }
+    }
+
+    disarmTimer();
+    leave();
+    running = false;
+}
+
+}
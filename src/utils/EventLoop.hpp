@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace StockMarketSimulator {
+
+class EventLoop {
+public:
+    using KeyHandler = std::function<bool(int key)>;
+    using TickHandler = std::function<bool()>;
+    using WakeHandler = std::function<void()>;
+
+private:
+    int inputFd;
+    int wakeFds[2];
+    int timerFd;
+    int tickInterval;
+    std::atomic<bool> running;
+    std::mutex taskMutex;
+    std::vector<std::function<void()>> pendingTasks;
+    WakeHandler wakeHandler;
+    EventLoop* enclosingLoop;
+
+    static std::mutex currentMutex;
+    static EventLoop* currentLoop;
+    static std::atomic<int> currentWakeFd;
+
+    void armTimer();
+    void disarmTimer();
+    void drainWakePipe();
+    void runPendingTasks();
+    bool readKey(int& key);
+    void enter();
+    void leave();
+
+public:
+    static constexpr int STDIN_INPUT = 0;
+    static constexpr int NO_INPUT = -1;
+
+    explicit EventLoop(int inputFd = STDIN_INPUT);
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    void setTickInterval(int milliseconds);
+    int getTickInterval() const;
+    void setWakeHandler(WakeHandler handler);
+
+    void run(const KeyHandler& onKey, const TickHandler& onTick = nullptr);
+    bool isRunning() const;
+
+    void post(std::function<void()> task);
+    void wake();
+    void stop();
+
+    static bool postToCurrent(std::function<void()> task);
+    static void signalWake();
+};
+
+}
@@ -1,24 +1,184 @@
 #include "FileIO.hpp"
+#include "Compression.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <mutex>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 
 #ifdef _WIN32
 #include <direct.h>
 #include <windows.h>
 #include <io.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #define ACCESS _access
 #define MKDIR(dir) _mkdir(dir)
 #else
 #include <sys/stat.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <fcntl.h>
 #define ACCESS access
 #define MKDIR(dir) mkdir(dir, 0755)
 #endif
 
 namespace StockMarketSimulator {
 
+namespace {
+
+std::mutex& logMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::string& logFilePath() {
+    static std::string path = "log.txt";
+    return path;
+}
+
+// Seconds since filePath was last modified, or -1 if it cannot be read.
+double fileAgeSeconds(const std::string& filePath) {
+#ifdef _WIN32
+    struct _stat info;
+    if (_stat(filePath.c_str(), &info) != 0) {
+        return -1.0;
+    }
+#else
+    struct stat info;
+    if (stat(filePath.c_str(), &info) != 0) {
+        return -1.0;
+    }
+#endif
+    return std::difftime(std::time(nullptr), info.st_mtime);
+}
+
+std::string parentDirectory(const std::string& filePath) {
+    size_t lastSlash = filePath.find_last_of("/\\");
+    if (lastSlash == std::string::npos) {
+        return ".";
+    }
+    return lastSlash == 0 ? "/" : filePath.substr(0, lastSlash);
+}
+
+std::string systemError(const std::string& action, const std::string& path) {
+    return action + " " + path + ": " + std::strerror(errno);
+}
+
+// Temporary siblings get a unique suffix so concurrent writers of the same
+// target never share one. Returns the temporary path.
+const std::string TEMPORARY_SUFFIX = ".tmp.XXXXXX";
+
+bool isTemporaryFile(const std::string& filename) {
+    size_t marker = TEMPORARY_SUFFIX.size() - 6;
+    return filename.size() > TEMPORARY_SUFFIX.size() &&
+           filename.compare(filename.size() - TEMPORARY_SUFFIX.size(), marker, TEMPORARY_SUFFIX, 0, marker) == 0;
+}
+
+#ifdef _WIN32
+std::string writeTemporaryFile(const std::string& target, const std::string& content, bool syncData) {
+    std::string path = target + TEMPORARY_SUFFIX;
+    if (_mktemp_s(&path[0], path.size() + 1) != 0) {
+        throw std::runtime_error(systemError("Failed to name a temporary file for", target));
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error(systemError("Failed to create", path));
+    }
+
+    bool ok = std::fwrite(content.data(), 1, content.size(), file) == content.size() && std::fflush(file) == 0;
+    if (ok && syncData) {
+        ok = _commit(_fileno(file)) == 0;
+    }
+    std::fclose(file);
+
+    if (!ok) {
+        std::string error = systemError("Failed to write", path);
+        std::remove(path.c_str());
+        throw std::runtime_error(error);
+    }
+    return path;
+}
+
+void replaceFile(const std::string& from, const std::string& to, bool writeThrough) {
+    DWORD flags = MOVEFILE_REPLACE_EXISTING | (writeThrough ? MOVEFILE_WRITE_THROUGH : 0);
+    if (!MoveFileExA(from.c_str(), to.c_str(), flags)) {
+        throw std::runtime_error("Failed to rename " + from + " to " + to);
+    }
+}
+
+void syncDirectory(const std::string&) {
+    // MOVEFILE_WRITE_THROUGH already covers the rename.
+}
+#else
+std::string writeTemporaryFile(const std::string& target, const std::string& content, bool syncData) {
+    std::string path = target + TEMPORARY_SUFFIX;
+    int fd = ::mkstemp(&path[0]);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Failed to create", path));
+    }
+
+    // mkstemp creates the file private to the owner; saves are shared like
+    // any other file the game writes.
+    ::fchmod(fd, 0644);
+
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t result = ::write(fd, content.data() + written, content.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::string error = systemError("Failed to write", path);
+            ::close(fd);
+            ::unlink(path.c_str());
+            throw std::runtime_error(error);
+        }
+        written += static_cast<size_t>(result);
+    }
+
+#ifdef __APPLE__
+    int synced = syncData ? ::fsync(fd) : 0;
+#else
+    int synced = syncData ? ::fdatasync(fd) : 0;
+#endif
+    std::string error = synced != 0 ? systemError("Failed to sync", path) : std::string();
+    if (::close(fd) != 0 && error.empty()) {
+        error = systemError("Failed to close", path);
+    }
+    if (!error.empty()) {
+        ::unlink(path.c_str());
+        throw std::runtime_error(error);
+    }
+    return path;
+}
+
+void replaceFile(const std::string& from, const std::string& to, bool) {
+    if (::rename(from.c_str(), to.c_str()) != 0) {
+        throw std::runtime_error(systemError("Failed to rename " + from + " to", to));
+    }
+}
+
+void syncDirectory(const std::string& directory) {
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Failed to open directory", directory));
+    }
+    int result = ::fsync(fd);
+    std::string error = result != 0 ? systemError("Failed to sync directory", directory) : std::string();
+    ::close(fd);
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+#endif
+
+}
+
 bool FileIO::isInitialized = false;
 
 void FileIO::initialize() {
@@ -150,6 +310,118 @@ void FileIO::writeTextFile(const std::string& filePath, const std::string& conte
     }
 }
 
+void FileIO::writeFilesAtomically(const std::vector<std::pair<std::string, std::string>>& files,
+                                  Durability durability) {
+    if (!isInitialized) {
+        initialize();
+    }
+
+    std::vector<std::string> temporaryPaths;
+    std::vector<std::string> directories;
+    size_t renamed = 0;
+
+    try {
+        for (const auto& file : files) {
+            std::string directory = parentDirectory(file.first);
+            if (!directoryExists(directory)) {
+                createDirectory(directory);
+            }
+            if (std::find(directories.begin(), directories.end(), directory) == directories.end()) {
+                directories.push_back(directory);
+            }
+
+            temporaryPaths.push_back(writeTemporaryFile(file.first, file.second, durability != Durability::Atomic));
+        }
+
+        for (; renamed < files.size(); ++renamed) {
+            replaceFile(temporaryPaths[renamed], files[renamed].first, durability == Durability::Full);
+        }
+
+        if (durability == Durability::Full) {
+            for (const auto& directory : directories) {
+                syncDirectory(directory);
+            }
+        }
+    } catch (const std::exception& e) {
+        for (size_t i = renamed; i < temporaryPaths.size(); ++i) {
+            std::remove(temporaryPaths[i].c_str());
+        }
+        throw std::runtime_error("Error writing files atomically: " + std::string(e.what()));
+    }
+}
+
+void FileIO::writeFileAtomically(const std::string& filePath, const std::string& content, Durability durability) {
+    writeFilesAtomically({{filePath, content}}, durability);
+}
+
+size_t FileIO::removeTemporaryFiles(const std::string& directory, int minimumAgeSeconds) {
+    size_t removed = 0;
+    for (const auto& file : listFiles(directory)) {
+        if (!isTemporaryFile(file)) {
+            continue;
+        }
+
+        std::string filePath = combineFilePath(directory, file);
+        if (minimumAgeSeconds > 0 && fileAgeSeconds(filePath) < minimumAgeSeconds) {
+            continue;
+        }
+        if (std::remove(filePath.c_str()) == 0) {
+            removed++;
+        }
+    }
+    return removed;
+}
+
+std::string FileIO::readCompressedTextFile(const std::string& filePath) {
+    if (!isInitialized) {
+        initialize();
+    }
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+
+    LzDecoder decoder(file);
+    std::string content;
+    std::string chunk;
+    while (decoder.read(chunk)) {
+        content += chunk;
+    }
+
+    if (!decoder.getLastError().empty()) {
+        throw std::runtime_error("Error reading compressed file " + filePath + ": " + decoder.getLastError());
+    }
+    return content;
+}
+
+void FileIO::writeCompressedTextFile(const std::string& filePath, const std::string& content) {
+    if (!isInitialized) {
+        initialize();
+    }
+
+    size_t lastSlash = filePath.find_last_of("/\\");
+    if (lastSlash != std::string::npos) {
+        std::string directory = filePath.substr(0, lastSlash);
+        if (!directory.empty() && !directoryExists(directory)) {
+            createDirectory(directory);
+        }
+    }
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filePath);
+    }
+
+    LzEncoder encoder(file);
+    encoder.write(content);
+    encoder.finish();
+
+    if (!file) {
+        throw std::runtime_error("Error writing compressed file " + filePath);
+    }
+}
+
 bool FileIO::platformDirectoryExists(const std::string& directory) {
 #ifdef _WIN32
     DWORD fileAttributes = GetFileAttributesA(directory.c_str());
@@ -285,8 +557,18 @@ std::string FileIO::getFileName(const std::string& filePath) {
     }
     return filePath.substr(lastSlash + 1);
 }
+
+void FileIO::setLogFile(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(logMutex());
+    logFilePath() = filePath;
+}
+
 void FileIO::appendToLog(const std::string& message) {
-    std::ofstream logFile("log.txt", std::ios::app);
+    std::lock_guard<std::mutex> lock(logMutex());
+    if (logFilePath().empty()) {
+        return;
+    }
+    std::ofstream logFile(logFilePath(), std::ios::app);
     if (logFile.is_open()) {
         logFile << message << std::endl;
         logFile.close();
@@ -294,7 +576,11 @@ void FileIO::appendToLog(const std::string& message) {
 }
 
 void FileIO::clearLog() {
-    std::ofstream logFile("log.txt", std::ios::trunc);
+    std::lock_guard<std::mutex> lock(logMutex());
+    if (logFilePath().empty()) {
+        return;
+    }
+    std::ofstream logFile(logFilePath(), std::ios::trunc);
     if (logFile.is_open()) {
         logFile.close();
     }
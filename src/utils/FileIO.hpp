@@ -2,11 +2,20 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 #include <stdexcept>
 #include <nlohmann/json.hpp>
 
 namespace StockMarketSimulator {
 
+// How far an atomic write goes before it returns. Every level replaces the
+// target via rename, so readers see either the old or the new contents.
+enum class Durability {
+    Atomic,   // survives a crash of the process, not of the machine
+    Data,     // contents are flushed to disk before the rename
+    Full      // the rename itself is flushed by syncing the directory
+};
+
 class FileIO {
 private:
     static bool isInitialized;
@@ -25,6 +34,22 @@ public:
     static std::string readTextFile(const std::string& filePath);
     static void writeTextFile(const std::string& filePath, const std::string& content);
 
+    // LZ-compressed counterparts of the text helpers; see LzEncoder.
+    static std::string readCompressedTextFile(const std::string& filePath);
+    static void writeCompressedTextFile(const std::string& filePath, const std::string& content);
+
+    // Each file is written to a uniquely named temporary sibling in a single
+    // write and renamed over its target, in the order given. Every file gets
+    // its own data sync; directories are synced once per batch.
+    static void writeFilesAtomically(const std::vector<std::pair<std::string, std::string>>& files,
+                                     Durability durability = Durability::Full);
+    static void writeFileAtomically(const std::string& filePath, const std::string& content,
+                                    Durability durability = Durability::Full);
+    // Deletes temporaries a crash left behind in directory and returns how
+    // many were removed. Files modified within the last minimumAgeSeconds are
+    // kept, since a writer may still be about to rename them.
+    static size_t removeTemporaryFiles(const std::string& directory, int minimumAgeSeconds = 0);
+
     static std::vector<std::string> listFiles(const std::string& directory, const std::string& extension = "");
     static void createDirectory(const std::string& directory);
     static bool directoryExists(const std::string& directory);
@@ -35,6 +60,9 @@ public:
     static std::string combineFilePath(const std::string& directory, const std::string& filename);
     static std::string getFileExtension(const std::string& filePath);
     static std::string getFileName(const std::string& filePath);
+    // Defaults to log.txt in the working directory; an empty path turns
+    // logging off.
+    static void setLogFile(const std::string& filePath);
     static void appendToLog(const std::string& message);
     static void clearLog();
 };
@@ -0,0 +1,141 @@
+#include "JsonStreamReader.hpp"
+#include <fstream>
+
+namespace StockMarketSimulator {
+
+using json = nlohmann::json;
+
+class JsonStreamReader::Consumer : public nlohmann::json_sax<json> {
+private:
+    const std::vector<Route>& routes;
+    std::vector<Frame> stack;
+    std::vector<std::string> path;
+    json& root;
+    std::string& error;
+
+    const Route* match() const {
+        for (const auto& route : routes) {
+            if (route.path.size() != path.size()) {
+                continue;
+            }
+
+            bool matches = true;
+            for (size_t i = 0; i < path.size() && matches; ++i) {
+                matches = route.path[i] == "*" ? path[i] == "*" : route.path[i] == path[i];
+            }
+            if (matches) {
+                return &route;
+            }
+        }
+        return nullptr;
+    }
+
+    // Position of the value about to be emitted, relative to its parent.
+    void enterValue() {
+        if (stack.empty()) {
+            return;
+        }
+        path.push_back(stack.back().value.is_array() ? "*" : stack.back().key);
+    }
+
+    bool emit(json value) {
+        if (const Route* route = match()) {
+            route->handler(value);
+        } else if (stack.empty()) {
+            root = std::move(value);
+        } else if (stack.back().value.is_array()) {
+            stack.back().value.push_back(std::move(value));
+        } else {
+            stack.back().value[stack.back().key] = std::move(value);
+        }
+
+        if (!stack.empty()) {
+            path.pop_back();
+        }
+        return true;
+    }
+
+    bool scalar(json value) {
+        enterValue();
+        return emit(std::move(value));
+    }
+
+    bool open(json container) {
+        enterValue();
+        stack.push_back({std::move(container), std::string()});
+        return true;
+    }
+
+    bool close() {
+        json value = std::move(stack.back().value);
+        stack.pop_back();
+        return emit(std::move(value));
+    }
+
+public:
+    Consumer(const std::vector<Route>& routes, json& root, std::string& error)
+        : routes(routes), root(root), error(error)
+    {
+    }
+
+    bool null() override { return scalar(nullptr); }
+    bool boolean(bool value) override { return scalar(value); }
+    bool number_integer(number_integer_t value) override { return scalar(value); }
+    bool number_unsigned(number_unsigned_t value) override { return scalar(value); }
+    bool number_float(number_float_t value, const string_t&) override { return scalar(value); }
+    bool string(string_t& value) override { return scalar(std::move(value)); }
+    bool binary(binary_t& value) override { return scalar(json::binary(std::move(value))); }
+
+    bool start_object(std::size_t) override { return open(json::object()); }
+    bool end_object() override { return close(); }
+    bool start_array(std::size_t) override { return open(json::array()); }
+    bool end_array() override { return close(); }
+
+    bool key(string_t& value) override {
+        stack.back().key = std::move(value);
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& exception) override {
+        error = exception.what();
+        return false;
+    }
+};
+
+void JsonStreamReader::onValue(std::vector<std::string> path, Handler handler) {
+    routes.push_back({std::move(path), std::move(handler)});
+}
+
+bool JsonStreamReader::parse(std::istream& input, json& remainder) {
+    lastError.clear();
+    remainder = json();
+
+    Consumer consumer(routes, remainder, lastError);
+    try {
+        if (!json::sax_parse(input, &consumer)) {
+            if (lastError.empty()) {
+                lastError = "JSON parse failed";
+            }
+            return false;
+        }
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return false;
+    }
+    return true;
+}
+
+bool JsonStreamReader::parseFile(const std::string& filePath, json& remainder) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        lastError = "Failed to open file: " + filePath;
+        return false;
+    }
+    return parse(file, remainder);
+}
+
+std::string JsonStreamReader::getLastError() const {
+    return lastError;
+}
+
+}
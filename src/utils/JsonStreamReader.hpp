@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace StockMarketSimulator {
+
+// SAX-driven reader that assembles a document but hands selected values to
+// handlers as soon as each one is complete. A consumed value never joins the
+// document, so large arrays are converted element by element instead of
+// being held as a DOM next to the objects built from them.
+class JsonStreamReader {
+public:
+    using Handler = std::function<void(nlohmann::json& value)>;
+
+private:
+    struct Route {
+        std::vector<std::string> path;
+        Handler handler;
+    };
+
+    struct Frame {
+        nlohmann::json value;
+        std::string key;
+    };
+
+    class Consumer;
+
+    std::vector<Route> routes;
+    std::string lastError;
+
+public:
+    // Path segments are object keys; "*" matches any array element.
+    void onValue(std::vector<std::string> path, Handler handler);
+
+    // Parses the input, invoking handlers along the way. Whatever no handler
+    // consumed is left in remainder.
+    bool parse(std::istream& input, nlohmann::json& remainder);
+    bool parseFile(const std::string& filePath, nlohmann::json& remainder);
+
+    std::string getLastError() const;
+};
+
+}
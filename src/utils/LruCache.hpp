@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstddef>
+
+namespace StockMarketSimulator {
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct Entry {
+        Key key;
+        Value value;
+        size_t prev;
+        size_t next;
+    };
+
+    size_t capacity;
+    std::vector<Entry> entries;
+    std::unordered_map<Key, size_t, Hash> index;
+    size_t head;
+    size_t tail;
+
+    void unlink(size_t slot) {
+        Entry& entry = entries[slot];
+
+        if (entry.prev != npos) {
+            entries[entry.prev].next = entry.next;
+        } else {
+            head = entry.next;
+        }
+
+        if (entry.next != npos) {
+            entries[entry.next].prev = entry.prev;
+        } else {
+            tail = entry.prev;
+        }
+    }
+
+    void pushFront(size_t slot) {
+        entries[slot].prev = npos;
+        entries[slot].next = head;
+
+        if (head != npos) {
+            entries[head].prev = slot;
+        }
+
+        head = slot;
+
+        if (tail == npos) {
+            tail = slot;
+        }
+    }
+
+public:
+    explicit LruCache(size_t capacity = 64)
+        : capacity(capacity > 0 ? capacity : 1),
+          head(npos),
+          tail(npos)
+    {
+        entries.reserve(this->capacity);
+        index.reserve(this->capacity);
+    }
+
+    const Value* find(const Key& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+
+        size_t slot = it->second;
+        if (slot != head) {
+            unlink(slot);
+            pushFront(slot);
+        }
+
+        return &entries[slot].value;
+    }
+
+    const Value& insert(const Key& key, Value value) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            size_t slot = it->second;
+            entries[slot].value = std::move(value);
+            if (slot != head) {
+                unlink(slot);
+                pushFront(slot);
+            }
+            return entries[slot].value;
+        }
+
+        size_t slot;
+        if (entries.size() < capacity) {
+            slot = entries.size();
+            entries.push_back(Entry{key, std::move(value), npos, npos});
+        } else {
+            slot = tail;
+            unlink(slot);
+            index.erase(entries[slot].key);
+            entries[slot].key = key;
+            entries[slot].value = std::move(value);
+        }
+
+        index[key] = slot;
+        pushFront(slot);
+
+        return entries[slot].value;
+    }
+
+    void clear() {
+        entries.clear();
+        index.clear();
+        head = npos;
+        tail = npos;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
+
+}
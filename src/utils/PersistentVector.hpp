@@ -0,0 +1,182 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+#include <initializer_list>
+
+namespace StockMarketSimulator {
+
+// Append-mostly sequence stored as fixed-size chunks behind shared pointers.
+// Copying is O(1); the first write after a copy duplicates the chunk list and
+// the one chunk being written, so branches of a history only pay for the
+// entries they change.
+template<typename T, size_t ChunkSize = 64>
+class PersistentVector {
+private:
+    static_assert(ChunkSize > 0, "ChunkSize must be positive");
+
+    using Chunk = std::vector<T>;
+    using ChunkList = std::vector<std::shared_ptr<Chunk>>;
+
+    std::shared_ptr<ChunkList> chunks;
+    size_t offset;
+    size_t count;
+
+    ChunkList& ownChunks() {
+        if (!chunks) {
+            chunks = std::make_shared<ChunkList>();
+        } else if (chunks.use_count() > 1) {
+            chunks = std::make_shared<ChunkList>(*chunks);
+        }
+        return *chunks;
+    }
+
+    Chunk& ownChunk(size_t chunkIndex) {
+        auto& list = ownChunks();
+        auto& chunk = list[chunkIndex];
+        if (chunk.use_count() > 1) {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+        return *chunk;
+    }
+
+public:
+    class const_iterator {
+    private:
+        const PersistentVector* owner;
+        size_t position;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : owner(nullptr), position(0) {}
+        const_iterator(const PersistentVector* owner, size_t position) : owner(owner), position(position) {}
+
+        reference operator*() const { return (*owner)[position]; }
+        pointer operator->() const { return &(*owner)[position]; }
+        reference operator[](difference_type n) const { return (*owner)[position + n]; }
+
+        const_iterator& operator++() { ++position; return *this; }
+        const_iterator operator++(int) { const_iterator copy = *this; ++position; return copy; }
+        const_iterator& operator--() { --position; return *this; }
+        const_iterator operator--(int) { const_iterator copy = *this; --position; return copy; }
+        const_iterator& operator+=(difference_type n) { position += n; return *this; }
+        const_iterator& operator-=(difference_type n) { position -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(owner, position + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(owner, position - n); }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(position) - static_cast<difference_type>(other.position);
+        }
+
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+        bool operator<(const const_iterator& other) const { return position < other.position; }
+        bool operator>(const const_iterator& other) const { return position > other.position; }
+        bool operator<=(const const_iterator& other) const { return position <= other.position; }
+        bool operator>=(const const_iterator& other) const { return position >= other.position; }
+    };
+
+    PersistentVector() : offset(0), count(0) {}
+
+    PersistentVector(const std::vector<T>& values) : PersistentVector() {
+        for (const auto& value : values) {
+            push_back(value);
+        }
+    }
+
+    PersistentVector(std::initializer_list<T> values) : PersistentVector() {
+        for (const auto& value : values) {
+            push_back(value);
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    const T& operator[](size_t index) const {
+        size_t position = offset + index;
+        return (*(*chunks)[position / ChunkSize])[position % ChunkSize];
+    }
+
+    const T& front() const {
+        return (*this)[0];
+    }
+
+    const T& back() const {
+        return (*this)[count - 1];
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, count);
+    }
+
+    // Writable access to one entry; copies its chunk first if it is shared.
+    T& mutate(size_t index) {
+        size_t position = offset + index;
+        return ownChunk(position / ChunkSize)[position % ChunkSize];
+    }
+
+    void push_back(const T& value) {
+        auto& list = ownChunks();
+        size_t position = offset + count;
+        if (position / ChunkSize == list.size()) {
+            list.push_back(std::make_shared<Chunk>());
+            list.back()->reserve(ChunkSize);
+        }
+        ownChunk(position / ChunkSize).push_back(value);
+        ++count;
+    }
+
+    // Drops the oldest entries; whole chunks are released once passed.
+    void dropFront(size_t n) {
+        if (n >= count) {
+            clear();
+            return;
+        }
+
+        offset += n;
+        count -= n;
+
+        size_t passed = offset / ChunkSize;
+        if (passed > 0) {
+            auto& list = ownChunks();
+            list.erase(list.begin(), list.begin() + passed);
+            offset %= ChunkSize;
+        }
+    }
+
+    void clear() {
+        chunks.reset();
+        offset = 0;
+        count = 0;
+    }
+
+    std::vector<T> toVector() const {
+        return std::vector<T>(begin(), end());
+    }
+
+    // True when both sequences still reference the chunk holding entry index.
+    bool sharesChunkWith(const PersistentVector& other, size_t index) const {
+        if (index >= count || index >= other.count) {
+            return false;
+        }
+        return &(*this)[index] == &other[index];
+    }
+};
+
+}
@@ -0,0 +1,154 @@
+#include "Profiler.hpp"
+#include "FileIO.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace StockMarketSimulator {
+
+std::mutex Profiler::mutex;
+std::map<std::string, TimingHistogram, std::less<>> Profiler::histograms;
+
+TimingHistogram::TimingHistogram()
+    : count(0),
+      totalNanoseconds(0),
+      minNanoseconds(std::numeric_limits<uint64_t>::max()),
+      maxNanoseconds(0)
+{
+    buckets.fill(0);
+}
+
+void TimingHistogram::record(uint64_t nanoseconds) {
+    size_t bucket = 0;
+    while (bucket + 1 < BUCKET_COUNT && (nanoseconds >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+
+    buckets[bucket]++;
+    count++;
+    totalNanoseconds += nanoseconds;
+    minNanoseconds = std::min(minNanoseconds, nanoseconds);
+    maxNanoseconds = std::max(maxNanoseconds, nanoseconds);
+}
+
+double TimingHistogram::getMeanNanoseconds() const {
+    return (count > 0) ? static_cast<double>(totalNanoseconds) / count : 0.0;
+}
+
+uint64_t TimingHistogram::getPercentileNanoseconds(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(percentile * count);
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen > target) {
+            return std::min(maxNanoseconds, (uint64_t(2) << i) - 1);
+        }
+    }
+
+    return maxNanoseconds;
+}
+
+nlohmann::json TimingHistogram::toJson() const {
+    nlohmann::json j;
+    j["count"] = count;
+    j["total_ns"] = totalNanoseconds;
+    j["mean_ns"] = getMeanNanoseconds();
+    j["min_ns"] = (count > 0) ? minNanoseconds : 0;
+    j["max_ns"] = maxNanoseconds;
+    j["p50_ns"] = getPercentileNanoseconds(0.5);
+    j["p99_ns"] = getPercentileNanoseconds(0.99);
+
+    size_t last = BUCKET_COUNT;
+    while (last > 0 && buckets[last - 1] == 0) {
+        last--;
+    }
+    j["log2_buckets"] = std::vector<uint64_t>(buckets.begin(), buckets.begin() + last);
+
+    return j;
+}
+
+void Profiler::record(const char* name, uint64_t nanoseconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = histograms.find(name);
+    if (it == histograms.end()) {
+        it = histograms.emplace(name, TimingHistogram()).first;
+    }
+
+    it->second.record(nanoseconds);
+}
+
+std::map<std::string, TimingHistogram, std::less<>> Profiler::snapshot() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return histograms;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    histograms.clear();
+}
+
+std::string Profiler::report() {
+    auto current = snapshot();
+
+    std::stringstream ss;
+    ss << std::left << std::setw(28) << "Stage"
+       << std::right << std::setw(10) << "Count"
+       << std::setw(14) << "Total ms"
+       << std::setw(12) << "Mean us"
+       << std::setw(12) << "p50 us"
+       << std::setw(12) << "p99 us"
+       << std::setw(12) << "Max us" << "\n";
+
+    ss << std::fixed << std::setprecision(2);
+    for (const auto& [name, histogram] : current) {
+        ss << std::left << std::setw(28) << name
+           << std::right << std::setw(10) << histogram.count
+           << std::setw(14) << histogram.totalNanoseconds / 1e6
+           << std::setw(12) << histogram.getMeanNanoseconds() / 1e3
+           << std::setw(12) << histogram.getPercentileNanoseconds(0.5) / 1e3
+           << std::setw(12) << histogram.getPercentileNanoseconds(0.99) / 1e3
+           << std::setw(12) << histogram.maxNanoseconds / 1e3 << "\n";
+    }
+
+    return ss.str();
+}
+
+nlohmann::json Profiler::toJson() {
+    nlohmann::json j = nlohmann::json::object();
+
+    for (const auto& [name, histogram] : snapshot()) {
+        j[name] = histogram.toJson();
+    }
+
+    return j;
+}
+
+bool Profiler::writeJson(const std::string& filePath) {
+    try {
+        FileIO::writeJsonFile(filePath, toJson(), true);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+ScopedTimer::ScopedTimer(const char* name)
+    : name(name),
+      start(std::chrono::steady_clock::now())
+{
+}
+
+ScopedTimer::~ScopedTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Profiler::record(name, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "AllocationTracker.hpp"
+
+namespace StockMarketSimulator {
+
+struct TimingHistogram {
+    static constexpr size_t BUCKET_COUNT = 48;
+
+    uint64_t count;
+    uint64_t totalNanoseconds;
+    uint64_t minNanoseconds;
+    uint64_t maxNanoseconds;
+    std::array<uint64_t, BUCKET_COUNT> buckets;
+
+    TimingHistogram();
+
+    void record(uint64_t nanoseconds);
+    double getMeanNanoseconds() const;
+    uint64_t getPercentileNanoseconds(double percentile) const;
+
+    nlohmann::json toJson() const;
+};
+
+class Profiler {
+private:
+    static std::mutex mutex;
+    static std::map<std::string, TimingHistogram, std::less<>> histograms;
+
+public:
+    static void record(const char* name, uint64_t nanoseconds);
+    static std::map<std::string, TimingHistogram, std::less<>> snapshot();
+    static void reset();
+
+    static std::string report();
+    static nlohmann::json toJson();
+    static bool writeJson(const std::string& filePath);
+};
+
+class ScopedTimer {
+private:
+    const char* name;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(const char* name);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// Times a scope and attributes its allocations to it, for whichever of the two
+// is compiled in. SMP_PROFILE_SCOPE declares one of these.
+class ProfileScope {
+private:
+#ifdef SMP_PROFILING
+    ScopedTimer timer;
+#endif
+#ifdef SMP_ALLOCATION_TRACKING
+    AllocationScope allocations;
+#endif
+
+public:
+    ProfileScope([[maybe_unused]] const char* name, [[maybe_unused]] size_t tag)
+#if defined(SMP_PROFILING) && defined(SMP_ALLOCATION_TRACKING)
+        : timer(name), allocations(tag)
+#elif defined(SMP_PROFILING)
+        : timer(name)
+#elif defined(SMP_ALLOCATION_TRACKING)
+        : allocations(tag)
+#endif
+    {
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+}
+
+#define SMP_PROFILE_CONCAT_INNER(a, b) a##b
+#define SMP_PROFILE_CONCAT(a, b) SMP_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef SMP_ALLOCATION_TRACKING
+#define SMP_PROFILE_TAG(name) \
+    [] { \
+        static const size_t tag = ::StockMarketSimulator::AllocationTracker::registerTag(name); \
+        return tag; \
+    }()
+#else
+#define SMP_PROFILE_TAG(name) ::StockMarketSimulator::AllocationTracker::UNTAGGED
+#endif
+
+#if defined(SMP_PROFILING) || defined(SMP_ALLOCATION_TRACKING)
+#define SMP_PROFILE_SCOPE(name) \
+    ::StockMarketSimulator::ProfileScope SMP_PROFILE_CONCAT(profileScope, __LINE__)(name, SMP_PROFILE_TAG(name))
+#else
+#define SMP_PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -1,43 +1,76 @@
 #include "Random.hpp"
+#include <sstream>
 
 namespace StockMarketSimulator {
 
     std::mt19937 Random::generator;
     bool Random::isInitialized = false;
+    thread_local std::mt19937* Random::threadGenerator = nullptr;
+
+    Random::ScopedGenerator::ScopedGenerator(unsigned int seed)
+        : generator(seed),
+          previous(threadGenerator)
+    {
+        threadGenerator = &generator;
+    }
+
+    Random::ScopedGenerator::~ScopedGenerator() {
+        threadGenerator = previous;
+    }
+
+    std::mt19937& Random::engine() {
+        if (threadGenerator) {
+            return *threadGenerator;
+        }
+
+        if (!isInitialized) {
+            initialize();
+        }
+        return generator;
+    }
 
     void Random::initialize(unsigned int seed) {
         generator.seed(seed);
         isInitialized = true;
     }
 
-    int Random::getInt(int min, int max) {
-        if (!isInitialized) {
-            initialize();
+    std::string Random::getState() {
+        std::ostringstream out;
+        out << engine();
+        return out.str();
+    }
+
+    bool Random::setState(const std::string& state) {
+        std::istringstream in(state);
+        std::mt19937 restored;
+        in >> restored;
+        if (in.fail()) {
+            return false;
+        }
+
+        engine() = restored;
+        if (!threadGenerator) {
+            isInitialized = true;
         }
+        return true;
+    }
 
+    int Random::getInt(int min, int max) {
         std::uniform_int_distribution<int> distribution(min, max);
-        return distribution(generator);
+        return distribution(engine());
     }
 
     double Random::getDouble(double min, double max) {
-        if (!isInitialized) {
-            initialize();
-        }
-
         std::uniform_real_distribution<double> distribution(min, max);
-        return distribution(generator);
+        return distribution(engine());
     }
 
     bool Random::getBool(double probability) {
-        if (!isInitialized) {
-            initialize();
-        }
-
         if (probability <= 0.0) return false;
         if (probability >= 1.0) return true;
 
         std::bernoulli_distribution distribution(probability);
-        return distribution(generator);
+        return distribution(engine());
     }
 
     size_t Random::getIndex(size_t size) {
@@ -45,21 +78,13 @@ namespace StockMarketSimulator {
             throw std::runtime_error("Cannot generate index for size 0");
         }
 
-        if (!isInitialized) {
-            initialize();
-        }
-
         std::uniform_int_distribution<size_t> distribution(0, size - 1);
-        return distribution(generator);
+        return distribution(engine());
     }
 
     double Random::getNormal(double mean, double stdDev) {
-        if (!isInitialized) {
-            initialize();
-        }
-
         std::normal_distribution<double> distribution(mean, stdDev);
-        return distribution(generator);
+        return distribution(engine());
     }
 
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <random>
+#include <string>
 #include <ctime>
 #include <vector>
 #include <stdexcept>
@@ -14,9 +15,32 @@ private:
 
     static bool isInitialized;
 
+    static thread_local std::mt19937* threadGenerator;
+
+    static std::mt19937& engine();
+
 public:
+    // Routes this thread's draws to a private generator while in scope, so
+    // independent simulations can run on separate threads reproducibly.
+    class ScopedGenerator {
+    private:
+        std::mt19937 generator;
+        std::mt19937* previous;
+
+    public:
+        explicit ScopedGenerator(unsigned int seed);
+        ~ScopedGenerator();
+
+        ScopedGenerator(const ScopedGenerator&) = delete;
+        ScopedGenerator& operator=(const ScopedGenerator&) = delete;
+    };
+
     static void initialize(unsigned int seed = static_cast<unsigned int>(std::time(nullptr)));
 
+    // Serialized generator state of the calling thread, for exact replays.
+    static std::string getState();
+    static bool setState(const std::string& state);
+
     static int getInt(int min, int max);
 
     static double getDouble(double min, double max);
@@ -29,12 +53,8 @@ public:
             throw std::runtime_error("Cannot select from an empty vector");
         }
 
-        if (!isInitialized) {
-            initialize();
-        }
-
         std::uniform_int_distribution<size_t> distribution(0, items.size() - 1);
-        return items[distribution(generator)];
+        return items[distribution(engine())];
     }
 
     template<typename T>
@@ -43,12 +63,8 @@ public:
             throw std::runtime_error("Invalid input for weighted random selection");
         }
 
-        if (!isInitialized) {
-            initialize();
-        }
-
         std::discrete_distribution<size_t> distribution(weights.begin(), weights.end());
-        return items[distribution(generator)];
+        return items[distribution(engine())];
     }
 
     static size_t getIndex(size_t size);
@@ -57,11 +73,7 @@ public:
 
     template<typename T>
     static void shuffle(std::vector<T>& items) {
-        if (!isInitialized) {
-            initialize();
-        }
-
-        std::shuffle(items.begin(), items.end(), generator);
+        std::shuffle(items.begin(), items.end(), engine());
     }
 };
 
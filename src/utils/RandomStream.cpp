@@ -0,0 +1,29 @@
+#include "RandomStream.hpp"
+
+namespace StockMarketSimulator {
+
+static uint64_t mixBits(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+RandomStream RandomStream::derive(uint64_t seed, uint64_t day, uint64_t key, uint64_t stage) {
+    uint64_t state = mixBits(seed);
+    state = mixBits(state ^ day);
+    state = mixBits(state ^ key);
+    state = mixBits(state ^ stage);
+    return RandomStream(state);
+}
+
+uint64_t RandomStream::keyFor(const std::string& name) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace StockMarketSimulator {
+
+class RandomStream {
+private:
+    uint64_t state;
+
+public:
+    using result_type = uint64_t;
+
+    explicit RandomStream(uint64_t seed = 0) : state(seed) {}
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double getNormal(double mean, double stdDev) {
+        std::normal_distribution<double> distribution(mean, stdDev);
+        return distribution(*this);
+    }
+
+    static RandomStream derive(uint64_t seed, uint64_t day, uint64_t key, uint64_t stage = 0);
+    static uint64_t keyFor(const std::string& name);
+};
+
+}
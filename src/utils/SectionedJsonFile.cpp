@@ -0,0 +1,230 @@
+#include "SectionedJsonFile.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+const std::string HEADER_KEY = "{\"section_toc_offset\":\"";
+const size_t OFFSET_DIGITS = 16;
+const size_t HEADER_LENGTH = HEADER_KEY.size() + OFFSET_DIGITS + 1;
+
+std::string formatOffset(size_t offset) {
+    char digits[OFFSET_DIGITS + 1];
+    std::snprintf(digits, sizeof(digits), "%016zu", offset);
+    return digits;
+}
+
+bool fileSize(int fd, size_t& size) {
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+bool readBytes(int fd, size_t offset, size_t length, std::string& bytes) {
+    if (length == std::string::npos) {
+        size_t size = 0;
+        if (!fileSize(fd, size) || size < offset) {
+            return false;
+        }
+        length = size - offset;
+    }
+
+    bytes.resize(length);
+    size_t done = 0;
+    while (done < length) {
+        ssize_t count = pread(fd, &bytes[done], length - done, static_cast<off_t>(offset + done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+}
+
+SectionedJsonWriter::SectionedJsonWriter()
+    : arrayEmpty(true)
+{
+}
+
+void SectionedJsonWriter::beginKey(const std::string& key) {
+    body += ",\n";
+    body += nlohmann::json(key).dump();
+    body += ":";
+}
+
+JsonSection SectionedJsonWriter::appendValue(const nlohmann::json& value) {
+    JsonSection section{HEADER_LENGTH + body.size(), 0};
+    body += value.dump();
+    section.length = HEADER_LENGTH + body.size() - section.offset;
+    return section;
+}
+
+void SectionedJsonWriter::addSection(const std::string& name, const nlohmann::json& value) {
+    beginKey(name);
+    toc[name] = appendValue(value);
+}
+
+void SectionedJsonWriter::beginArray(const std::string& name) {
+    beginKey(name);
+    toc[name] = JsonSection{HEADER_LENGTH + body.size(), 0};
+    body += "[";
+    openArray = name;
+    arrayEmpty = true;
+}
+
+void SectionedJsonWriter::addElement(const std::string& elementName, const nlohmann::json& value) {
+    body += arrayEmpty ? "\n" : ",\n";
+    arrayEmpty = false;
+    toc[openArray + "/" + elementName] = appendValue(value);
+}
+
+void SectionedJsonWriter::endArray() {
+    body += "]";
+    JsonSection& section = toc[openArray];
+    section.length = HEADER_LENGTH + body.size() - section.offset;
+    openArray.clear();
+}
+
+std::string SectionedJsonWriter::finish() const {
+    nlohmann::json table = nlohmann::json::object();
+    for (const auto& entry : toc) {
+        table[entry.first] = {entry.second.offset, entry.second.length};
+    }
+
+    std::string tocPrefix = ",\n\"section_toc\":";
+    size_t tocOffset = HEADER_LENGTH + body.size() + tocPrefix.size();
+
+    return HEADER_KEY + formatOffset(tocOffset) + "\"" + body + tocPrefix + table.dump() + "}\n";
+}
+
+SectionedJsonReader::SectionedJsonReader()
+    : fd(-1)
+{
+}
+
+SectionedJsonReader::~SectionedJsonReader() {
+    close();
+}
+
+void SectionedJsonReader::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool SectionedJsonReader::open(const std::string& filePath) {
+    close();
+    this->filePath = filePath;
+    toc.clear();
+    lastError.clear();
+
+    fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    std::string header;
+    if (fd < 0 || !readBytes(fd, 0, HEADER_LENGTH, header) ||
+        header.compare(0, HEADER_KEY.size(), HEADER_KEY) != 0) {
+        close();
+        lastError = "Not a sectioned file: " + filePath;
+        return false;
+    }
+
+    try {
+        size_t tocOffset = std::stoull(header.substr(HEADER_KEY.size(), OFFSET_DIGITS));
+
+        std::string tail;
+        if (!readBytes(fd, tocOffset, std::string::npos, tail)) {
+            close();
+            lastError = "Truncated table of contents: " + filePath;
+            return false;
+        }
+
+        // The table is the last value; drop the brace that closes the file.
+        size_t brace = tail.find_last_of('}');
+        if (brace == std::string::npos) {
+            close();
+            lastError = "Truncated table of contents: " + filePath;
+            return false;
+        }
+
+        nlohmann::json table = nlohmann::json::parse(tail.substr(0, brace));
+        for (auto it = table.begin(); it != table.end(); ++it) {
+            JsonSection section{it.value()[0].get<size_t>(), it.value()[1].get<size_t>()};
+            if (section.offset > tocOffset || section.length > tocOffset - section.offset) {
+                toc.clear();
+                close();
+                lastError = "Section " + it.key() + " lies outside " + filePath;
+                return false;
+            }
+            toc[it.key()] = section;
+        }
+    } catch (const std::exception& e) {
+        toc.clear();
+        close();
+        lastError = "Damaged table of contents: " + std::string(e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool SectionedJsonReader::hasSection(const std::string& name) const {
+    return toc.find(name) != toc.end();
+}
+
+std::vector<std::string> SectionedJsonReader::getSectionNames() const {
+    std::vector<std::string> names;
+    for (const auto& entry : toc) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+bool SectionedJsonReader::readSection(const std::string& name, nlohmann::json& value) const {
+    auto it = toc.find(name);
+    if (it == toc.end()) {
+        return false;
+    }
+
+    std::string bytes;
+    if (fd < 0 || !readBytes(fd, it->second.offset, it->second.length, bytes)) {
+        return false;
+    }
+
+    value = nlohmann::json::parse(bytes, nullptr, false);
+    return !value.is_discarded();
+}
+
+std::string SectionedJsonReader::getFilePath() const {
+    return filePath;
+}
+
+std::string SectionedJsonReader::getLastError() const {
+    return lastError;
+}
+
+bool SectionedJsonReader::isSectioned(const std::string& filePath) {
+    int file = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return false;
+    }
+
+    std::string header;
+    bool sectioned = readBytes(file, 0, HEADER_KEY.size(), header) && header == HEADER_KEY;
+    ::close(file);
+    return sectioned;
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace StockMarketSimulator {
+
+struct JsonSection {
+    size_t offset;
+    size_t length;
+};
+
+// Writes a JSON object whose top-level values can be located without parsing
+// the rest of the file. The first key holds a fixed-width offset to a table of
+// contents stored as the last key, so the whole file stays ordinary JSON.
+//
+//   {"section_toc_offset":"0000000000004711",
+//   "market":{...},
+//   "price_histories":[
+//   {...},
+//   {...}],
+//   "section_toc":{"market":[24,1031],"price_histories/TCH":[1070,412],...}}
+class SectionedJsonWriter {
+private:
+    std::string body;
+    std::map<std::string, JsonSection> toc;
+    std::string openArray;
+    bool arrayEmpty;
+
+    void beginKey(const std::string& key);
+    JsonSection appendValue(const nlohmann::json& value);
+
+public:
+    SectionedJsonWriter();
+
+    // A section is one top-level value addressable by its key.
+    void addSection(const std::string& name, const nlohmann::json& value);
+
+    // Array sections get one table entry per element, named "array/element",
+    // plus an entry for the array as a whole.
+    void beginArray(const std::string& name);
+    void addElement(const std::string& elementName, const nlohmann::json& value);
+    void endArray();
+
+    std::string finish() const;
+};
+
+class SectionedJsonReader {
+private:
+    std::string filePath;
+    int fd;
+    std::map<std::string, JsonSection> toc;
+    std::string lastError;
+
+    void close();
+
+public:
+    SectionedJsonReader();
+    ~SectionedJsonReader();
+
+    SectionedJsonReader(const SectionedJsonReader&) = delete;
+    SectionedJsonReader& operator=(const SectionedJsonReader&) = delete;
+
+    // Reads only the fixed header and the table of contents, and checks that
+    // every section lies within the file. Fails for files that are not
+    // sectioned, which callers use to fall back to a full parse. The file
+    // stays open, so sections read later come from the same file even if the
+    // path is deleted or replaced in the meantime.
+    bool open(const std::string& filePath);
+
+    bool hasSection(const std::string& name) const;
+    std::vector<std::string> getSectionNames() const;
+
+    // Parses a single section with positioned reads. Safe to call from
+    // several threads.
+    bool readSection(const std::string& name, nlohmann::json& value) const;
+
+    std::string getFilePath() const;
+    std::string getLastError() const;
+
+    static bool isSectioned(const std::string& filePath);
+};
+
+}
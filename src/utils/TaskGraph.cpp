@@ -0,0 +1,114 @@
+#include "TaskGraph.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace StockMarketSimulator {
+
+size_t TaskGraph::addTask(const std::string& name, std::function<void()> work,
+                          const std::vector<size_t>& dependencies) {
+    size_t index = tasks.size();
+
+    for (size_t dependency : dependencies) {
+        if (dependency >= index) {
+            throw std::invalid_argument("Task '" + name + "' depends on an unknown task");
+        }
+        tasks[dependency].dependents.push_back(index);
+    }
+
+    tasks.push_back({name, std::move(work), {}, dependencies.size()});
+    return index;
+}
+
+void TaskGraph::runTask(size_t index) {
+    auto start = std::chrono::steady_clock::now();
+
+    tasks[index].work();
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    timings[index].milliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+void TaskGraph::run(WorkStealingPool& pool) {
+    timings.assign(tasks.size(), StageTiming{});
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        timings[i].name = tasks[i].name;
+    }
+
+    std::unique_ptr<std::atomic<size_t>[]> pending(new std::atomic<size_t>[tasks.size()]);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        pending[i] = tasks[i].dependencyCount;
+    }
+
+    std::atomic<size_t> remaining(tasks.size());
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    std::function<void(size_t)> schedule = [&](size_t index) {
+        pool.submit([&, index] {
+            if (!failed) {
+                try {
+                    runTask(index);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+
+            for (size_t dependent : tasks[index].dependents) {
+                if (--pending[dependent] == 0) {
+                    schedule(dependent);
+                }
+            }
+
+            remaining--;
+        });
+    };
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].dependencyCount == 0) {
+            schedule(i);
+        }
+    }
+
+    while (remaining > 0) {
+        if (!pool.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskGraph::runSequential() {
+    timings.assign(tasks.size(), StageTiming{});
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        timings[i].name = tasks[i].name;
+        runTask(i);
+    }
+}
+
+const std::vector<StageTiming>& TaskGraph::getTimings() const {
+    return timings;
+}
+
+size_t TaskGraph::size() const {
+    return tasks.size();
+}
+
+void TaskGraph::clear() {
+    tasks.clear();
+    timings.clear();
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "WorkStealingPool.hpp"
+
+namespace StockMarketSimulator {
+
+struct StageTiming {
+    std::string name;
+    double milliseconds;
+};
+
+class TaskGraph {
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> work;
+        std::vector<size_t> dependents;
+        size_t dependencyCount;
+    };
+
+    std::vector<Task> tasks;
+    std::vector<StageTiming> timings;
+
+    void runTask(size_t index);
+
+public:
+    size_t addTask(const std::string& name, std::function<void()> work,
+                   const std::vector<size_t>& dependencies = {});
+
+    void run(WorkStealingPool& pool);
+    void runSequential();
+
+    const std::vector<StageTiming>& getTimings() const;
+    size_t size() const;
+    void clear();
+};
+
+}
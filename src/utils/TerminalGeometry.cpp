@@ -0,0 +1,88 @@
+#include "TerminalGeometry.hpp"
+#include "EventLoop.hpp"
+#include <csignal>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace StockMarketSimulator {
+
+std::atomic<int> TerminalGeometry::columns{DEFAULT_COLUMNS};
+std::atomic<int> TerminalGeometry::rows{DEFAULT_ROWS};
+std::atomic<bool> TerminalGeometry::cached{false};
+std::atomic<bool> TerminalGeometry::resizePending{false};
+bool TerminalGeometry::handlerInstalled = false;
+
+void TerminalGeometry::handleResizeSignal(int) {
+    notifyResize();
+}
+
+void TerminalGeometry::installResizeHandler() {
+#if !defined(_WIN32) && defined(SIGWINCH)
+    if (handlerInstalled) {
+        return;
+    }
+
+    struct sigaction action {};
+    action.sa_handler = &TerminalGeometry::handleResizeSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &action, nullptr);
+#endif
+    handlerInstalled = true;
+}
+
+std::pair<int, int> TerminalGeometry::getSize() {
+    if (!cached.load(std::memory_order_acquire)) {
+        refresh();
+    }
+    return {columns.load(std::memory_order_relaxed), rows.load(std::memory_order_relaxed)};
+}
+
+void TerminalGeometry::refresh() {
+    int width = DEFAULT_COLUMNS;
+    int height = DEFAULT_ROWS;
+
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (GetConsoleScreenBufferInfo(hOut, &csbi)) {
+        width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+        height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+    }
+#else
+    struct winsize w;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) != -1 && w.ws_col > 0 && w.ws_row > 0) {
+        width = w.ws_col;
+        height = w.ws_row;
+    }
+#endif
+
+    setSize(width, height);
+}
+
+void TerminalGeometry::setSize(int columns, int rows) {
+    TerminalGeometry::columns.store(columns > 0 ? columns : DEFAULT_COLUMNS, std::memory_order_relaxed);
+    TerminalGeometry::rows.store(rows > 0 ? rows : DEFAULT_ROWS, std::memory_order_relaxed);
+    cached.store(true, std::memory_order_release);
+}
+
+void TerminalGeometry::notifyResize() {
+    resizePending.store(true, std::memory_order_release);
+    EventLoop::signalWake();
+}
+
+bool TerminalGeometry::consumeResize() {
+    if (!resizePending.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    refresh();
+    return true;
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace StockMarketSimulator {
+
+class TerminalGeometry {
+private:
+    static std::atomic<int> columns;
+    static std::atomic<int> rows;
+    static std::atomic<bool> cached;
+    static std::atomic<bool> resizePending;
+    static bool handlerInstalled;
+
+    static void handleResizeSignal(int signal);
+
+public:
+    static constexpr int DEFAULT_COLUMNS = 80;
+    static constexpr int DEFAULT_ROWS = 24;
+
+    static void installResizeHandler();
+
+    static std::pair<int, int> getSize();
+    static void refresh();
+    static void setSize(int columns, int rows);
+
+    static void notifyResize();
+    static bool consumeResize();
+};
+
+}
@@ -0,0 +1,149 @@
+#include "UnixSocket.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace StockMarketSimulator {
+
+namespace {
+
+bool makeAddress(const std::string& path, sockaddr_un& address, std::string& error) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        error = "Invalid socket path: " + path;
+        return false;
+    }
+
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+}
+
+int UnixSocket::listen(const std::string& path, std::string& error) {
+    sockaddr_un address;
+    if (!makeAddress(path, address, error)) {
+        return -1;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error = "socket: " + std::string(std::strerror(errno));
+        return -1;
+    }
+
+    // Only a stale socket is replaced; a live listener keeps its path.
+    struct stat existing;
+    if (lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            error = "Refusing to replace " + path + ": not a socket";
+            ::close(fd);
+            return -1;
+        }
+
+        std::string probeError;
+        int probe = connect(path, probeError);
+        int probeErrno = errno;
+        if (probe >= 0) {
+            ::close(probe);
+            error = "Refusing to replace " + path + ": another process is listening on it";
+            ::close(fd);
+            return -1;
+        }
+        if (probeErrno != ECONNREFUSED) {
+            error = "Refusing to replace " + path + ": " + probeError;
+            ::close(fd);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0 ||
+        !setNonBlocking(fd)) {
+        error = "bind/listen " + path + ": " + std::string(std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return fd;
+}
+
+int UnixSocket::accept(int listenFd) {
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd >= 0) {
+        setNonBlocking(fd);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+        int enabled = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+    }
+    return fd;
+}
+
+int UnixSocket::connect(const std::string& path, std::string& error) {
+    sockaddr_un address;
+    if (!makeAddress(path, address, error)) {
+        return -1;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error = "socket: " + std::string(std::strerror(errno));
+        return -1;
+    }
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        error = "connect " + path + ": " + std::string(std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int enabled = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+    return fd;
+}
+
+bool UnixSocket::setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+ssize_t UnixSocket::send(int fd, const char* data, size_t size) {
+#ifdef MSG_NOSIGNAL
+    return ::send(fd, data, size, MSG_NOSIGNAL);
+#else
+    return ::send(fd, data, size, 0);
+#endif
+}
+
+ssize_t UnixSocket::receive(int fd, char* data, size_t size) {
+    return ::recv(fd, data, size, 0);
+}
+
+void UnixSocket::close(int fd) {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+// Only removes sockets, so a mistyped path never deletes a regular file.
+void UnixSocket::unlink(const std::string& path) {
+    struct stat existing;
+    if (lstat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        ::unlink(path.c_str());
+    }
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+
+namespace StockMarketSimulator {
+
+class UnixSocket {
+public:
+    static int listen(const std::string& path, std::string& error);
+    static int accept(int listenFd);
+    static int connect(const std::string& path, std::string& error);
+
+    static bool setNonBlocking(int fd);
+    static ssize_t send(int fd, const char* data, size_t size);
+    static ssize_t receive(int fd, char* data, size_t size);
+    static void close(int fd);
+    static void unlink(const std::string& path);
+};
+
+}
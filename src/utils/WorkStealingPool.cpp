@@ -0,0 +1,175 @@
+#include "WorkStealingPool.hpp"
+#include "AllocationTracker.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace StockMarketSimulator {
+
+static thread_local const WorkStealingPool* currentPool = nullptr;
+static thread_local size_t currentWorkerIndex = 0;
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : queuedTasks(0),
+      nextQueue(0),
+      stopping(false)
+{
+    size_t queueCount = std::max<size_t>(threadCount, 1);
+    for (size_t i = 0; i < queueCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t WorkStealingPool::currentQueue() {
+    if (currentPool == this) {
+        return currentWorkerIndex;
+    }
+
+    return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        queuedTasks++;
+    }
+
+    WorkerQueue& queue = *queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{std::move(task), AllocationTracker::getCurrentTag()});
+    }
+
+    wakeCondition.notify_one();
+}
+
+bool WorkStealingPool::popTask(size_t index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queuedTasks--;
+    return true;
+}
+
+bool WorkStealingPool::stealTask(size_t thief, Task& task) {
+    for (size_t offset = 1; offset <= queues.size(); ++offset) {
+        WorkerQueue& queue = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queuedTasks--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::runTask(Task& task) {
+    AllocationScope scope(task.allocationTag);
+    task.run();
+}
+
+bool WorkStealingPool::runPendingTask() {
+    size_t index = (currentPool == this) ? currentWorkerIndex : 0;
+
+    Task task;
+    if (popTask(index, task) || stealTask(index, task)) {
+        runTask(task);
+        return true;
+    }
+
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorkerIndex = index;
+
+    while (true) {
+        Task task;
+        if (popTask(index, task) || stealTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this] { return stopping || queuedTasks > 0; });
+
+        if (stopping && queuedTasks == 0) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::parallelFor(size_t begin, size_t end, size_t grainSize,
+                                   const std::function<void(size_t)>& body) {
+    if (begin >= end) {
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+
+    std::atomic<size_t> remaining(chunkCount);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        size_t chunkBegin = begin + chunk * grainSize;
+        size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+
+        submit([&, chunkBegin, chunkEnd] {
+            try {
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                    body(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            remaining--;
+        });
+    }
+
+    while (remaining > 0) {
+        if (!runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+size_t WorkStealingPool::getThreadCount() const {
+    return workers.size();
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace StockMarketSimulator {
+
+class WorkStealingPool {
+private:
+    // Tasks run under the allocation tag that was current when they were
+    // submitted, so per-stage counters include work done on the workers.
+    struct Task {
+        std::function<void()> run;
+        size_t allocationTag;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    std::atomic<size_t> queuedTasks;
+    std::atomic<size_t> nextQueue;
+    std::atomic<bool> stopping;
+
+    void workerLoop(size_t index);
+    bool popTask(size_t index, Task& task);
+    bool stealTask(size_t thief, Task& task);
+    static void runTask(Task& task);
+    size_t currentQueue();
+
+public:
+    explicit WorkStealingPool(size_t threadCount = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+    bool runPendingTask();
+
+    void parallelFor(size_t begin, size_t end, size_t grainSize,
+                     const std::function<void(size_t)>& body);
+
+    size_t getThreadCount() const;
+};
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include "../src/core/Game.hpp"
+#include "../src/utils/FileIO.hpp"
+
+namespace StockMarketSimulator {
+
+// A private saves directory under /tmp for game-driven tests. attach() points
+// a game's saves there and turns autosave off, so tests never write into the
+// working directory; the directory is removed on destruction.
+class ScopedSavesDirectory {
+private:
+    std::string directory;
+
+public:
+    ScopedSavesDirectory() {
+        char pattern[] = "/tmp/smp_test_saves_XXXXXX";
+        const char* created = mkdtemp(pattern);
+        directory = created ? created : "";
+    }
+
+    ~ScopedSavesDirectory() {
+        for (const auto& file : FileIO::listFiles(directory)) {
+            std::remove(FileIO::combineFilePath(directory, file).c_str());
+        }
+        rmdir(directory.c_str());
+    }
+
+    ScopedSavesDirectory(const ScopedSavesDirectory&) = delete;
+    ScopedSavesDirectory& operator=(const ScopedSavesDirectory&) = delete;
+
+    void attach(Game& game) const {
+        game.getSaveService()->initialize(directory);
+        game.getSaveService()->setAutosave(false);
+    }
+
+    const std::string& getPath() const {
+        return directory;
+    }
+};
+
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "../../src/core/Game.hpp"
+#include "../TestSupport.hpp"
+
+using namespace StockMarketSimulator;
+
+namespace {
+
+std::vector<double> closingPrices(const Game& game) {
+    std::vector<double> prices;
+    for (const auto& company : game.getMarket()->getCompanies()) {
+        prices.push_back(company->getStock()->getCurrentPrice());
+    }
+    return prices;
+}
+
+}
+
+TEST(CheckpointStoreTest, RewindRestoresRecordedDays) {
+    ScopedSavesDirectory saves;
+    for (bool parallel : {false, true}) {
+        Random::initialize(3);
+        auto game = std::make_shared<Game>();
+        game->initialize();
+        saves.attach(*game);
+        if (parallel) {
+            game->enableParallelMode(2, 17);
+        }
+        CheckpointOptions options;
+        options.interval = 4;
+        game->setCheckpointStore(std::make_shared<CheckpointStore>(options));
+        game->start();
+
+        std::vector<std::vector<double>> prices;
+        std::vector<double> cash;
+        std::vector<size_t> newsCounts;
+        for (int day = 1; day <= 10; ++day) {
+            if (day == 4) {
+                ASSERT_TRUE(game->buyStock("ITECH", 3));
+            }
+            ASSERT_TRUE(game->simulateDay());
+            prices.push_back(closingPrices(*game));
+            cash.push_back(game->getPlayer()->getPortfolio()->getCashBalance());
+            newsCounts.push_back(game->getNewsService()->getNewsHistory().size());
+        }
+
+        auto store = game->getCheckpointStore();
+        EXPECT_EQ(store->getCheckpointCount(), 3u);
+        EXPECT_EQ(store->getDeltaCount(), 7u);
+        EXPECT_EQ(store->getEarliestDay(), 1);
+        EXPECT_EQ(store->getLatestDay(), 10);
+        EXPECT_GT(store->getMemoryUsage(), 0u);
+
+        auto market = game->getMarket();
+        ASSERT_TRUE(game->rewindTo(7)) << game->getLastError();
+        EXPECT_EQ(game->getMarket(), market);
+        EXPECT_EQ(game->getSimulatedDays(), 7);
+        EXPECT_EQ(closingPrices(*game), prices[6]);
+        EXPECT_DOUBLE_EQ(game->getPlayer()->getPortfolio()->getCashBalance(), cash[6]);
+        EXPECT_EQ(game->getPlayer()->getPortfolio()->getPositionQuantity("ITECH"), 3);
+        EXPECT_EQ(game->getPlayer()->getPortfolio()->getPosition("ITECH")->company,
+                  game->getMarket()->getCompanyByTicker("ITECH"));
+        EXPECT_EQ(game->getNewsService()->getNewsHistory().size(), newsCounts[6]);
+        EXPECT_EQ(store->getLatestDay(), 7);
+
+        // The generator was restored too, so the original future repeats.
+        ASSERT_TRUE(game->simulateDays(3));
+        EXPECT_EQ(closingPrices(*game), prices[9]);
+
+        ASSERT_TRUE(game->rewindTo(2)) << game->getLastError();
+        EXPECT_EQ(closingPrices(*game), prices[1]);
+        EXPECT_EQ(game->getPlayer()->getPortfolio()->getPositionQuantity("ITECH"), 0);
+        EXPECT_FALSE(game->rewindTo(5));
+    }
+}
+
+TEST(CheckpointStoreTest, RewindRestoresStrategyAccounts) {
+    ScopedSavesDirectory saves;
+    Random::initialize(8);
+    auto game = std::make_shared<Game>();
+    game->initialize();
+    saves.attach(*game);
+    ASSERT_TRUE(game->addStrategyAccount("buy-and-hold", "Holder", 100000.0));
+    ASSERT_TRUE(game->addStrategyAccount("momentum", "Trader", 100000.0));
+    CheckpointOptions options;
+    options.interval = 4;
+    game->setCheckpointStore(std::make_shared<CheckpointStore>(options));
+    game->start();
+
+    const StrategyEngine& engine = game->getStrategyEngine();
+    std::vector<std::vector<double>> netWorths;
+    for (int day = 1; day <= 8; ++day) {
+        ASSERT_TRUE(game->simulateDay());
+        netWorths.push_back({engine.getPlayer(0)->getNetWorth(), engine.getPlayer(1)->getNetWorth()});
+    }
+    auto holder = engine.getPlayer(0);
+
+    ASSERT_TRUE(game->rewindTo(6)) << game->getLastError();
+    EXPECT_EQ(engine.getPlayer(0), holder);
+    EXPECT_EQ(engine.getStats(0).decisions, 6u);
+    EXPECT_DOUBLE_EQ(engine.getPlayer(0)->getNetWorth(), netWorths[5][0]);
+    EXPECT_DOUBLE_EQ(engine.getPlayer(1)->getNetWorth(), netWorths[5][1]);
+    for (const auto& entry : engine.getPlayer(0)->getPortfolio()->getPositions()) {
+        EXPECT_EQ(entry.second.company, game->getMarket()->getCompanyByTicker(entry.first));
+    }
+
+    ASSERT_TRUE(game->simulateDays(2));
+    EXPECT_DOUBLE_EQ(engine.getPlayer(0)->getNetWorth(), netWorths[7][0]);
+    EXPECT_DOUBLE_EQ(engine.getPlayer(1)->getNetWorth(), netWorths[7][1]);
+    EXPECT_EQ(engine.getStats(1).decisions, 8u);
+}
+
+TEST(CheckpointStoreTest, ChangesBetweenDaysStartNewCheckpoint) {
+    ScopedSavesDirectory saves;
+    Random::initialize(5);
+    auto game = std::make_shared<Game>();
+    game->initialize();
+    saves.attach(*game);
+    game->setCheckpointStore(std::make_shared<CheckpointStore>());
+    game->start();
+
+    ASSERT_TRUE(game->simulateDays(3));
+    EXPECT_EQ(game->getCheckpointStore()->getCheckpointCount(), 1u);
+
+    game->getPriceService()->simulateMarketShock(0.2);
+    ASSERT_TRUE(game->simulateDays(2));
+    EXPECT_EQ(game->getCheckpointStore()->getCheckpointCount(), 2u);
+    auto shocked = closingPrices(*game);
+
+    ASSERT_TRUE(game->simulateDays(2));
+    ASSERT_TRUE(game->rewindTo(5)) << game->getLastError();
+    EXPECT_EQ(closingPrices(*game), shocked);
+    ASSERT_TRUE(game->rewindTo(3)) << game->getLastError();
+}
+
+TEST(CheckpointStoreTest, MemoryBudgetDropsOldestSegments) {
+    ScopedSavesDirectory saves;
+    CheckpointOptions options;
+    options.interval = 2;
+    options.memoryBudget = 1;
+
+    auto game = std::make_shared<Game>();
+    game->initialize();
+    saves.attach(*game);
+    game->setCheckpointStore(std::make_shared<CheckpointStore>(options));
+    game->start();
+    ASSERT_TRUE(game->simulateDays(6));
+
+    auto store = game->getCheckpointStore();
+    EXPECT_EQ(store->getCheckpointCount(), 1u);
+    EXPECT_EQ(store->getEarliestDay(), 5);
+    EXPECT_FALSE(game->rewindTo(2));
+    EXPECT_NE(game->getLastError().find("No checkpoint"), std::string::npos);
+    EXPECT_TRUE(game->rewindTo(5)) << game->getLastError();
+
+    auto plain = std::make_shared<Game>();
+    EXPECT_FALSE(plain->rewindTo(0));
+}
+
+TEST(CheckpointStoreTest, FingerprintLeavesLazyHistoriesUnloaded) {
+    ScopedSavesDirectory saves;
+    Game game;
+    game.initialize();
+    saves.attach(game);
+    Stock* stock = game.getMarket()->getCompanies().front()->getStock();
+    uint64_t before = CheckpointStore::fingerprint(game);
+
+    stock->setLazyPriceHistory([] { return std::vector<double>{1.0, 2.0, 3.0}; });
+    EXPECT_EQ(CheckpointStore::fingerprint(game), before);
+    EXPECT_FALSE(stock->isPriceHistoryLoaded());
+}
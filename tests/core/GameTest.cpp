@@ -107,6 +107,31 @@ TEST_F(GameTest, LoanOperations) {
     EXPECT_NEAR(player->getPortfolio()->getCashBalance(), initialBalance, 0.001);
 }
 
+// Test that quiet days leave the loans version alone
+TEST_F(GameTest, LoansVersionTracksLoanChanges) {
+    game->initialize();
+    game->getSaveService()->setAutosave(false);
+    game->start();
+
+    auto player = game->getPlayer();
+    uint64_t version = player->getLoansVersion();
+    EXPECT_TRUE(game->simulateDays(3));
+    EXPECT_EQ(player->getLoansVersion(), version);
+
+    EXPECT_TRUE(game->takeLoan(1000.0, 0.05, 30, "Test Loan"));
+    EXPECT_NE(player->getLoansVersion(), version);
+
+    // Interest accrues on the open loan every day
+    version = player->getLoansVersion();
+    EXPECT_TRUE(game->simulateDay());
+    EXPECT_NE(player->getLoansVersion(), version);
+
+    EXPECT_TRUE(game->repayLoan(0, player->getLoans()[0].getTotalDue()));
+    version = player->getLoansVersion();
+    EXPECT_TRUE(game->simulateDays(2));
+    EXPECT_EQ(player->getLoansVersion(), version);
+}
+
 // Test invalid operations
 TEST_F(GameTest, InvalidOperations) {
     // Try operations on uninitialized game
@@ -151,3 +176,153 @@ TEST_F(GameTest, ErrorHandling) {
     EXPECT_FALSE(game->simulateDay());
     EXPECT_FALSE(game->getLastError().empty());
 }
+
+// Test day simulation through the fused pipeline
+TEST_F(GameTest, FusedPipelineSimulation) {
+    game->initialize();
+    game->setFusedPipeline(true);
+    game->start();
+
+    EXPECT_TRUE(game->isFusedPipeline());
+
+    auto company = game->getMarket()->getCompanies().front();
+    size_t historyLength = company->getStock()->getPriceHistoryLength();
+    Date initialDate = game->getMarket()->getCurrentDate();
+
+    EXPECT_TRUE(game->simulateDays(5));
+    EXPECT_EQ(game->getSimulatedDays(), 5);
+    EXPECT_EQ(company->getStock()->getPriceHistoryLength(), historyLength + 5);
+    EXPECT_EQ(initialDate.daysBetween(game->getMarket()->getCurrentDate()), 5);
+}
+
+// Test that parallel mode gives identical prices regardless of thread count
+TEST_F(GameTest, ParallelModeIsDeterministic) {
+    auto runGame = [](size_t threadCount) {
+        Random::initialize(99);
+
+        auto parallelGame = std::make_shared<Game>();
+        parallelGame->initialize();
+        parallelGame->enableParallelMode(threadCount, 2024);
+        parallelGame->start();
+        parallelGame->simulateDays(10);
+
+        std::vector<double> prices;
+        for (const auto& company : parallelGame->getMarket()->getCompanies()) {
+            prices.push_back(company->getStock()->getCurrentPrice());
+        }
+        return prices;
+    };
+
+    std::vector<double> singleThread = runGame(1);
+    std::vector<double> manyThreads = runGame(4);
+
+    ASSERT_EQ(singleThread.size(), manyThreads.size());
+    for (size_t i = 0; i < singleThread.size(); ++i) {
+        EXPECT_EQ(singleThread[i], manyThreads[i]);
+    }
+}
+
+// Test that the daily pipeline reports a timing for every stage
+TEST_F(GameTest, StageTimings) {
+    game->initialize();
+    game->enableParallelMode(2, 7);
+    game->start();
+
+    EXPECT_TRUE(game->getStageTimings().empty());
+    EXPECT_TRUE(game->simulateDay());
+
+    const auto& timings = game->getStageTimings();
+    ASSERT_EQ(timings.size(), 9u);
+    EXPECT_EQ(timings.front().name, "news");
+    EXPECT_EQ(timings.back().name, "autosave");
+
+    for (const auto& timing : timings) {
+        EXPECT_GE(timing.milliseconds, 0.0);
+    }
+}
+
+// Test that branches diverge from the original without disturbing it
+TEST_F(GameTest, BranchesAreIndependent) {
+    game->initialize();
+    game->start();
+    game->simulateDays(3);
+    ASSERT_TRUE(game->buyStock("ITECH", 5));
+
+    auto branch = game->branch();
+    ASSERT_NE(branch->getMarket(), game->getMarket());
+    EXPECT_EQ(branch->getSimulatedDays(), game->getSimulatedDays());
+    EXPECT_EQ(branch->getNewsService()->getNewsHistory().size(),
+              game->getNewsService()->getNewsHistory().size());
+
+    auto original = game->getMarket()->getCompanyByTicker("ITECH");
+    auto copy = branch->getMarket()->getCompanyByTicker("ITECH");
+    ASSERT_NE(original, copy);
+    EXPECT_EQ(branch->getPlayer()->getPortfolio()->getPosition("ITECH")->company, copy);
+
+    double originalPrice = original->getStock()->getCurrentPrice();
+    size_t originalHistory = original->getStock()->getPriceHistoryLength();
+    size_t originalNews = game->getNewsService()->getNewsHistory().size();
+    size_t originalTransactions = game->getPlayer()->getPortfolio()->getTransactions().size();
+
+    branch->getPriceService()->simulateMarketShock(0.2);
+    ASSERT_TRUE(branch->sellStock("ITECH", 5));
+    ASSERT_TRUE(branch->simulateDays(2));
+
+    EXPECT_EQ(original->getStock()->getCurrentPrice(), originalPrice);
+    EXPECT_EQ(original->getStock()->getPriceHistoryLength(), originalHistory);
+    EXPECT_EQ(game->getNewsService()->getNewsHistory().size(), originalNews);
+    EXPECT_EQ(game->getPlayer()->getPortfolio()->getTransactions().size(), originalTransactions);
+    EXPECT_EQ(game->getPlayer()->getPortfolio()->getPositionQuantity("ITECH"), 5);
+    EXPECT_EQ(branch->getPlayer()->getPortfolio()->getPositionQuantity("ITECH"), 0);
+    EXPECT_EQ(branch->getSimulatedDays(), game->getSimulatedDays() + 2);
+}
+
+// Test that branches keep only the companies their inherited history refers to
+TEST_F(GameTest, BranchesReleaseUnreferencedCompanies) {
+    game->initialize();
+    game->start();
+    ASSERT_TRUE(game->buyStock("ITECH", 5));
+
+    auto branch = game->branch();
+    std::weak_ptr<Company> traded = game->getMarket()->getCompanyByTicker("ITECH");
+    game.reset();
+
+    std::weak_ptr<Company> untouched = branch->getMarket()->getCompanies().front();
+    for (int i = 0; i < 5; ++i) {
+        branch = branch->branch();
+    }
+
+    EXPECT_TRUE(untouched.expired());
+    ASSERT_FALSE(traded.expired());
+    auto company = branch->getPlayer()->getPortfolio()->getTransactions().back().getCompany().lock();
+    ASSERT_NE(company, nullptr);
+    EXPECT_EQ(company->getTicker(), "ITECH");
+}
+
+// Test that branches simulated in parallel are reproducible per seed
+TEST_F(GameTest, BranchesSimulateInParallel) {
+    game->initialize();
+    game->start();
+
+    auto runBranches = [this] {
+        Random::initialize(5);
+        std::vector<std::shared_ptr<Game>> branches;
+        for (int i = 0; i < 3; ++i) {
+            branches.push_back(game->branch());
+        }
+        branches[1]->getPriceService()->simulateMarketShock(0.3);
+        EXPECT_TRUE(Game::simulateBranches(branches, 5, 11));
+
+        std::vector<double> indexes;
+        for (const auto& branch : branches) {
+            indexes.push_back(branch->getMarket()->getMarketIndex());
+        }
+        return indexes;
+    };
+
+    auto first = runBranches();
+    auto second = runBranches();
+    ASSERT_EQ(first.size(), 3u);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(game->getSimulatedDays(), 0);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "../../src/core/MarketIndex.hpp"
+#include "../../src/core/Market.hpp"
+#include "../../src/utils/Random.hpp"
+#include <memory>
+
+namespace StockMarketSimulator {
+
+static std::shared_ptr<Company> makeCompany(const std::string& ticker, Sector sector, double price) {
+    return std::make_shared<Company>(ticker + " Inc", ticker, "Test company", sector, price, 0.5,
+                                     DividendPolicy(0.0, 0));
+}
+
+// Test that the cap-weighted index follows market capitalization
+TEST(MarketIndexTest, CapWeightedFollowsMarketCap) {
+    MarketIndex index;
+
+    size_t a = index.addConstituent(Sector::Technology, 100.0, 100.0 * 1000000);
+    size_t b = index.addConstituent(Sector::Energy, 50.0, 50.0 * 1000000);
+    EXPECT_NEAR(index.getCapWeightedIndex(), MarketIndex::BASE_VALUE, 1e-9);
+
+    // +10% on two thirds of the capitalization
+    index.onPriceChange(a, 110.0, 110.0 * 1000000);
+    EXPECT_NEAR(index.getCapWeightedIndex(), 1000.0 * 160.0 / 150.0, 1e-9);
+    EXPECT_NEAR(index.getSectorIndex(Sector::Technology), 1100.0, 1e-9);
+    EXPECT_NEAR(index.getSectorIndex(Sector::Energy), 1000.0, 1e-9);
+
+    // Equal weighted: (+10% + 0%) / 2
+    EXPECT_NEAR(index.getEqualWeightedIndex(), 1050.0, 1e-9);
+
+    index.onPriceChange(b, 45.0, 45.0 * 1000000);
+    EXPECT_NEAR(index.getEqualWeightedIndex(), 1000.0, 1e-9);
+    EXPECT_EQ(index.getUpdatesSinceRebase(), 2);
+}
+
+// Test that membership changes and rebasing do not move the index
+TEST(MarketIndexTest, MembershipChangesKeepLevel) {
+    MarketIndex index;
+
+    size_t a = index.addConstituent(Sector::Technology, 100.0, 100.0 * 1000000);
+    index.onPriceChange(a, 120.0, 120.0 * 1000000);
+    double level = index.getCapWeightedIndex();
+    double equalLevel = index.getEqualWeightedIndex();
+
+    size_t b = index.addConstituent(Sector::Finance, 30.0, 30.0 * 1000000);
+    EXPECT_NEAR(index.getCapWeightedIndex(), level, 1e-9);
+    EXPECT_NEAR(index.getEqualWeightedIndex(), equalLevel, 1e-9);
+
+    index.rebase();
+    EXPECT_NEAR(index.getCapWeightedIndex(), level, 1e-9);
+    EXPECT_EQ(index.getUpdatesSinceRebase(), 0);
+
+    index.removeConstituent(b);
+    EXPECT_NEAR(index.getCapWeightedIndex(), level, 1e-9);
+    EXPECT_EQ(index.getConstituentCount(), 1u);
+}
+
+// Test that the market keeps its index in sync with company price updates
+TEST(MarketIndexTest, MarketTracksCompanyPrices) {
+    Random::initialize(42);
+    Market market;
+
+    auto tech = makeCompany("TCH", Sector::Technology, 100.0);
+    auto energy = makeCompany("NRG", Sector::Energy, 100.0);
+    market.addCompany(tech);
+    market.addCompany(energy);
+    EXPECT_NEAR(market.getMarketIndex(), 1000.0, 1e-9);
+
+    tech->updatePrice(120.0);
+    EXPECT_NEAR(market.getIndexEngine().getCapWeightedIndex(), 1100.0, 1e-6);
+    EXPECT_NEAR(market.getSectorIndex(Sector::Technology), 1200.0, 1e-6);
+
+    for (int i = 0; i < 5; ++i) {
+        market.simulateDay();
+    }
+
+    double totalCap = tech->getMarketCap() + energy->getMarketCap();
+    EXPECT_NEAR(market.getIndexEngine().getTotalMarketCap(), totalCap, 1e-3);
+    EXPECT_NEAR(market.getMarketIndex(), market.getIndexEngine().getCapWeightedIndex(), 1e-9);
+}
+
+// Test that a copied market owns its own index and survives round-tripping
+TEST(MarketIndexTest, CopyAndSerialization) {
+    Random::initialize(7);
+    Market market;
+    market.addDefaultCompanies();
+    market.simulateDay();
+
+    Market copy = Market::fromJson(market.toJson());
+    EXPECT_NEAR(copy.getMarketIndex(), market.getMarketIndex(), 1e-6);
+    EXPECT_NEAR(copy.getEqualWeightedIndex(), market.getEqualWeightedIndex(), 1e-6);
+    EXPECT_NEAR(copy.getSectorIndex(Sector::Energy), market.getSectorIndex(Sector::Energy), 1e-6);
+
+    double before = market.getIndexEngine().getCapWeightedIndex();
+    double copyBefore = copy.getIndexEngine().getCapWeightedIndex();
+    auto company = copy.getCompanies()[0];
+    company->updatePrice(company->getStock()->getCurrentPrice() * 2.0);
+    EXPECT_GT(copy.getIndexEngine().getCapWeightedIndex(), copyBefore);
+    EXPECT_NEAR(market.getIndexEngine().getCapWeightedIndex(), before, 1e-9);
+}
+
+}
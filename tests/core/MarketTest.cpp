@@ -245,6 +245,23 @@ TEST_F(MarketTest, TriggerEconomicEvent) {
     EXPECT_LT(market->getMarketIndex(), currentIndex);
 }
 
+// Test that sector aggregates follow prices moved outside simulateDay()
+TEST_F(MarketTest, EconomicEventRefreshesSectorAggregates) {
+    market->addDefaultCompanies();
+    market->simulateDay();
+    double technologyCap = market->getSectorAggregates().get(Sector::Technology).totalMarketCap;
+
+    market->triggerEconomicEvent(0.05, true);
+    EXPECT_GT(market->getSectorAggregates().get(Sector::Technology).totalMarketCap, technologyCap);
+
+    technologyCap = market->getSectorAggregates().get(Sector::Technology).totalMarketCap;
+    for (const auto& company : market->getCompaniesBySector(Sector::Technology)) {
+        company->processNewsImpact(-0.1);
+    }
+    market->refreshAggregates();
+    EXPECT_LT(market->getSectorAggregates().get(Sector::Technology).totalMarketCap, technologyCap);
+}
+
 // Test economic event affecting specific sectors
 TEST_F(MarketTest, TriggerSectorSpecificEvent) {
     market->addDefaultCompanies();
@@ -403,7 +420,7 @@ TEST_F(MarketTest, SectorTrends) {
 
     // Initially all sector trends should be 0.0
     const auto& initialSectorTrends = market->getSectorTrends();
-    for (const auto& [sector, trend] : initialSectorTrends) {
+    for (double trend : initialSectorTrends) {
         EXPECT_NEAR(trend, 0.0, 0.001);
     }
 
@@ -416,7 +433,7 @@ TEST_F(MarketTest, SectorTrends) {
     const auto& updatedSectorTrends = market->getSectorTrends();
     bool trendsChanged = false;
 
-    for (const auto& [sector, trend] : updatedSectorTrends) {
+    for (double trend : updatedSectorTrends) {
         if (std::abs(trend) > 0.001) {
             trendsChanged = true;
             break;
@@ -460,4 +477,108 @@ TEST_F(MarketTest, DateFunctionality) {
     EXPECT_EQ(aprilFirst.getYear(), 2023);
 }
 
+// Test that the fused day applies all effects with a single price update per company
+TEST_F(MarketTest, FusedDaySinglePriceUpdate) {
+    market->addDefaultCompanies();
+    const auto& companies = market->getCompanies();
+
+    std::vector<size_t> historyLengths;
+    std::vector<double> initialPrices;
+    for (const auto& company : companies) {
+        historyLengths.push_back(company->getStock()->getPriceHistoryLength());
+        initialPrices.push_back(company->getStock()->getCurrentPrice());
+    }
+
+    DailyCompanyEffects effects;
+    effects.priceMovements.assign(companies.size(), 0.0);
+    effects.newsFactors.assign(companies.size(), 1.0);
+    effects.newsFactors[0] = 1.5;
+    effects.economicImpacts.push_back(0.01);
+
+    Date initialDate = market->getCurrentDate();
+    market->simulateFusedDay(effects);
+
+    EXPECT_EQ(initialDate.daysBetween(market->getCurrentDate()), 1);
+
+    for (size_t i = 0; i < companies.size(); ++i) {
+        auto stock = companies[i]->getStock();
+        EXPECT_EQ(stock->getPriceHistoryLength(), historyLengths[i] + 1);
+        EXPECT_DOUBLE_EQ(stock->getOpenPrice(), initialPrices[i]);
+        EXPECT_DOUBLE_EQ(stock->getPreviousClosePrice(), initialPrices[i]);
+    }
+
+    EXPECT_GT(companies[0]->getStock()->getCurrentPrice(), initialPrices[0] * 1.3);
+    EXPECT_NEAR(market->getMarketIndex(), market->getIndexEngine().getCapWeightedIndex(), 1e-9);
+}
+
+// Test that economic news in a fused day follows the order of the unfused path
+TEST_F(MarketTest, FusedDayMatchesSequentialEconomicEvent) {
+    Market sequential;
+    sequential.addCompany(createTestCompany("Tech", "TECH", Sector::Technology, 100.0));
+    Market fused(sequential);
+
+    Random::initialize(11);
+    sequential.simulateDay();
+    sequential.triggerEconomicEvent(0.02);
+    sequential.triggerEconomicEvent(-0.01);
+
+    DailyCompanyEffects effects;
+    effects.priceMovements.assign(1, 0.0);
+    effects.newsFactors.assign(1, 1.0);
+    effects.economicImpacts = {0.02, -0.01};
+
+    Random::initialize(11);
+    fused.simulateFusedDay(effects);
+
+    EXPECT_NEAR(fused.getCompanies()[0]->getStock()->getCurrentPrice(),
+                sequential.getCompanies()[0]->getStock()->getCurrentPrice(), 1e-9);
+    EXPECT_EQ(fused.getSectorTrends(), sequential.getSectorTrends());
+}
+
+// Test that the change version moves only when market data changes
+TEST_F(MarketTest, VersionTracksChanges) {
+    uint64_t version = market->getVersion();
+    EXPECT_EQ(market->getVersion(), version);
+
+    market->addDefaultCompanies();
+    EXPECT_NE(market->getVersion(), version);
+
+    version = market->getVersion();
+    market->simulateDay();
+    EXPECT_NE(market->getVersion(), version);
+
+    // A copy must never report a version an observer of the original has seen
+    Market copy(*market);
+    EXPECT_NE(copy.getVersion(), market->getVersion());
+}
+
+// Test that a copy owns its companies and leaves the original's index intact
+TEST_F(MarketTest, CopyDoesNotShareCompanies) {
+    market->addDefaultCompanies();
+
+    Market copy(*market);
+    ASSERT_EQ(copy.getCompanies().size(), market->getCompanies().size());
+    EXPECT_NE(copy.getCompanies()[0], market->getCompanies()[0]);
+
+    market->triggerEconomicEvent(0.1, true);
+    EXPECT_NEAR(market->getMarketIndex(), market->getIndexEngine().getCapWeightedIndex(), 1e-9);
+    EXPECT_DOUBLE_EQ(copy.getCompanies()[0]->getStock()->getCurrentPrice(),
+                     copy.getCompanies()[0]->getStock()->getOpenPrice());
+
+    copy = *market;
+    EXPECT_NE(copy.getCompanies()[0], market->getCompanies()[0]);
+    EXPECT_DOUBLE_EQ(copy.getCompanies()[0]->getStock()->getCurrentPrice(),
+                     market->getCompanies()[0]->getStock()->getCurrentPrice());
+}
+
+// Test that a branch's stocks point back at the branch's own companies
+TEST_F(MarketTest, BranchRebindsStocksToClonedCompanies) {
+    market->addDefaultCompanies();
+
+    auto branch = market->branch();
+    for (const auto& company : branch->getCompanies()) {
+        EXPECT_EQ(company->getStock()->getCompany().lock(), company);
+    }
+}
+
 } // namespace StockMarketSimulator
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "../../src/core/ParameterSweep.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(ParameterSweepTest, GridAndSampleCoverTheSpace) {
+    SweepSpace space;
+    space.addValues("price.trendStrength", {0.5, 1.0});
+    space.addRange("price.randomnessFactor", 0.2, 0.6, 3);
+
+    auto grid = space.grid();
+    ASSERT_EQ(grid.size(), 6u);
+    EXPECT_DOUBLE_EQ(grid[0].at("price.trendStrength"), 0.5);
+    EXPECT_DOUBLE_EQ(grid[0].at("price.randomnessFactor"), 0.2);
+    EXPECT_DOUBLE_EQ(grid[5].at("price.trendStrength"), 1.0);
+    EXPECT_DOUBLE_EQ(grid[5].at("price.randomnessFactor"), 0.6);
+
+    auto samples = space.sample(20, 9);
+    ASSERT_EQ(samples.size(), 20u);
+    for (const auto& sample : samples) {
+        double trend = sample.at("price.trendStrength");
+        EXPECT_TRUE(trend == 0.5 || trend == 1.0);
+        EXPECT_GE(sample.at("price.randomnessFactor"), 0.2);
+        EXPECT_LE(sample.at("price.randomnessFactor"), 0.6);
+    }
+    EXPECT_EQ(space.sample(20, 9), samples);
+
+    SweepSpace parsed = SweepSpace::fromJson(nlohmann::json::parse(
+        R"({"strategy.positionFraction": [0.1, 0.2], "price.momentumFactor": {"min": 0.0, "max": 1.0, "steps": 4}})"));
+    EXPECT_EQ(parsed.grid().size(), 8u);
+}
+
+TEST(ParameterSweepTest, RunsConfigurationsAcrossSeedsInParallel) {
+    SweepOptions options;
+    options.strategyName = "momentum";
+    options.days = 5;
+    options.seeds = {1, 2};
+    options.workers = 3;
+    options.warmupDays = 2;
+
+    SweepSpace space;
+    space.addValues("strategy.positionFraction", {0.05, 0.25});
+    space.addValues("sector.Technology.baseVolatility", {0.02, 0.08});
+    auto configurations = space.grid();
+    configurations.push_back(configurations.front());
+
+    ParameterSweep sweep(options);
+    ASSERT_TRUE(sweep.warmStart()) << sweep.getLastError();
+    auto results = sweep.run(configurations);
+
+    ASSERT_EQ(results.size(), configurations.size() * 2);
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.succeeded) << result.error;
+        EXPECT_GT(result.metrics.finalNetWorth, 0.0);
+        EXPECT_GT(result.metrics.finalIndex, 0.0);
+        EXPECT_GE(result.metrics.maxDrawdownPercent, 0.0);
+    }
+
+    // Every run starts from the same warm state, so a repeated configuration
+    // and seed reproduces the same numbers.
+    const SweepResult& first = results[0];
+    const SweepResult& repeat = results[results.size() - 2];
+    EXPECT_EQ(repeat.configurationIndex, configurations.size() - 1);
+    EXPECT_EQ(first.seed, repeat.seed);
+    EXPECT_DOUBLE_EQ(first.metrics.finalNetWorth, repeat.metrics.finalNetWorth);
+    EXPECT_DOUBLE_EQ(first.metrics.finalIndex, repeat.metrics.finalIndex);
+
+    auto summaries = ParameterSweep::summarize(results);
+    ASSERT_EQ(summaries.size(), configurations.size());
+    for (size_t i = 1; i < summaries.size(); ++i) {
+        EXPECT_GE(summaries[i - 1].mean.finalNetWorth, summaries[i].mean.finalNetWorth);
+        EXPECT_EQ(summaries[i].runs, 2u);
+    }
+    EXPECT_NE(ParameterSweep::formatTable(summaries).find("strategy.positionFraction"), std::string::npos);
+    EXPECT_EQ(ParameterSweep::toJson(results)["runs"].size(), results.size());
+}
+
+TEST(ParameterSweepTest, UnknownParametersFailTheirRun) {
+    SweepOptions options;
+    options.days = 1;
+
+    ParameterSweep sweep(options);
+    auto results = sweep.run({{{"price.bogus", 1.0}}, {{"strategy.entryThreshold", 1.0}}, {{"price.trendStrength", 0.5}}});
+
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_FALSE(results[0].succeeded);
+    EXPECT_NE(results[0].error.find("Unknown sweep parameter"), std::string::npos);
+    EXPECT_FALSE(results[1].succeeded);
+    EXPECT_TRUE(results[2].succeeded) << results[2].error;
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../../src/core/SectorAggregates.hpp"
+#include "../../src/core/Market.hpp"
+#include "../../src/utils/Random.hpp"
+#include <memory>
+
+namespace StockMarketSimulator {
+
+// Test advancers/decliners and weighted change for a single day
+TEST(SectorAggregatesTest, AccumulateSingleDay) {
+    SectorAggregates aggregates;
+
+    aggregates.beginDay();
+    aggregates.accumulate(Sector::Technology, 100.0, 110.0, 110.0 * 1000000);
+    aggregates.accumulate(Sector::Technology, 50.0, 45.0, 45.0 * 1000000);
+    aggregates.accumulate(Sector::Energy, 20.0, 20.0, 20.0 * 1000000);
+    aggregates.finishDay();
+
+    const SectorSnapshot& tech = aggregates.get(Sector::Technology);
+    EXPECT_EQ(tech.companyCount, 2);
+    EXPECT_EQ(tech.advancers, 1);
+    EXPECT_EQ(tech.decliners, 1);
+    EXPECT_EQ(tech.unchanged, 0);
+
+    // (100 * 10% + 50 * -10%) / 150 = 3.33%
+    EXPECT_NEAR(tech.capWeightedChangePercent, 10.0 / 3.0, 1e-9);
+    EXPECT_NEAR(tech.averageChangePercent, 0.0, 1e-9);
+
+    const SectorSnapshot& energy = aggregates.get(Sector::Energy);
+    EXPECT_EQ(energy.unchanged, 1);
+
+    EXPECT_EQ(aggregates.getAdvancers(), 1);
+    EXPECT_EQ(aggregates.getDecliners(), 1);
+}
+
+// Test that breadth counters reset between days
+TEST(SectorAggregatesTest, BeginDayResetsCounters) {
+    SectorAggregates aggregates;
+
+    aggregates.beginDay();
+    aggregates.accumulate(Sector::Finance, 10.0, 11.0, 11.0);
+    aggregates.finishDay();
+
+    aggregates.beginDay();
+    aggregates.accumulate(Sector::Finance, 11.0, 9.9, 9.9);
+    aggregates.finishDay();
+
+    const SectorSnapshot& finance = aggregates.get(Sector::Finance);
+    EXPECT_EQ(finance.companyCount, 1);
+    EXPECT_EQ(finance.advancers, 0);
+    EXPECT_EQ(finance.decliners, 1);
+    EXPECT_NEAR(finance.capWeightedChangePercent, -10.0, 1e-9);
+}
+
+// Test that Market keeps aggregates in sync with its companies
+TEST(SectorAggregatesTest, MarketUpdatesAggregates) {
+    Random::initialize(42);
+
+    Market market;
+    market.addDefaultCompanies();
+    market.simulateDay();
+
+    const auto& aggregates = market.getSectorAggregates();
+    int totalCompanies = 0;
+    for (const auto& snapshot : aggregates.getAll()) {
+        totalCompanies += snapshot.companyCount;
+        EXPECT_EQ(snapshot.advancers + snapshot.decliners + snapshot.unchanged, snapshot.companyCount);
+    }
+
+    EXPECT_EQ(totalCompanies, static_cast<int>(market.getCompanies().size()));
+    EXPECT_EQ(aggregates.get(Sector::Technology).companyCount, 2);
+    EXPECT_DOUBLE_EQ(aggregates.get(Sector::Technology).indexValue,
+                     market.getSectorIndex(Sector::Technology));
+
+    Market restored = Market::fromJson(market.toJson());
+    EXPECT_DOUBLE_EQ(restored.getSectorAggregates().get(Sector::Energy).indexValue,
+                     aggregates.get(Sector::Energy).indexValue);
+    EXPECT_DOUBLE_EQ(restored.getSectorTrend(Sector::Energy), market.getSectorTrend(Sector::Energy));
+}
+
+// Test that sector counts follow membership before the first simulated day
+TEST(SectorAggregatesTest, CountsFollowMembershipBetweenDays) {
+    Market market;
+    market.addDefaultCompanies();
+
+    EXPECT_EQ(market.getSectorAggregates().get(Sector::Technology).companyCount, 2);
+    EXPECT_EQ(market.getCompaniesBySector(Sector::Technology).size(), 2u);
+    EXPECT_TRUE(market.getCompaniesBySector(Sector::Unknown).empty());
+
+    market.removeCompany("TCH");
+    EXPECT_EQ(market.getSectorAggregates().get(Sector::Technology).companyCount, 1);
+
+    nlohmann::json json = market.toJson();
+    json.erase("sector_aggregates");
+    Market restored = Market::fromJson(json);
+    EXPECT_EQ(restored.getCompaniesBySector(Sector::Technology).size(), 1u);
+}
+
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "../../src/core/Game.hpp"
+#include "../../src/utils/Random.hpp"
+#include "../TestSupport.hpp"
+
+using namespace StockMarketSimulator;
+
+namespace {
+
+class RecordingStrategy : public Strategy {
+public:
+    std::vector<int> days;
+    std::string ticker;
+
+    explicit RecordingStrategy(const std::string& ticker) : ticker(ticker) {}
+
+    std::string getName() const override {
+        return "recording";
+    }
+
+    void onDay(const StrategyContext& context, std::vector<OrderRequest>& orders) override {
+        days.push_back(context.day);
+        orders.push_back({1, OrderSide::Buy, ticker, 1, false});
+        orders.push_back({2, OrderSide::Sell, "NOPE", 1, false});
+    }
+};
+
+}
+
+class StrategyEngineTest : public ::testing::Test {
+protected:
+    std::shared_ptr<Game> game;
+    ScopedSavesDirectory saves;
+
+    void SetUp() override {
+        game = std::make_shared<Game>();
+    }
+};
+
+TEST_F(StrategyEngineTest, RegistryProvidesBuiltins) {
+    EXPECT_TRUE(StrategyRegistry::contains("buy-and-hold"));
+    EXPECT_TRUE(StrategyRegistry::contains("momentum"));
+    EXPECT_EQ(StrategyRegistry::create("missing"), nullptr);
+
+    auto strategy = StrategyRegistry::create("momentum");
+    ASSERT_NE(strategy, nullptr);
+    EXPECT_EQ(strategy->getName(), "momentum");
+
+    EXPECT_TRUE(StrategyRegistry::registerStrategy("test-recording", [] {
+        return std::make_unique<RecordingStrategy>("X");
+    }));
+    EXPECT_FALSE(StrategyRegistry::registerStrategy("test-recording", [] {
+        return std::make_unique<RecordingStrategy>("Y");
+    }));
+
+    std::string error;
+    EXPECT_FALSE(StrategyRegistry::loadPlugin("/nonexistent/strategy.so", error));
+    EXPECT_FALSE(error.empty());
+}
+
+TEST_F(StrategyEngineTest, StrategyOrdersExecuteAgainstItsOwnAccount) {
+    game->initialize("Main", 10000.0);
+    saves.attach(*game);
+    std::string ticker = game->getMarket()->getCompanies().front()->getTicker();
+
+    auto strategy = std::make_unique<RecordingStrategy>(ticker);
+    RecordingStrategy* recording = strategy.get();
+    ASSERT_TRUE(game->addStrategyAccount(std::move(strategy), "Bot", 50000.0));
+    EXPECT_FALSE(game->addStrategyAccount("missing", "Bot", 50000.0));
+
+    game->start();
+    ASSERT_TRUE(game->simulateDays(3));
+
+    const StrategyEngine& engine = game->getStrategyEngine();
+    ASSERT_EQ(engine.getAccountCount(), 1u);
+    EXPECT_EQ(recording->days.size(), 3u);
+    EXPECT_LT(recording->days.front(), recording->days.back());
+
+    const auto& stats = engine.getStats(0);
+    EXPECT_EQ(stats.decisions, 3u);
+    EXPECT_EQ(stats.ordersSubmitted, 6u);
+    EXPECT_EQ(stats.ordersFilled, 3u);
+    EXPECT_EQ(stats.ordersRejected, 3u);
+
+    const auto& reports = engine.getLastReports(0);
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].status, OrderStatus::Filled);
+    EXPECT_EQ(reports[1].reason, "Unknown ticker");
+
+    EXPECT_EQ(engine.getPlayer(0)->getPortfolio()->getPositionQuantity(ticker), 3);
+    EXPECT_EQ(game->getPlayer()->getPortfolio()->getPositionQuantity(ticker), 0);
+    EXPECT_EQ(engine.getPlayer(0)->getCurrentDate(), game->getPlayer()->getCurrentDate());
+}
+
+TEST_F(StrategyEngineTest, ParallelAccountsMatchSequentialRun) {
+    auto runBacktest = [this](size_t threadCount) {
+        Random::initialize(7);
+
+        auto backtest = std::make_shared<Game>();
+        backtest->initialize();
+        saves.attach(*backtest);
+        backtest->enableParallelMode(threadCount, 11);
+        for (int i = 0; i < 6; ++i) {
+            backtest->addStrategyAccount((i % 2) ? "momentum" : "buy-and-hold",
+                                         "Account " + std::to_string(i), 25000.0);
+        }
+        backtest->start();
+        backtest->simulateDays(10);
+
+        std::vector<double> netWorths;
+        const StrategyEngine& engine = backtest->getStrategyEngine();
+        for (size_t i = 0; i < engine.getAccountCount(); ++i) {
+            netWorths.push_back(engine.getPlayer(i)->getNetWorth());
+        }
+        return netWorths;
+    };
+
+    std::vector<double> sequential = runBacktest(1);
+    std::vector<double> parallel = runBacktest(4);
+
+    ASSERT_EQ(sequential.size(), 6u);
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        EXPECT_DOUBLE_EQ(sequential[i], parallel[i]);
+    }
+}
@@ -253,3 +253,75 @@ TEST_F(NewsTest, NewsTemplate) {
     EXPECT_EQ(deserialized.requiresNegativeMarket, tmpl.requiresNegativeMarket);
     EXPECT_EQ(deserialized.targetSector, tmpl.targetSector);
 }
+
+// Test template-backed news rendering and serialization
+TEST_F(NewsTest, TemplatedNewsRendersOnDemand) {
+    NewsTemplate tmpl(NewsType::Corporate, "%s announces results",
+                      "Company %s grew by %d percent", -0.02, 0.02);
+    tmpl.id = 3;
+    auto sharedTemplate = std::make_shared<const NewsTemplate>(tmpl);
+
+    News news(NewsType::Corporate, sharedTemplate, 12345u, 0.01, testDate);
+    news.setTargetCompany(testCompany);
+
+    EXPECT_TRUE(news.isTemplated());
+    EXPECT_EQ(news.getTemplateId(), 3);
+    EXPECT_EQ(news.getTitle(), "TestCorp announces results");
+    EXPECT_EQ(news.getContent().find("Company TestCorp grew by "), 0u);
+
+    // Rendering is deterministic for the same variant
+    EXPECT_EQ(news.getContent(), news.getContent());
+
+    nlohmann::json json = news.toJson();
+    EXPECT_FALSE(json.contains("title"));
+    EXPECT_FALSE(json.contains("content"));
+    EXPECT_EQ(json["template_id"], 3);
+
+    std::vector<std::shared_ptr<Company>> companies = {testCompany};
+    std::vector<std::shared_ptr<const NewsTemplate>> templates(4);
+    templates[3] = sharedTemplate;
+
+    News deserialized = News::fromJson(json, companies, templates);
+    EXPECT_TRUE(deserialized.isTemplated());
+    EXPECT_EQ(deserialized.getTitle(), news.getTitle());
+    EXPECT_EQ(deserialized.getContent(), news.getContent());
+    EXPECT_TRUE(deserialized.isSameEvent(news));
+}
+
+// Test that overriding the text of templated news keeps the rendered text
+TEST_F(NewsTest, TemplatedNewsSetTitleMaterializes) {
+    auto sharedTemplate = std::make_shared<const NewsTemplate>(
+        NewsType::Global, "Markets %s", "Rates moved %d points", -0.01, 0.01);
+
+    News news(NewsType::Global, sharedTemplate, 7u, 0.0, testDate);
+    std::string content = news.getContent();
+
+    news.setTitle("Edited");
+
+    EXPECT_FALSE(news.isTemplated());
+    EXPECT_EQ(news.getTitle(), "Edited");
+    EXPECT_EQ(news.getContent(), content);
+}
+
+// Test that news whose template did not resolve keeps its id and text
+TEST_F(NewsTest, UnresolvedTemplateSurvivesRoundTrip) {
+    nlohmann::json json = {
+        {"type", "Global"}, {"template_id", 9}, {"variant", 4},
+        {"title", "Stored title"}, {"content", "Stored content"},
+        {"impact", 0.01}, {"publish_date", testDate.toJson()}, {"processed", false},
+        {"target_sector", "Technology"}, {"target_company_ticker", ""}
+    };
+
+    std::vector<std::shared_ptr<Company>> companies = {testCompany};
+    std::vector<std::shared_ptr<const NewsTemplate>> templates;
+
+    News news = News::fromJson(json, companies, templates);
+    EXPECT_FALSE(news.isTemplated());
+    EXPECT_EQ(news.getTitle(), "Stored title");
+
+    nlohmann::json saved = news.toJson();
+    EXPECT_EQ(saved["template_id"], 9);
+    EXPECT_EQ(saved["variant"], 4);
+    EXPECT_EQ(saved["title"], "Stored title");
+    EXPECT_EQ(saved["content"], "Stored content");
+}
@@ -220,4 +220,18 @@ TEST_F(PortfolioDateTest, DatesAcrossMonthBoundaries) {
     EXPECT_EQ(1, history[1].date.getDay());
     EXPECT_EQ(4, history[1].date.getMonth());
     EXPECT_EQ(2023, history[1].date.getYear());
-}
\ No newline at end of file
+}
+
+// Test that the change version moves on trades and stays put when idle
+TEST_F(PortfolioDateTest, VersionTracksChanges) {
+    Date day1(1, 3, 2023);
+    uint64_t version = portfolio->getVersion();
+    EXPECT_EQ(portfolio->getVersion(), version);
+
+    EXPECT_TRUE(portfolio->buyStock(company, 10, 100.0, 0.01, day1));
+    EXPECT_NE(portfolio->getVersion(), version);
+
+    version = portfolio->getVersion();
+    EXPECT_FALSE(portfolio->sellStock(company, 100, 100.0, 0.01, day1));
+    EXPECT_EQ(portfolio->getVersion(), version);
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include "../../src/services/MarketDataServer.hpp"
+#include "../../src/services/MarketDataClient.hpp"
+#include "../../src/utils/UnixSocket.hpp"
+#include "../../src/core/Game.hpp"
+#include "../../src/utils/FileIO.hpp"
+#include "../TestSupport.hpp"
+
+using namespace StockMarketSimulator;
+
+class MarketDataServerTest : public ::testing::Test {
+protected:
+    std::string socketPath;
+    ScopedSavesDirectory saves;
+
+    void SetUp() override {
+        socketPath = "/tmp/smp_market_data_" + std::to_string(getpid()) + ".sock";
+    }
+
+    static MarketSnapshot makeSnapshot(int day, size_t quoteCount) {
+        MarketSnapshot snapshot;
+        snapshot.day = day;
+        snapshot.state = MarketState{1000.0 + day, 1.5, 0.15, MarketTrend::Bullish, 3, 0.03, 0.02, 0.05};
+        for (size_t i = 0; i < quoteCount; ++i) {
+            snapshot.quotes.push_back({"T" + std::to_string(i), 100.0 + i, 99.0, 1.0});
+        }
+        snapshot.news.push_back({NewsType::Corporate, 0.02, "T0", "T0 beats estimates"});
+        return snapshot;
+    }
+
+    // Publishes until the client sees a quotes frame, since subscriptions are
+    // applied asynchronously by the server thread.
+    static bool receiveQuotes(MarketDataServer& server, MarketDataClient& client, MarketDataMessage& quotes) {
+        for (int attempt = 0; attempt < 200; ++attempt) {
+            server.publish(makeSnapshot(attempt, 3));
+            MarketDataMessage message;
+            while (client.receive(message, 10)) {
+                if (message.type == MarketDataMessageType::Quotes) {
+                    quotes = message;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(MarketDataServerTest, FramesRoundTrip) {
+    MarketSnapshot snapshot = makeSnapshot(42, 2);
+
+    std::string wire;
+    MarketDataProtocol::appendMarketState(wire, snapshot.day, snapshot.state);
+    MarketDataProtocol::appendQuotes(wire, {&snapshot.quotes[1]});
+    MarketDataProtocol::appendNews(wire, snapshot.news);
+
+    std::string partial = wire.substr(0, MarketDataProtocol::HEADER_SIZE + 3);
+    MarketDataMessage message;
+    EXPECT_FALSE(MarketDataProtocol::extractMessage(partial, message));
+
+    ASSERT_TRUE(MarketDataProtocol::extractMessage(wire, message));
+    EXPECT_EQ(message.type, MarketDataMessageType::MarketState);
+    EXPECT_EQ(message.day, 42);
+    EXPECT_DOUBLE_EQ(message.state.indexValue, 1042.0);
+    EXPECT_EQ(message.state.currentTrend, MarketTrend::Bullish);
+    EXPECT_EQ(message.state.trendDuration, 3);
+
+    ASSERT_TRUE(MarketDataProtocol::extractMessage(wire, message));
+    ASSERT_EQ(message.quotes.size(), 1u);
+    EXPECT_EQ(message.quotes[0].ticker, "T1");
+    EXPECT_DOUBLE_EQ(message.quotes[0].price, 101.0);
+
+    ASSERT_TRUE(MarketDataProtocol::extractMessage(wire, message));
+    ASSERT_EQ(message.news.size(), 1u);
+    EXPECT_EQ(message.news[0].title, "T0 beats estimates");
+    EXPECT_TRUE(wire.empty());
+}
+
+TEST_F(MarketDataServerTest, DeliversMoreQuotesThanFitInSixteenBits) {
+    const size_t quoteCount = 70000;
+    MarketSnapshot snapshot = makeSnapshot(7, quoteCount);
+
+    MarketDataServer server(socketPath, 8u << 20);
+    ASSERT_TRUE(server.start()) << server.getLastError();
+
+    MarketDataClient client;
+    ASSERT_TRUE(client.connect(socketPath)) << client.getLastError();
+    ASSERT_TRUE(client.subscribe());
+
+    // The subscription is applied asynchronously, so publish until quotes arrive.
+    MarketDataMessage message;
+    bool sawQuotes = false;
+    for (int attempt = 0; attempt < 50 && !sawQuotes; ++attempt) {
+        server.publish(snapshot);
+        while (!sawQuotes && client.receive(message, 200)) {
+            sawQuotes = message.type == MarketDataMessageType::Quotes;
+        }
+    }
+    ASSERT_TRUE(sawQuotes);
+    ASSERT_EQ(message.quotes.size(), quoteCount);
+    EXPECT_EQ(message.quotes.back().ticker, "T69999");
+    EXPECT_DOUBLE_EQ(message.quotes.back().price, 100.0 + 69999);
+
+    server.stop();
+}
+
+TEST_F(MarketDataServerTest, QuotesFollowSubscriptions) {
+    MarketDataServer server(socketPath);
+    ASSERT_TRUE(server.start()) << server.getLastError();
+
+    MarketDataClient client;
+    ASSERT_TRUE(client.connect(socketPath)) << client.getLastError();
+    ASSERT_TRUE(client.subscribe({"T2"}));
+
+    MarketDataMessage quotes;
+    ASSERT_TRUE(receiveQuotes(server, client, quotes));
+    ASSERT_EQ(quotes.quotes.size(), 1u);
+    EXPECT_EQ(quotes.quotes[0].ticker, "T2");
+
+    ASSERT_TRUE(client.subscribe());
+    bool sawAll = false;
+    for (int attempt = 0; attempt < 100 && !sawAll; ++attempt) {
+        ASSERT_TRUE(receiveQuotes(server, client, quotes));
+        sawAll = quotes.quotes.size() == 3;
+    }
+    EXPECT_TRUE(sawAll);
+
+    server.stop();
+    EXPECT_FALSE(server.isRunning());
+}
+
+TEST_F(MarketDataServerTest, LeavesNonSocketFilesAlone) {
+    FileIO::writeTextFile(socketPath, "not a socket");
+
+    MarketDataServer blocked(socketPath);
+    EXPECT_FALSE(blocked.start());
+    EXPECT_FALSE(blocked.getLastError().empty());
+    EXPECT_EQ(FileIO::readTextFile(socketPath), "not a socket");
+    unlink(socketPath.c_str());
+
+    MarketDataServer server(socketPath);
+    ASSERT_TRUE(server.start()) << server.getLastError();
+    unlink(socketPath.c_str());
+    FileIO::writeTextFile(socketPath, "replaced");
+    server.stop();
+
+    EXPECT_EQ(FileIO::readTextFile(socketPath), "replaced");
+    unlink(socketPath.c_str());
+}
+
+TEST_F(MarketDataServerTest, RefusesPathOfLiveServerButReplacesStaleSocket) {
+    MarketDataServer server(socketPath);
+    ASSERT_TRUE(server.start()) << server.getLastError();
+
+    MarketDataServer second(socketPath);
+    EXPECT_FALSE(second.start());
+    EXPECT_FALSE(second.getLastError().empty());
+
+    MarketDataClient client;
+    ASSERT_TRUE(client.connect(socketPath)) << client.getLastError();
+    ASSERT_TRUE(client.subscribe());
+    MarketDataMessage quotes;
+    EXPECT_TRUE(receiveQuotes(server, client, quotes));
+    server.stop();
+
+    // A socket left behind by a process that died is taken over.
+    std::string error;
+    int stale = UnixSocket::listen(socketPath, error);
+    ASSERT_GE(stale, 0) << error;
+    UnixSocket::close(stale);
+
+    MarketDataServer restarted(socketPath);
+    EXPECT_TRUE(restarted.start()) << restarted.getLastError();
+    restarted.stop();
+}
+
+TEST_F(MarketDataServerTest, SlowConsumerNeverBlocksPublisher) {
+    MarketDataServer server(socketPath, 4096);
+    ASSERT_TRUE(server.start()) << server.getLastError();
+
+    MarketDataClient client;
+    ASSERT_TRUE(client.connect(socketPath));
+    ASSERT_TRUE(client.subscribe());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int day = 0; day < 2000; ++day) {
+        server.publish(makeSnapshot(day, 200));
+        if (day % 100 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+    EXPECT_EQ(server.getPublishedSnapshots(), 2000u);
+
+    for (int i = 0; i < 200 && server.getDroppedSnapshots() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GT(server.getDroppedSnapshots(), 0u);
+}
+
+TEST_F(MarketDataServerTest, GamePublishesEachSimulatedDay) {
+    auto server = std::make_shared<MarketDataServer>(socketPath);
+    ASSERT_TRUE(server->start());
+
+    Game game;
+    game.initialize();
+    saves.attach(game);
+    game.setMarketDataServer(server);
+    game.start();
+
+    MarketDataClient client;
+    ASSERT_TRUE(client.connect(socketPath));
+    ASSERT_TRUE(client.subscribe());
+
+    for (int i = 0; i < 100 && server->getClientCount() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_TRUE(game.simulateDay());
+    EXPECT_EQ(server->getPublishedSnapshots(), 1u);
+
+    MarketDataMessage message;
+    ASSERT_TRUE(client.receive(message, 2000));
+    EXPECT_EQ(message.type, MarketDataMessageType::MarketState);
+    EXPECT_EQ(message.day, game.getMarket()->getCurrentDay());
+    EXPECT_DOUBLE_EQ(message.state.indexValue, game.getMarket()->getMarketIndex());
+}
@@ -382,6 +382,27 @@ TEST_F(NewsServiceTest, BackwardCompatibilityFromJson) {
     EXPECT_EQ(history[0].getPublishDate(), expectedDate);
 }
 
+TEST_F(NewsServiceTest, GeneratedNewsIsSavedWithoutText) {
+    auto news = newsService->generateDailyNews(3);
+    ASSERT_FALSE(news.empty());
+
+    nlohmann::json jsonData = newsService->toJson();
+    for (const auto& item : jsonData["news_history"]) {
+        EXPECT_TRUE(item.contains("template_id"));
+        EXPECT_FALSE(item.contains("title"));
+        EXPECT_FALSE(item.contains("content"));
+    }
+
+    auto newService = NewsService::fromJson(jsonData, market);
+    const auto& history = newService.getNewsHistory();
+    ASSERT_EQ(history.size(), newsService->getNewsHistory().size());
+
+    for (size_t i = 0; i < history.size(); ++i) {
+        EXPECT_EQ(newService.getNewsTitle(history[i]), newsService->getNewsTitle(newsService->getNewsHistory()[i]));
+        EXPECT_EQ(newService.getNewsContent(history[i]), history[i].getContent());
+    }
+}
+
 TEST_F(NewsServiceTest, OperationsWithEmptyMarket) {
     // Create a service with empty market - fix the syntax here
     std::weak_ptr<Market> emptyMarket; // Create empty weak_ptr this way
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <unistd.h>
+#include "../../src/services/OrderGateway.hpp"
+#include "../../src/services/OrderGatewayClient.hpp"
+#include "../../src/core/Game.hpp"
+#include "../TestSupport.hpp"
+
+using namespace StockMarketSimulator;
+
+class OrderGatewayTest : public ::testing::Test {
+protected:
+    std::string socketPath;
+    ScopedSavesDirectory saves;
+
+    void SetUp() override {
+        socketPath = "/tmp/smp_order_gateway_" + std::to_string(getpid()) + ".sock";
+    }
+
+    // Collects reports until `count` have arrived or the gateway goes quiet.
+    static std::vector<OrderReport> receiveReports(OrderGatewayClient& client, size_t count) {
+        std::vector<OrderReport> reports;
+        OrderGatewayMessage message;
+        while (reports.size() < count && client.receive(message, 2000)) {
+            reports.insert(reports.end(), message.reports.begin(), message.reports.end());
+        }
+        return reports;
+    }
+};
+
+TEST_F(OrderGatewayTest, FramesRoundTrip) {
+    std::string wire;
+    OrderGatewayProtocol::appendOrders(wire, {{7, OrderSide::Buy, "TECH", 25, true},
+                                              {8, OrderSide::Sell, "BANK", 3, false}});
+    OrderGatewayProtocol::appendReports(wire, {{7, OrderStatus::Filled, "TECH", 25, 101.5, 12, ""}});
+
+    std::string partial = wire.substr(0, OrderGatewayProtocol::HEADER_SIZE + 4);
+    OrderGatewayMessage message;
+    EXPECT_FALSE(OrderGatewayProtocol::extractMessage(partial, message));
+
+    ASSERT_TRUE(OrderGatewayProtocol::extractMessage(wire, message));
+    EXPECT_EQ(message.type, OrderGatewayMessageType::SubmitOrders);
+    ASSERT_EQ(message.orders.size(), 2u);
+    EXPECT_EQ(message.orders[0].clientOrderId, 7u);
+    EXPECT_TRUE(message.orders[0].useMargin);
+    EXPECT_EQ(message.orders[1].side, OrderSide::Sell);
+    EXPECT_EQ(message.orders[1].ticker, "BANK");
+    EXPECT_EQ(message.orders[1].quantity, 3);
+
+    ASSERT_TRUE(OrderGatewayProtocol::extractMessage(wire, message));
+    EXPECT_EQ(message.type, OrderGatewayMessageType::Reports);
+    ASSERT_EQ(message.reports.size(), 1u);
+    EXPECT_EQ(message.reports[0].status, OrderStatus::Filled);
+    EXPECT_DOUBLE_EQ(message.reports[0].price, 101.5);
+    EXPECT_EQ(message.reports[0].day, 12);
+    EXPECT_TRUE(wire.empty());
+}
+
+TEST_F(OrderGatewayTest, PipelinedBatchesAreAcknowledged) {
+    OrderGateway gateway(socketPath);
+    ASSERT_TRUE(gateway.start()) << gateway.getLastError();
+
+    OrderGatewayClient client;
+    ASSERT_TRUE(client.connect(socketPath)) << client.getLastError();
+
+    uint64_t nextId = 1;
+    for (int batch = 0; batch < 20; ++batch) {
+        std::vector<OrderRequest> orders;
+        for (int i = 0; i < 250; ++i) {
+            orders.push_back({nextId++, OrderSide::Buy, "TECH", (i == 0) ? 0 : 1, false});
+        }
+        ASSERT_TRUE(client.submit(orders));
+    }
+
+    auto reports = receiveReports(client, 5000);
+    ASSERT_EQ(reports.size(), 5000u);
+
+    size_t rejected = 0;
+    for (size_t i = 0; i < reports.size(); ++i) {
+        EXPECT_EQ(reports[i].clientOrderId, i + 1);
+        if (reports[i].status == OrderStatus::Rejected) {
+            ++rejected;
+        }
+    }
+    EXPECT_EQ(rejected, 20u);
+    EXPECT_EQ(gateway.getReceivedOrders(), 5000u);
+    EXPECT_EQ(gateway.getPendingOrderCount(), 4980u);
+}
+
+TEST_F(OrderGatewayTest, DisconnectsClientsThatStopReading) {
+    OrderGateway gateway(socketPath, OrderGateway::DEFAULT_MAX_PENDING_ORDERS, 4096);
+    ASSERT_TRUE(gateway.start()) << gateway.getLastError();
+
+    OrderGatewayClient reader;
+    OrderGatewayClient stalled;
+    ASSERT_TRUE(reader.connect(socketPath));
+    ASSERT_TRUE(stalled.connect(socketPath));
+
+    uint64_t nextId = 1;
+    for (int batch = 0; batch < 200 && gateway.getDisconnectedClients() == 0; ++batch) {
+        std::vector<OrderRequest> orders;
+        for (int i = 0; i < 500; ++i) {
+            orders.push_back({nextId++, OrderSide::Buy, "TECH", 1, false});
+        }
+        if (!stalled.submit(orders)) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < 200 && gateway.getClientCount() != 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(gateway.getDisconnectedClients(), 1u);
+    EXPECT_EQ(gateway.getClientCount(), 1u);
+    EXPECT_EQ(gateway.getPendingOrderCount(), 0u);
+
+    ASSERT_TRUE(reader.submit({{1, OrderSide::Buy, "TECH", 1, false}}));
+    auto reports = receiveReports(reader, 1);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].status, OrderStatus::Accepted);
+}
+
+TEST_F(OrderGatewayTest, GameExecutesOrdersAtDayBoundary) {
+    auto gateway = std::make_shared<OrderGateway>(socketPath);
+    ASSERT_TRUE(gateway->start());
+
+    Game game;
+    game.initialize("Bot", 100000.0);
+    saves.attach(game);
+    game.setOrderGateway(gateway);
+    game.start();
+
+    std::string ticker = game.getMarket()->getCompanies().front()->getTicker();
+
+    OrderGatewayClient client;
+    ASSERT_TRUE(client.connect(socketPath));
+    ASSERT_TRUE(client.submit({{1, OrderSide::Buy, ticker, 10, false},
+                               {2, OrderSide::Sell, ticker, 4, false},
+                               {3, OrderSide::Sell, ticker, 50, false},
+                               {4, OrderSide::Buy, "NOPE", 1, false}}));
+
+    auto acknowledgements = receiveReports(client, 4);
+    ASSERT_EQ(acknowledgements.size(), 4u);
+    for (const auto& ack : acknowledgements) {
+        EXPECT_EQ(ack.status, OrderStatus::Accepted);
+    }
+    EXPECT_EQ(game.getPlayer()->getPortfolio()->getPositionQuantity(ticker), 0);
+
+    double price = game.getMarket()->getCompanyByTicker(ticker)->getStock()->getCurrentPrice();
+    int day = game.getMarket()->getCurrentDay();
+    ASSERT_TRUE(game.simulateDay());
+
+    std::map<uint64_t, OrderReport> fills;
+    for (const auto& report : receiveReports(client, 4)) {
+        fills[report.clientOrderId] = report;
+    }
+    ASSERT_EQ(fills.size(), 4u);
+
+    EXPECT_EQ(fills[1].status, OrderStatus::Filled);
+    EXPECT_DOUBLE_EQ(fills[1].price, price);
+    EXPECT_EQ(fills[1].day, day);
+    EXPECT_EQ(fills[2].status, OrderStatus::Filled);
+    EXPECT_EQ(fills[3].status, OrderStatus::Rejected);
+    EXPECT_EQ(fills[3].reason, "Insufficient position");
+    EXPECT_EQ(fills[4].status, OrderStatus::Rejected);
+    EXPECT_EQ(fills[4].reason, "Unknown ticker");
+
+    EXPECT_EQ(game.getPlayer()->getPortfolio()->getPositionQuantity(ticker), 6);
+    EXPECT_EQ(gateway->getFilledOrders(), 2u);
+    EXPECT_EQ(gateway->getRejectedOrders(), 2u);
+}
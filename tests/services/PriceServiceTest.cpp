@@ -336,6 +336,7 @@ TEST_F(PriceServiceTest, MultiSectorComparisonTest) {
 
     ASSERT_GT(techChange, 0.1);
 }
+
 TEST_F(PriceServiceTest, WeakPtrTest) {
     PriceService emptyService;
     
@@ -352,4 +353,101 @@ TEST_F(PriceServiceTest, WeakPtrTest) {
     }
     
     ASSERT_NO_THROW(emptyService.updatePrices());
-}
\ No newline at end of file
+}
+
+TEST_F(PriceServiceTest, DefaultSectorProfileTableTest) {
+    static_assert(DEFAULT_SECTOR_PROFILES[sectorIndex(Sector::Technology)].baseVolatility == 0.05,
+                  "default profiles are built at compile time");
+
+    for (size_t i = 0; i < SECTOR_COUNT; ++i) {
+        Sector sector = static_cast<Sector>(i);
+        ASSERT_EQ(priceService->getSectorProfile(sector).baseVolatility,
+                  DEFAULT_SECTOR_PROFILES[i].baseVolatility);
+    }
+}
+
+TEST_F(PriceServiceTest, SectorProfileJsonOverrideTest) {
+    nlohmann::json json = priceService->toJson();
+    json["sector_profiles"] = nlohmann::json::object();
+    json["sector_profiles"]["Energy"] = SectorVolatilityProfile(0.04, 0.1, 0.2, 0.3).toJson();
+
+    PriceService restored = PriceService::fromJson(json, market);
+
+    ASSERT_EQ(restored.getSectorProfile(Sector::Energy).baseVolatility, 0.04);
+    ASSERT_EQ(restored.getSectorProfile(Sector::Energy).cycleSensitivity, 0.3);
+    ASSERT_EQ(restored.getSectorProfile(Sector::Finance).baseVolatility,
+              DEFAULT_SECTOR_PROFILES[sectorIndex(Sector::Finance)].baseVolatility);
+}
+
+TEST_F(PriceServiceTest, TrendKernelMatchesPerCompanyPathTest) {
+    const MarketTrend trends[] = {MarketTrend::Bullish, MarketTrend::Bearish,
+                                  MarketTrend::Sideways, MarketTrend::Volatile};
+
+    for (MarketTrend trend : trends) {
+        auto referenceMarket = market->branch();
+        auto referenceService = std::make_unique<PriceService>(referenceMarket);
+
+        market->setMarketTrend(trend);
+        referenceMarket->setMarketTrend(trend);
+
+        Random::initialize(7);
+        for (int day = 0; day < 5; day++) {
+            priceService->updatePrices();
+        }
+
+        Random::initialize(7);
+        for (int day = 0; day < 5; day++) {
+            for (const auto& company : referenceMarket->getCompanies()) {
+                double movement = referenceService->generatePriceMovement(company, trend);
+                company->updatePrice(company->getStock()->getCurrentPrice() * (1.0 + movement));
+            }
+            referenceService->advanceEconomicCycle();
+        }
+
+        for (const auto& company : market->getCompanies()) {
+            auto reference = referenceMarket->getCompanyByTicker(company->getTicker());
+            ASSERT_NE(reference, nullptr);
+            ASSERT_DOUBLE_EQ(company->getStock()->getCurrentPrice(),
+                             reference->getStock()->getCurrentPrice());
+        }
+
+        priceService = std::make_unique<PriceService>(market);
+    }
+}
+
+TEST_F(PriceServiceTest, NoMarketSkipsSectorComponentTest) {
+    PriceService detachedService;
+    auto techCompany = market->getCompanyByTicker("TTECH");
+    auto energyCompany = market->getCompanyByTicker("TENRG");
+
+    // Without a market neither sector draws its noise, so both consume the
+    // same random numbers.
+    Random::initialize(5);
+    detachedService.generatePriceMovement(techCompany, MarketTrend::Sideways);
+    std::string techState = Random::getState();
+
+    Random::initialize(5);
+    detachedService.generatePriceMovement(energyCompany, MarketTrend::Sideways);
+    ASSERT_EQ(Random::getState(), techState);
+}
+
+TEST_F(PriceServiceTest, MovementHistoriesFollowMembershipTest) {
+    priceService->updatePrices();
+
+    market->removeCompany("TENRG");
+    market->addCompany(std::make_shared<Company>(
+        "Test Consumer", "TCONS",
+        "Test consumer company", Sector::Consumer,
+        40.0, 0.3, DividendPolicy(2.0, 4)
+    ));
+    priceService->updatePrices();
+
+    ASSERT_EQ(priceService->getPriceMovementHistory("TTECH").size(), 2);
+    ASSERT_EQ(priceService->getPriceMovementHistory("TFIN").size(), 2);
+    ASSERT_EQ(priceService->getPriceMovementHistory("TCONS").size(), 1);
+    ASSERT_EQ(priceService->getPriceMovementHistory("TENRG").size(), 1);
+
+    PriceService restored = PriceService::fromJson(priceService->toJson(), market);
+    ASSERT_EQ(restored.getPriceMovementHistory("TENRG"), priceService->getPriceMovementHistory("TENRG"));
+    ASSERT_EQ(restored.getPriceMovementHistory("TTECH"), priceService->getPriceMovementHistory("TTECH"));
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <thread>
+#include <ctime>
+#include <utime.h>
 #include "../../src/services/SaveService.hpp"
 #include "../../src/core/Market.hpp"
 #include "../../src/core/Player.hpp"
@@ -285,4 +288,211 @@ TEST_F(SaveServiceTest, SaveAndLoadWithAllComponents) {
 
     // Verify news service data loaded correctly
     EXPECT_FALSE(newNewsService->getNewsHistory().empty());
-}
\ No newline at end of file
+}
+TEST_F(SaveServiceTest, ReadsSectionsWithoutLoadingTheSave) {
+    progressGame(3);
+    ASSERT_TRUE(saveService->saveGame("Sections"));
+    std::string filename = saveService->listSaves()[0].filename;
+
+    nlohmann::json playerJson;
+    ASSERT_TRUE(saveService->readSaveSection(filename, "player", playerJson));
+    EXPECT_EQ(playerJson["name"], "TestPlayer");
+
+    nlohmann::json marketJson;
+    ASSERT_TRUE(saveService->readSaveSection(filename, "market", marketJson));
+    EXPECT_FALSE(marketJson["companies"][0]["stock"].contains("price_history"));
+    EXPECT_FALSE(saveService->readSaveSection(filename, "missing", marketJson));
+
+    // Without the .meta file the preview comes from the save's own section.
+    std::string metadataPath = FileIO::combineFilePath(testSavesDirectory, filename + ".meta");
+    std::remove(metadataPath.c_str());
+    SaveMetadata metadata = saveService->getSaveMetadata(filename);
+    EXPECT_EQ(metadata.displayName, "Sections");
+    EXPECT_EQ(metadata.gameDate, player->getCurrentDate());
+
+    // So does a .meta file that was torn, since it is written without a sync.
+    FileIO::writeTextFile(metadataPath, "{\"display");
+    metadata = saveService->getSaveMetadata(filename);
+    EXPECT_EQ(metadata.displayName, "Sections");
+    EXPECT_TRUE(metadata.errorMessage.empty());
+}
+
+TEST_F(SaveServiceTest, PagesInHistoriesOnFirstAccess) {
+    progressGame(6);
+    newsService->generateDailyNews(3);
+    ASSERT_TRUE(saveService->saveGame("Lazy"));
+
+    auto newMarket = std::make_shared<Market>();
+    auto newPlayer = std::make_shared<Player>("NewPlayer", 5000.0);
+    auto newNewsService = std::make_shared<NewsService>(newMarket);
+    auto newPriceService = std::make_shared<PriceService>(newMarket);
+    SaveService loader(newMarket, newPlayer, newNewsService, newPriceService);
+    loader.initialize(testSavesDirectory);
+    ASSERT_TRUE(loader.loadGame(loader.listSaves()[0].filename));
+
+    Stock* original = market->getCompanyByTicker("TCH")->getStock();
+    Stock* loaded = newMarket->getCompanyByTicker("TCH")->getStock();
+    EXPECT_FALSE(loaded->isPriceHistoryLoaded());
+    EXPECT_FALSE(newNewsService->isNewsHistoryLoaded());
+    EXPECT_DOUBLE_EQ(loaded->getCurrentPrice(), original->getCurrentPrice());
+
+    EXPECT_EQ(loaded->getPriceHistory(), original->getPriceHistory());
+    EXPECT_TRUE(loaded->isPriceHistoryLoaded());
+    EXPECT_EQ(newNewsService->getNewsHistory().size(), newsService->getNewsHistory().size());
+    EXPECT_TRUE(newNewsService->isNewsHistoryLoaded());
+
+    // Prices recorded after loading extend the paged-in history.
+    Stock* other = newMarket->getCompanyByTicker("BANK")->getStock();
+    size_t length = market->getCompanyByTicker("BANK")->getStock()->getPriceHistoryLength();
+    other->updatePrice(other->getCurrentPrice() * 1.01);
+    EXPECT_EQ(other->getPriceHistoryLength(), length + 1);
+}
+
+TEST_F(SaveServiceTest, SavesAtomicallyAtEachDurability) {
+    EXPECT_EQ(saveService->getDurability(false), Durability::Full);
+    EXPECT_EQ(saveService->getDurability(true), Durability::Data);
+
+    saveService->setDurability(Durability::Data, Durability::Atomic);
+    EXPECT_EQ(saveService->getDurability(true), Durability::Atomic);
+
+    ASSERT_TRUE(saveService->saveGame("Manual"));
+    ASSERT_TRUE(saveService->saveGame("Auto", true));
+
+    for (const auto& file : FileIO::listFiles(testSavesDirectory)) {
+        EXPECT_EQ(file.find(".tmp"), std::string::npos) << file;
+    }
+
+    std::vector<SaveMetadata> saves = saveService->listSaves();
+    ASSERT_EQ(saves.size(), 2u);
+    for (const auto& save : saves) {
+        EXPECT_TRUE(save.errorMessage.empty());
+        EXPECT_TRUE(saveService->loadGame(save.filename));
+    }
+}
+
+TEST_F(SaveServiceTest, ListsSavesWithTornMetadata) {
+    progressGame(5);
+    ASSERT_TRUE(saveService->saveGame("Torn"));
+    std::string filename = saveService->listSaves()[0].filename;
+
+    std::string metadataPath = FileIO::combineFilePath(testSavesDirectory, filename + ".meta");
+    std::string metadata = FileIO::readTextFile(metadataPath);
+    FileIO::writeTextFile(metadataPath, metadata.substr(0, metadata.size() / 2));
+
+    std::vector<SaveMetadata> saves = saveService->listSaves();
+    ASSERT_EQ(saves.size(), 1u);
+    EXPECT_EQ(saves[0].filename, filename);
+    EXPECT_EQ(saves[0].displayName, "Torn");
+    EXPECT_NEAR(saves[0].playerNetWorth, player->getNetWorth(), 0.01);
+    EXPECT_EQ(saves[0].gameDate, player->getCurrentDate());
+}
+
+TEST_F(SaveServiceTest, RemovesOnlyStaleUnfinishedSaves) {
+    ASSERT_TRUE(saveService->saveGame("Kept"));
+    std::string filename = saveService->listSaves()[0].filename;
+
+    std::string orphan = FileIO::combineFilePath(testSavesDirectory, filename + ".tmp.a1B2c3");
+    std::string inFlight = FileIO::combineFilePath(testSavesDirectory, filename + ".tmp.d4E5f6");
+    std::string lookalike = FileIO::combineFilePath(testSavesDirectory, "notes.tmp.txt");
+    FileIO::writeTextFile(orphan, "{\"partial\":");
+    FileIO::writeTextFile(inFlight, "{\"partial\":");
+    FileIO::writeTextFile(lookalike, "kept");
+
+    std::time_t past = std::time(nullptr) - 2 * SaveService::UNFINISHED_SAVE_AGE_SECONDS;
+    struct utimbuf times{past, past};
+    ASSERT_EQ(utime(orphan.c_str(), &times), 0);
+
+    // Pointing a service at the directory, as branching does, leaves it alone.
+    SaveService restarted(market, player, newsService, priceService);
+    restarted.initialize(testSavesDirectory);
+    EXPECT_TRUE(FileIO::fileExists(orphan));
+
+    EXPECT_EQ(restarted.removeUnfinishedSaves(), 1u);
+    EXPECT_FALSE(FileIO::fileExists(orphan));
+    EXPECT_TRUE(FileIO::fileExists(inFlight));
+    EXPECT_TRUE(FileIO::fileExists(lookalike));
+    ASSERT_EQ(restarted.listSaves().size(), 1u);
+    EXPECT_EQ(restarted.listSaves()[0].displayName, "Kept");
+}
+
+TEST_F(SaveServiceTest, PagesInFromTheLoadedFileOnly) {
+    progressGame(6);
+    ASSERT_TRUE(saveService->saveGame("Lazy"));
+
+    auto newMarket = std::make_shared<Market>();
+    auto newPlayer = std::make_shared<Player>("NewPlayer", 5000.0);
+    auto newNewsService = std::make_shared<NewsService>(newMarket);
+    auto newPriceService = std::make_shared<PriceService>(newMarket);
+    SaveService loader(newMarket, newPlayer, newNewsService, newPriceService);
+    loader.initialize(testSavesDirectory);
+    std::string filename = loader.listSaves()[0].filename;
+    ASSERT_TRUE(loader.loadGame(filename));
+
+    // Replacing or deleting the save afterwards does not change what pages in.
+    std::string filePath = FileIO::combineFilePath(testSavesDirectory, filename);
+    FileIO::writeFileAtomically(filePath, "{}");
+    std::remove(filePath.c_str());
+
+    Stock* loaded = newMarket->getCompanyByTicker("TCH")->getStock();
+    std::vector<size_t> lengths(4, 0);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        readers.emplace_back([loaded, &lengths, i] { lengths[i] = loaded->getPriceHistoryLength(); });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(loaded->getPriceHistory(), market->getCompanyByTicker("TCH")->getStock()->getPriceHistory());
+    for (size_t length : lengths) {
+        EXPECT_EQ(length, loaded->getPriceHistory().size());
+    }
+
+    std::vector<size_t> newsCounts(4, 0);
+    std::vector<std::thread> newsReaders;
+    for (size_t i = 0; i < newsCounts.size(); ++i) {
+        newsReaders.emplace_back([&newNewsService, &newsCounts, i] {
+            newsCounts[i] = newNewsService->getNewsHistory().size();
+        });
+    }
+    for (auto& reader : newsReaders) {
+        reader.join();
+    }
+
+    EXPECT_TRUE(newNewsService->isNewsHistoryLoaded());
+    for (size_t count : newsCounts) {
+        EXPECT_EQ(count, newsService->getNewsHistory().size());
+    }
+}
+
+TEST_F(SaveServiceTest, FailedPageInStaysPendingAndBlocksSaving) {
+    progressGame(6);
+    newsService->generateDailyNews(3);
+    ASSERT_TRUE(saveService->saveGame("Lazy"));
+
+    auto newMarket = std::make_shared<Market>();
+    auto newPlayer = std::make_shared<Player>("NewPlayer", 5000.0);
+    auto newNewsService = std::make_shared<NewsService>(newMarket);
+    auto newPriceService = std::make_shared<PriceService>(newMarket);
+    SaveService loader(newMarket, newPlayer, newNewsService, newPriceService);
+    loader.initialize(testSavesDirectory);
+    std::string filename = loader.listSaves()[0].filename;
+    ASSERT_TRUE(loader.loadGame(filename));
+
+    // Truncating the file in place breaks the sections the loader reads later.
+    std::string filePath = FileIO::combineFilePath(testSavesDirectory, filename);
+    std::string content = FileIO::readTextFile(filePath);
+    FileIO::writeTextFile(filePath, content.substr(0, 64));
+
+    Stock* loaded = newMarket->getCompanyByTicker("TCH")->getStock();
+    EXPECT_THROW(loaded->getPriceHistory(), std::runtime_error);
+    EXPECT_FALSE(loaded->isPriceHistoryLoaded());
+    EXPECT_THROW(newNewsService->getNewsHistory(), std::runtime_error);
+    EXPECT_FALSE(newNewsService->isNewsHistoryLoaded());
+    EXPECT_FALSE(loader.saveGame("Overwrite"));
+
+    FileIO::writeTextFile(filePath, content);
+    EXPECT_EQ(loaded->getPriceHistory(), market->getCompanyByTicker("TCH")->getStock()->getPriceHistory());
+    EXPECT_EQ(newNewsService->getNewsHistory().size(), newsService->getNewsHistory().size());
+    EXPECT_TRUE(loader.saveGame("Overwrite"));
+}
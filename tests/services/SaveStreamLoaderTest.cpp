@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../../src/core/Game.hpp"
+#include "../../src/services/SaveStreamLoader.hpp"
+#include "../../src/services/SaveService.hpp"
+#include "../TestSupport.hpp"
+
+using namespace StockMarketSimulator;
+
+class SaveStreamLoaderTest : public ::testing::Test {
+protected:
+    std::shared_ptr<Game> game;
+    ScopedSavesDirectory saves;
+
+    void SetUp() override {
+        Random::initialize(21);
+        game = std::make_shared<Game>();
+        game->initialize("Streamer", 50000.0);
+        saves.attach(*game);
+        game->start();
+        game->simulateDays(4);
+        game->buyStock("ITECH", 10);
+        game->buyStock("BANK", 5);
+        game->simulateDays(4);
+        game->sellStock("ITECH", 4);
+        game->simulateDays(2);
+    }
+
+    template<typename Json>
+    Json saveDocument() const {
+        Json document;
+        document["save_version"] = 1;
+        document["player"] = game->getPlayer()->toJson();
+        document["price_service"] = game->getPriceService()->toJson();
+        document["news_service"] = game->getNewsService()->toJson();
+        document["market"] = game->getMarket()->toJson();
+        return document;
+    }
+};
+
+TEST_F(SaveStreamLoaderTest, BuildsTheSameObjectsAsTheDomLoader) {
+    auto document = saveDocument<nlohmann::json>();
+    auto domMarket = std::make_shared<Market>(Market::fromJson(document["market"]));
+    Player domPlayer = Player::fromJson(document["player"], domMarket);
+
+    std::istringstream input(document.dump());
+    SaveStreamLoader loader;
+    ASSERT_TRUE(loader.load(input)) << loader.getLastError();
+    EXPECT_EQ(loader.getSaveVersion(), 1);
+
+    EXPECT_EQ(loader.getMarket()->toJson(), domMarket->toJson());
+    EXPECT_EQ(loader.getPlayer()->toJson(), domPlayer.toJson());
+    EXPECT_EQ(loader.getNewsService()->toJson(), game->getNewsService()->toJson());
+    EXPECT_EQ(loader.getPriceService()->toJson(), game->getPriceService()->toJson());
+
+    // Positions and ledger entries refer to the loaded market's companies.
+    auto company = loader.getMarket()->getCompanyByTicker("ITECH");
+    const Portfolio* portfolio = loader.getPlayer()->getPortfolio();
+    EXPECT_EQ(portfolio->getPosition("ITECH")->company, company);
+    ASSERT_EQ(portfolio->getTransactions().size(), 3u);
+    EXPECT_EQ(portfolio->getTransactions()[0].getCompany().lock(), company);
+}
+
+TEST_F(SaveStreamLoaderTest, AcceptsSectionsInAnyOrder) {
+    // ordered_json keeps insertion order, so the player and news sections
+    // arrive before the market they depend on.
+    std::istringstream input(saveDocument<nlohmann::ordered_json>().dump());
+
+    SaveStreamLoader loader;
+    ASSERT_TRUE(loader.load(input)) << loader.getLastError();
+    auto domMarket = std::make_shared<Market>(Market::fromJson(game->getMarket()->toJson()));
+    EXPECT_EQ(loader.getPlayer()->toJson(),
+              Player::fromJson(game->getPlayer()->toJson(), domMarket).toJson());
+    EXPECT_EQ(loader.getNewsService()->getNewsHistory().size(),
+              game->getNewsService()->getNewsHistory().size());
+    EXPECT_EQ(loader.getPlayer()->getPortfolio()->getPosition("BANK")->company,
+              loader.getMarket()->getCompanyByTicker("BANK"));
+}
+
+TEST_F(SaveStreamLoaderTest, StreamsSectionedSavesEagerly) {
+    SaveService saveService(game->getMarket(), game->getPlayer(), game->getNewsService(), game->getPriceService());
+    saveService.initialize(saves.getPath());
+    ASSERT_TRUE(saveService.saveGame("Sectioned"));
+    std::string filename = saveService.listSaves()[0].filename;
+    std::string filePath = FileIO::combineFilePath(saves.getPath(), filename);
+
+    SaveStreamLoader loader;
+    std::istringstream input(FileIO::readTextFile(filePath));
+    bool loaded = loader.load(input);
+
+    ASSERT_TRUE(loaded) << loader.getLastError();
+    EXPECT_EQ(loader.getSaveVersion(), SaveStreamLoader::LATEST_SAVE_VERSION);
+    EXPECT_EQ(loader.getMarket()->getCompanyByTicker("ITECH")->getStock()->getPriceHistory(),
+              game->getMarket()->getCompanyByTicker("ITECH")->getStock()->getPriceHistory());
+    EXPECT_EQ(loader.getNewsService()->getNewsHistory().size(),
+              game->getNewsService()->getNewsHistory().size());
+}
+
+TEST_F(SaveStreamLoaderTest, RejectsDamagedOrUnsupportedSaves) {
+    std::string text = saveDocument<nlohmann::json>().dump();
+
+    SaveStreamLoader loader;
+    std::istringstream truncated(text.substr(0, text.size() / 2));
+    EXPECT_FALSE(loader.load(truncated));
+    EXPECT_NE(loader.getLastError().find("Failed to parse"), std::string::npos);
+
+    auto future = saveDocument<nlohmann::json>();
+    future["save_version"] = SaveStreamLoader::LATEST_SAVE_VERSION + 1;
+    std::istringstream futureInput(future.dump());
+    EXPECT_FALSE(loader.load(futureInput));
+
+    auto partial = saveDocument<nlohmann::json>();
+    partial.erase("player");
+    std::istringstream partialInput(partial.dump());
+    EXPECT_FALSE(loader.load(partialInput));
+    EXPECT_EQ(loader.getPlayer(), nullptr);
+
+    EXPECT_FALSE(loader.loadFile("missing/save.json"));
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../../src/services/SharedMarketFeed.hpp"
+#include "../../src/core/Market.hpp"
+
+using namespace StockMarketSimulator;
+
+class SharedMarketFeedTest : public ::testing::Test {
+protected:
+    std::string feedName;
+
+    void SetUp() override {
+        feedName = "/smp_feed_test_" + std::to_string(getpid());
+    }
+};
+
+TEST_F(SharedMarketFeedTest, PublishesMarketColumnsOnSimulatedDay) {
+    auto feed = std::make_shared<SharedMarketFeed>(feedName);
+    ASSERT_TRUE(feed->open()) << feed->getLastError();
+
+    Market market;
+    market.addDefaultCompanies();
+    market.setSharedFeed(feed);
+    market.simulateDay();
+
+    SharedMarketFeedReader reader(feedName);
+    SharedFeedSnapshot snapshot;
+    ASSERT_TRUE(reader.read(snapshot)) << reader.getLastError();
+
+    const auto& companies = market.getCompanies();
+    ASSERT_EQ(snapshot.size(), companies.size());
+    EXPECT_EQ(snapshot.day, market.getCurrentDay());
+    EXPECT_DOUBLE_EQ(snapshot.state.indexValue, market.getState().indexValue);
+    EXPECT_EQ(snapshot.state.currentTrend, market.getCurrentTrend());
+    EXPECT_EQ(snapshot.sequence % 2, 0u);
+
+    for (size_t i = 0; i < companies.size(); ++i) {
+        const Stock* stock = companies[i]->getStock();
+        EXPECT_EQ(snapshot.tickers[i], companies[i]->getTicker());
+        EXPECT_DOUBLE_EQ(snapshot.currentPrices[i], stock->getCurrentPrice());
+        EXPECT_DOUBLE_EQ(snapshot.openPrices[i], stock->getOpenPrice());
+        EXPECT_DOUBLE_EQ(snapshot.previousClosePrices[i], stock->getPreviousClosePrice());
+        EXPECT_DOUBLE_EQ(snapshot.highPrices[i], stock->getHighestPrice());
+        EXPECT_DOUBLE_EQ(snapshot.lowPrices[i], stock->getLowestPrice());
+    }
+
+    int index = snapshot.indexOf(companies.back()->getTicker());
+    EXPECT_EQ(index, static_cast<int>(companies.size() - 1));
+    EXPECT_EQ(snapshot.indexOf("NOPE"), -1);
+}
+
+TEST_F(SharedMarketFeedTest, ReaderReattachesWhenFeedGrows) {
+    SharedMarketFeed feed(feedName, 2);
+    ASSERT_TRUE(feed.open());
+
+    Market market;
+    SharedMarketFeedReader reader(feedName);
+    SharedFeedSnapshot snapshot;
+    ASSERT_TRUE(feed.publish(market));
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_EQ(snapshot.size(), 0u);
+
+    market.addDefaultCompanies();
+    ASSERT_GT(market.getCompanies().size(), 2u);
+    ASSERT_TRUE(feed.publish(market));
+    EXPECT_GE(feed.getCapacity(), market.getCompanies().size());
+
+    ASSERT_TRUE(reader.read(snapshot)) << reader.getLastError();
+    EXPECT_EQ(snapshot.size(), market.getCompanies().size());
+}
+
+TEST_F(SharedMarketFeedTest, SecondWriterCannotTakeOverLiveFeed) {
+    SharedMarketFeed first(feedName);
+    ASSERT_TRUE(first.open()) << first.getLastError();
+
+    SharedMarketFeed second(feedName);
+    EXPECT_FALSE(second.open());
+    EXPECT_NE(second.getLastError().find("another writer"), std::string::npos);
+
+    Market market;
+    market.addDefaultCompanies();
+    ASSERT_TRUE(first.publish(market));
+
+    SharedMarketFeedReader reader(feedName);
+    SharedFeedSnapshot snapshot;
+    ASSERT_TRUE(reader.read(snapshot)) << reader.getLastError();
+    EXPECT_EQ(snapshot.size(), market.getCompanies().size());
+
+    first.close();
+    EXPECT_TRUE(second.open()) << second.getLastError();
+}
+
+TEST_F(SharedMarketFeedTest, ReplacesSegmentLeftByExitedWriter) {
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Exit without closing, as a crashed writer would.
+        auto* abandoned = new SharedMarketFeed(feedName);
+        _exit(abandoned->open() ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    SharedMarketFeed feed(feedName);
+    EXPECT_TRUE(feed.open()) << feed.getLastError();
+}
+
+TEST_F(SharedMarketFeedTest, ConcurrentReadersNeverSeeTornSnapshots) {
+    SharedMarketFeed feed(feedName);
+    ASSERT_TRUE(feed.open());
+
+    Market market;
+    market.addDefaultCompanies();
+    for (const auto& company : market.getCompanies()) {
+        company->updatePrice(1.0);
+    }
+    ASSERT_TRUE(feed.publish(market));
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (int round = 1; round <= 2000; ++round) {
+            for (const auto& company : market.getCompanies()) {
+                company->updatePrice(static_cast<double>(round));
+            }
+            feed.publish(market);
+        }
+        done = true;
+    });
+
+    SharedMarketFeedReader reader(feedName);
+    SharedFeedSnapshot snapshot;
+    int consistentReads = 0;
+    int tornReads = 0;
+    uint64_t lastSequence = 0;
+    bool finished = false;
+    while (!finished) {
+        finished = done;
+        if (!reader.read(snapshot)) {
+            continue;
+        }
+        if (snapshot.sequence < lastSequence || snapshot.currentPrices.size() != market.getCompanies().size()) {
+            ++tornReads;
+            continue;
+        }
+        lastSequence = snapshot.sequence;
+
+        double expected = snapshot.currentPrices.front();
+        bool uniform = std::all_of(snapshot.currentPrices.begin(), snapshot.currentPrices.end(),
+                                   [expected](double price) { return price == expected; });
+        if (uniform) {
+            ++consistentReads;
+        } else {
+            ++tornReads;
+        }
+    }
+    writer.join();
+
+    EXPECT_EQ(tornReads, 0);
+    EXPECT_GT(consistentReads, 0);
+}
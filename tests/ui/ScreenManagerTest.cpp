@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "../../src/ui/ScreenManager.hpp"
+
+using namespace StockMarketSimulator;
+
+class CountingScreen : public Screen {
+protected:
+    void drawContent() const override {
+    }
+
+public:
+    int initializeCount = 0;
+    int updateCount = 0;
+    int layoutCount = 0;
+
+    explicit CountingScreen(ScreenType type) : Screen("Counting", type) {
+        // Invisible screens return from run() immediately
+        setVisible(false);
+    }
+
+    void initialize() override {
+        ++initializeCount;
+    }
+
+    void update() override {
+        ++updateCount;
+    }
+
+    void layout() override {
+        ++layoutCount;
+    }
+};
+
+TEST(ScreenManagerTest, KeepsOneInstancePerType) {
+    ScreenManager manager;
+    auto market = std::make_shared<CountingScreen>(ScreenType::Market);
+    auto news = std::make_shared<CountingScreen>(ScreenType::News);
+
+    manager.add(market);
+    manager.add(news);
+    manager.add(nullptr);
+
+    EXPECT_EQ(manager.size(), 2u);
+    EXPECT_TRUE(manager.contains(ScreenType::Market));
+    EXPECT_FALSE(manager.contains(ScreenType::Portfolio));
+    EXPECT_EQ(manager.get(ScreenType::News), news);
+    EXPECT_EQ(manager.get(ScreenType::Financial), nullptr);
+
+    manager.clear();
+    EXPECT_EQ(manager.size(), 0u);
+}
+
+TEST(ScreenManagerTest, InitializesOnceAndRefreshesOnReturn) {
+    ScreenManager manager;
+    CountingScreen origin(ScreenType::Main);
+    auto market = std::make_shared<CountingScreen>(ScreenType::Market);
+    manager.add(market);
+
+    EXPECT_TRUE(manager.show(ScreenType::Market, origin));
+    EXPECT_TRUE(manager.show(ScreenType::Market, origin));
+    EXPECT_TRUE(manager.show(ScreenType::Market, origin));
+
+    EXPECT_EQ(market->initializeCount, 1);
+    EXPECT_EQ(market->updateCount, 2);
+    EXPECT_FALSE(manager.show(ScreenType::News, origin));
+}
+
+TEST(ScreenManagerTest, ResizeFitsScreenIntoTerminal) {
+    CountingScreen screen(ScreenType::Market);
+    screen.setPosition(10, 5);
+    screen.setSize(48, 33);
+
+    screen.onResize(40, 20);
+    EXPECT_EQ(screen.getX(), 0);
+    EXPECT_EQ(screen.getY(), 0);
+    EXPECT_EQ(screen.getWidth(), 40);
+    EXPECT_EQ(screen.getHeight(), 20);
+    EXPECT_EQ(screen.layoutCount, 1);
+
+    screen.onResize(52, 60);
+    EXPECT_EQ(screen.getX(), 4);
+    EXPECT_EQ(screen.getY(), 5);
+    EXPECT_EQ(screen.getWidth(), 48);
+    EXPECT_EQ(screen.getHeight(), 33);
+
+    screen.onResize(200, 60);
+    EXPECT_EQ(screen.getX(), 10);
+    EXPECT_EQ(screen.layoutCount, 3);
+}
+
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include "../../src/utils/AllocationTracker.hpp"
+#include "../../src/utils/WorkStealingPool.hpp"
+
+using namespace StockMarketSimulator;
+
+class AllocationTrackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AllocationTracker::reset();
+    }
+
+    void TearDown() override {
+        AllocationTracker::reset();
+    }
+
+    static const AllocationStats* findTag(const std::vector<AllocationStats>& stats, const std::string& tag) {
+        for (const auto& entry : stats) {
+            if (entry.tag == tag) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(AllocationTrackerTest, CountsBytesAndPeakPerTag) {
+    size_t tag = AllocationTracker::registerTag("test.counters");
+    EXPECT_EQ(AllocationTracker::registerTag("test.counters"), tag);
+
+    AllocationTracker::recordAllocation(tag, 100);
+    AllocationTracker::recordAllocation(tag, 50);
+    AllocationTracker::recordDeallocation(tag, 100);
+    AllocationTracker::recordAllocation(tag, 20);
+
+    auto stats = AllocationTracker::snapshot();
+    const AllocationStats* entry = findTag(stats, "test.counters");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->allocations, 3u);
+    EXPECT_EQ(entry->deallocations, 1u);
+    EXPECT_EQ(entry->bytesAllocated, 170u);
+    EXPECT_EQ(entry->currentBytes, 70u);
+    EXPECT_EQ(entry->peakBytes, 150u);
+
+    AllocationTracker::recordDeallocation(tag, 70);
+    AllocationTracker::reset();
+    stats = AllocationTracker::snapshot();
+    EXPECT_EQ(findTag(stats, "test.counters"), nullptr);
+}
+
+TEST_F(AllocationTrackerTest, ScopesNestAndRestore) {
+    size_t outer = AllocationTracker::registerTag("test.outer");
+    size_t inner = AllocationTracker::registerTag("test.inner");
+    size_t original = AllocationTracker::getCurrentTag();
+
+    {
+        AllocationScope outerScope(outer);
+        EXPECT_EQ(AllocationTracker::getCurrentTag(), outer);
+        {
+            AllocationScope innerScope(inner);
+            EXPECT_EQ(AllocationTracker::getCurrentTag(), inner);
+        }
+        EXPECT_EQ(AllocationTracker::getCurrentTag(), outer);
+    }
+
+    EXPECT_EQ(AllocationTracker::getCurrentTag(), original);
+}
+
+TEST_F(AllocationTrackerTest, HookAttributesAllocationsToScope) {
+    if (!AllocationTracker::isEnabled()) {
+        GTEST_SKIP() << "built without SMP_ALLOCATION_TRACKING";
+    }
+
+    size_t tag = AllocationTracker::registerTag("test.hook");
+    {
+        AllocationScope scope(tag);
+        auto buffer = std::make_unique<char[]>(4096);
+        buffer[0] = 1;
+    }
+
+    auto stats = AllocationTracker::snapshot();
+    const AllocationStats* entry = findTag(stats, "test.hook");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_GE(entry->bytesAllocated, 4096u);
+    EXPECT_EQ(entry->allocations, entry->deallocations);
+    EXPECT_EQ(entry->currentBytes, 0u);
+    EXPECT_GE(entry->peakBytes, 4096u);
+}
+
+TEST_F(AllocationTrackerTest, HookTracksOverAlignedAllocations) {
+    if (!AllocationTracker::isEnabled()) {
+        GTEST_SKIP() << "built without SMP_ALLOCATION_TRACKING";
+    }
+
+    struct alignas(64) CacheLine {
+        char bytes[64];
+    };
+
+    size_t tag = AllocationTracker::registerTag("test.aligned");
+    {
+        AllocationScope scope(tag);
+        auto line = std::make_unique<CacheLine>();
+        auto lines = std::make_unique<CacheLine[]>(3);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(line.get()) % 64, 0u);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(lines.get()) % 64, 0u);
+    }
+
+    auto stats = AllocationTracker::snapshot();
+    const AllocationStats* entry = findTag(stats, "test.aligned");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->allocations, 2u);
+    EXPECT_EQ(entry->allocations, entry->deallocations);
+    EXPECT_EQ(entry->currentBytes, 0u);
+}
+
+TEST_F(AllocationTrackerTest, PoolTasksInheritTheSubmittersTag) {
+    size_t tag = AllocationTracker::registerTag("test.pool");
+    WorkStealingPool pool(4);
+
+    std::atomic<size_t> mismatches(0);
+    {
+        AllocationScope scope(tag);
+        pool.parallelFor(0, 64, 1, [&](size_t) {
+            if (AllocationTracker::getCurrentTag() != tag) {
+                mismatches++;
+            }
+            auto buffer = std::make_unique<char[]>(1024);
+            buffer[0] = 1;
+        });
+    }
+    EXPECT_EQ(mismatches.load(), 0u);
+
+    if (AllocationTracker::isEnabled()) {
+        auto stats = AllocationTracker::snapshot();
+        const AllocationStats* entry = findTag(stats, "test.pool");
+        ASSERT_NE(entry, nullptr);
+        EXPECT_GE(entry->allocations, 64u);
+        EXPECT_GE(entry->bytesAllocated, 64u * 1024u);
+    }
+}
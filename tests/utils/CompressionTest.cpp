@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include "../../src/utils/Compression.hpp"
+#include "../../src/utils/Random.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(CompressionTest, FloatSeriesRoundTripsBitForBit) {
+    Random::initialize(3);
+    std::vector<double> prices{100.0};
+    for (int i = 0; i < 999; ++i) {
+        double next = prices.back() * (1.0 + Random::getDouble(-0.03, 0.03));
+        prices.push_back(i % 7 == 0 ? prices.back() : next);
+    }
+    prices.push_back(-0.0);
+    prices.push_back(std::numeric_limits<double>::infinity());
+    prices.push_back(std::numeric_limits<double>::denorm_min());
+    prices.push_back(0.01);
+
+    std::string bytes = Compression::encodeDoubles(prices);
+    EXPECT_LT(bytes.size(), prices.size() * sizeof(double));
+
+    std::vector<double> decoded;
+    ASSERT_TRUE(Compression::decodeDoubles(bytes, prices.size(), decoded));
+    ASSERT_EQ(decoded.size(), prices.size());
+    for (size_t i = 0; i < prices.size(); ++i) {
+        EXPECT_EQ(std::signbit(decoded[i]), std::signbit(prices[i]));
+        EXPECT_EQ(decoded[i], prices[i]) << i;
+    }
+
+    // A series that repeats compresses to about a bit per value.
+    std::vector<double> flat(800, 42.5);
+    EXPECT_LE(Compression::encodeDoubles(flat).size(), 8u + 100u + 1u);
+
+    EXPECT_FALSE(Compression::decodeDoubles(bytes.substr(0, bytes.size() / 2), prices.size(), decoded));
+    EXPECT_FALSE(Compression::decodeDoubles(bytes, std::numeric_limits<size_t>::max(), decoded));
+    EXPECT_FALSE(Compression::decodeDoubles(bytes, bytes.size() * 8 + 8, decoded));
+}
+
+TEST(CompressionTest, LzStreamsRoundTripAcrossBlocks) {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += "{\"ticker\":\"TCH\",\"day\":" + std::to_string(i) + ",\"headline\":\"Markets rally\"}\n";
+    }
+
+    std::ostringstream out;
+    {
+        LzEncoder encoder(out, 4096);
+        for (size_t i = 0; i < text.size(); i += 1000) {
+            encoder.write(text.substr(i, 1000));
+        }
+    }
+    std::string compressed = out.str();
+    EXPECT_LT(compressed.size(), text.size() / 4);
+
+    std::istringstream in(compressed);
+    LzDecoder decoder(in);
+    std::string restored;
+    std::string chunk;
+    size_t blocks = 0;
+    while (decoder.read(chunk)) {
+        restored += chunk;
+        ++blocks;
+    }
+    EXPECT_TRUE(decoder.getLastError().empty()) << decoder.getLastError();
+    EXPECT_GT(blocks, 1u);
+    EXPECT_EQ(restored, text);
+
+    std::string incompressible;
+    Random::initialize(9);
+    for (int i = 0; i < 5000; ++i) {
+        incompressible.push_back(static_cast<char>(Random::getInt(0, 255)));
+    }
+    std::string roundTrip;
+    ASSERT_TRUE(Compression::decompressText(Compression::compressText(incompressible), roundTrip));
+    EXPECT_EQ(roundTrip, incompressible);
+    ASSERT_TRUE(Compression::decompressText(Compression::compressText(""), roundTrip));
+    EXPECT_TRUE(roundTrip.empty());
+}
+
+TEST(CompressionTest, RejectsDamagedInput) {
+    std::string compressed = Compression::compressText(std::string(3000, 'a') + "tail");
+    std::string text;
+    EXPECT_FALSE(Compression::decompressText(compressed.substr(0, compressed.size() - 3), text));
+
+    std::string raw = Compression::compressBlock("abcdabcdabcdabcd");
+    std::string block;
+    EXPECT_TRUE(Compression::decompressBlock(raw, 16, block));
+    EXPECT_FALSE(Compression::decompressBlock(raw, 15, block));
+    EXPECT_FALSE(Compression::decompressBlock(std::string("\x0F\x00\x00", 3), 64, block));
+
+    std::string bytes;
+    EXPECT_FALSE(Compression::fromBase64("abc", bytes));
+    EXPECT_FALSE(Compression::fromBase64("ab=c", bytes));
+}
+
+TEST(CompressionTest, PacksJsonAndPriceSeries) {
+    for (std::string bytes : {std::string(), std::string("f"), std::string("fo"), std::string("foo\xff\x00", 5)}) {
+        std::string decoded;
+        ASSERT_TRUE(Compression::fromBase64(Compression::toBase64(bytes), decoded));
+        EXPECT_EQ(decoded, bytes);
+    }
+    EXPECT_EQ(Compression::toBase64("foob"), "Zm9vYg==");
+
+    nlohmann::json news = nlohmann::json::array();
+    for (int i = 0; i < 50; ++i) {
+        news.push_back({{"title", "Sector outlook improves"}, {"impact", 0.02 * i}, {"processed", i % 2 == 0}});
+    }
+    nlohmann::json packed = Compression::packJson(news);
+    EXPECT_EQ(packed["codec"], "lz");
+    EXPECT_LT(packed.dump().size(), news.dump().size());
+
+    nlohmann::json unpacked;
+    ASSERT_TRUE(Compression::unpackJson(packed, unpacked));
+    EXPECT_EQ(unpacked, news);
+    ASSERT_TRUE(Compression::unpackJson(news, unpacked));
+    EXPECT_EQ(unpacked, news);
+
+    std::vector<double> series{10.0, 10.25, 10.25, 9.75};
+    std::vector<double> values;
+    ASSERT_TRUE(Compression::unpackDoubles(Compression::packDoubles(series), values));
+    EXPECT_EQ(values, series);
+    ASSERT_TRUE(Compression::unpackDoubles(nlohmann::json(series), values));
+    EXPECT_EQ(values, series);
+    EXPECT_FALSE(Compression::unpackDoubles(nlohmann::json("nope"), values));
+
+    nlohmann::json oversized = Compression::packDoubles(series);
+    oversized["count"] = 1ull << 60;
+    EXPECT_FALSE(Compression::unpackDoubles(oversized, values));
+    oversized["count"] = -1;
+    EXPECT_FALSE(Compression::unpackDoubles(oversized, values));
+}
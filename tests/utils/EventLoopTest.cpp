@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "../../src/utils/EventLoop.hpp"
+
+using namespace StockMarketSimulator;
+
+class EventLoopTest : public ::testing::Test {
+protected:
+    int fds[2];
+
+    void SetUp() override {
+        ASSERT_EQ(pipe(fds), 0);
+    }
+
+    void TearDown() override {
+        close(fds[0]);
+        if (fds[1] >= 0) {
+            close(fds[1]);
+        }
+    }
+};
+
+TEST_F(EventLoopTest, DispatchesKeysUntilHandlerStops) {
+    ASSERT_EQ(write(fds[1], "abq", 3), 3);
+
+    EventLoop loop(fds[0]);
+    std::vector<int> keys;
+    loop.run([&keys](int key) {
+        keys.push_back(key);
+        return key != 'q';
+    });
+
+    EXPECT_EQ(keys, (std::vector<int>{'a', 'b', 'q'}));
+    EXPECT_FALSE(loop.isRunning());
+}
+
+TEST_F(EventLoopTest, TicksFireAtInterval) {
+    EventLoop loop(fds[0]);
+    loop.setTickInterval(5);
+
+    int ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    loop.run([](int) { return true; },
+             [&ticks]() { return ++ticks < 3; });
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(ticks, 3);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(10));
+}
+
+TEST_F(EventLoopTest, CrossThreadPostWakesIdleLoop) {
+    EventLoop loop(fds[0]);
+    std::thread::id loopThread;
+    bool posted = false;
+
+    std::thread producer([&loop, &posted, &loopThread]() {
+        while (!loop.isRunning()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        posted = EventLoop::postToCurrent([&loop, &loopThread]() {
+            loopThread = std::this_thread::get_id();
+            loop.stop();
+        });
+    });
+
+    loop.run([](int) { return true; });
+    producer.join();
+
+    EXPECT_TRUE(posted);
+    EXPECT_EQ(loopThread, std::this_thread::get_id());
+    EXPECT_FALSE(EventLoop::postToCurrent([]() {}));
+}
+
+TEST_F(EventLoopTest, ClosedInputStopsLoop) {
+    ASSERT_EQ(write(fds[1], "a", 1), 1);
+    close(fds[1]);
+    fds[1] = -1;
+
+    EventLoop loop(fds[0]);
+    bool watchdogFired = false;
+    std::thread watchdog([&loop, &watchdogFired]() {
+        for (int i = 0; i < 200 && !loop.isRunning(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // Only reached if end of input did not stop the loop on its own.
+        for (int i = 0; i < 200; ++i) {
+            if (!loop.isRunning()) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        watchdogFired = true;
+        loop.stop();
+    });
+
+    std::vector<int> keys;
+    loop.run([&keys](int key) { keys.push_back(key); return true; });
+    watchdog.join();
+
+    EXPECT_FALSE(watchdogFired);
+    EXPECT_EQ(keys, (std::vector<int>{'a'}));
+}
+
+TEST_F(EventLoopTest, NestedLoopWithoutWakeHandlerForwardsWakeups) {
+    ASSERT_EQ(write(fds[1], "q", 1), 1);
+
+    EventLoop outer(EventLoop::NO_INPUT);
+    outer.setTickInterval(50);
+
+    int outerWakes = 0;
+    outer.setWakeHandler([&outer, &outerWakes]() {
+        if (++outerWakes == 2) {
+            outer.stop();
+        }
+    });
+
+    outer.post([this]() {
+        EventLoop inner(fds[0]);
+        inner.post([]() { EventLoop::signalWake(); });
+        inner.run([](int key) { return key != 'q'; });
+    });
+    outer.run([](int) { return true; },
+              []() { return false; });
+
+    // Once for the post that started the inner loop, once forwarded from it
+    EXPECT_EQ(outerWakes, 2);
+}
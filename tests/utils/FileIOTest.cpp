@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../../src/utils/FileIO.hpp"
+#include <cstdio>
+#include <unistd.h>
 
 using namespace StockMarketSimulator;
 
@@ -11,6 +13,9 @@ protected:
     }
 
     void TearDown() override {
+        for (const auto& file : FileIO::listFiles(testDir)) {
+            std::remove(FileIO::combineFilePath(testDir, file).c_str());
+        }
     }
 
     std::string testDir;
@@ -40,6 +45,59 @@ TEST_F(FileIOTest, ReadWriteTextFileTest) {
     ASSERT_THROW(FileIO::readTextFile(nonExistentFile), std::runtime_error);
 }
 
+TEST_F(FileIOTest, ReadWriteCompressedTextFileTest) {
+    std::string testFile = FileIO::combineFilePath(testDir, "test.txt.lz");
+    std::string content;
+    for (int i = 0; i < 500; ++i) {
+        content += "row " + std::to_string(i % 20) + ", repeated payload\n";
+    }
+
+    FileIO::writeCompressedTextFile(testFile, content);
+
+    ASSERT_LT(FileIO::readTextFile(testFile).size(), content.size());
+    ASSERT_EQ(FileIO::readCompressedTextFile(testFile), content);
+
+    FileIO::writeTextFile(testFile, "not compressed");
+    ASSERT_THROW(FileIO::readCompressedTextFile(testFile), std::runtime_error);
+    std::remove(testFile.c_str());
+}
+
+TEST_F(FileIOTest, WriteFilesAtomicallyTest) {
+    std::string first = FileIO::combineFilePath(testDir, "atomic.json");
+    std::string second = FileIO::combineFilePath(testDir, "atomic.json.meta");
+
+    // Temporaries are uniquely named, so a leftover with a fixed name is
+    // neither reused nor clobbered.
+    std::string leftover = first + ".tmp";
+    FileIO::writeTextFile(leftover, "another writer");
+
+    FileIO::writeTextFile(first, "old contents");
+    for (Durability durability : {Durability::Atomic, Durability::Data, Durability::Full}) {
+        FileIO::writeFilesAtomically({{first, "new contents"}, {second, "{}"}}, durability);
+
+        ASSERT_EQ(FileIO::readTextFile(first), "new contents");
+        ASSERT_EQ(FileIO::readTextFile(second), "{}");
+        ASSERT_EQ(FileIO::listFiles(testDir).size(), 3u);
+    }
+    ASSERT_EQ(FileIO::readTextFile(leftover), "another writer");
+    std::remove(leftover.c_str());
+
+    // A rename that fails leaves the target untouched and no temporary behind.
+    std::string blocked = FileIO::combineFilePath(testDir, "atomic_blocked");
+    FileIO::createDirectory(blocked);
+    FileIO::createDirectory(FileIO::combineFilePath(blocked, "child"));
+    ASSERT_THROW(FileIO::writeFileAtomically(blocked, "contents"), std::runtime_error);
+    ASSERT_TRUE(FileIO::directoryExists(blocked));
+    for (const auto& file : FileIO::listFiles(testDir)) {
+        ASSERT_EQ(file.find("atomic_blocked.tmp"), std::string::npos) << file;
+    }
+
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+    rmdir(FileIO::combineFilePath(blocked, "child").c_str());
+    rmdir(blocked.c_str());
+}
+
 TEST_F(FileIOTest, ReadWriteJsonFileTest) {
     std::string testFile = FileIO::combineFilePath(testDir, "test.json");
 
@@ -93,4 +151,20 @@ TEST_F(FileIOTest, DataDirectoriesTest) {
     ASSERT_FALSE(FileIO::getSavesDirectory().empty());
 
     ASSERT_EQ(FileIO::getSavesDirectory(), FileIO::combineFilePath(FileIO::getDataDirectory(), "saves"));
-}
\ No newline at end of file
+}
+TEST_F(FileIOTest, LogFileCanBeRedirectedOrDisabledTest) {
+    std::string logFile = FileIO::combineFilePath(testDir, "run.log");
+
+    FileIO::setLogFile(logFile);
+    FileIO::clearLog();
+    FileIO::appendToLog("first");
+    FileIO::appendToLog("second");
+    EXPECT_EQ(FileIO::readTextFile(logFile), "first\nsecond\n");
+
+    FileIO::setLogFile("");
+    FileIO::clearLog();
+    FileIO::appendToLog("dropped");
+    EXPECT_EQ(FileIO::readTextFile(logFile), "first\nsecond\n");
+
+    FileIO::setLogFile("log.txt");
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../../src/utils/JsonStreamReader.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(JsonStreamReaderTest, RoutesValuesAndKeepsTheRest) {
+    std::istringstream input(R"({"a": {"items": [1, {"x": 2}, [3]], "keep": true}, "b": "text", "items": [4]})");
+
+    JsonStreamReader reader;
+    std::vector<nlohmann::json> items;
+    std::vector<nlohmann::json> sections;
+    reader.onValue({"a", "items", "*"}, [&items](nlohmann::json& value) {
+        items.push_back(std::move(value));
+    });
+    reader.onValue({"b"}, [&sections](nlohmann::json& value) {
+        sections.push_back(std::move(value));
+    });
+
+    nlohmann::json remainder;
+    ASSERT_TRUE(reader.parse(input, remainder)) << reader.getLastError();
+
+    ASSERT_EQ(items.size(), 3u);
+    EXPECT_EQ(items[0], 1);
+    EXPECT_EQ(items[1]["x"], 2);
+    EXPECT_EQ(items[2], nlohmann::json::array({3}));
+    ASSERT_EQ(sections.size(), 1u);
+    EXPECT_EQ(sections[0], "text");
+
+    EXPECT_EQ(remainder, nlohmann::json::parse(R"({"a": {"items": [], "keep": true}, "items": [4]})"));
+}
+
+TEST(JsonStreamReaderTest, ReportsParseErrors) {
+    std::istringstream input(R"({"a": [1, 2)");
+
+    JsonStreamReader reader;
+    nlohmann::json remainder;
+    EXPECT_FALSE(reader.parse(input, remainder));
+    EXPECT_FALSE(reader.getLastError().empty());
+    EXPECT_FALSE(reader.parseFile("missing/file.json", remainder));
+}
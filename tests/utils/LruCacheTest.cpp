@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/utils/LruCache.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(LruCacheTest, InsertAndFindTest) {
+    LruCache<int, std::string> cache(4);
+
+    EXPECT_EQ(cache.find(1), nullptr);
+
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), "one");
+    EXPECT_EQ(*cache.find(2), "two");
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsedTest) {
+    LruCache<int, std::string> cache(2);
+
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+
+    // Touch 1 so that 2 becomes the eviction candidate
+    cache.find(1);
+    cache.insert(3, "three");
+
+    EXPECT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(cache.find(2), nullptr);
+    EXPECT_NE(cache.find(3), nullptr);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(LruCacheTest, OverwriteExistingKeyTest) {
+    LruCache<int, std::string> cache(2);
+
+    cache.insert(1, "one");
+    cache.insert(1, "uno");
+
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(*cache.find(1), "uno");
+}
+
+TEST(LruCacheTest, CopyIsIndependentTest) {
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+
+    LruCache<int, std::string> copy = cache;
+    copy.insert(2, "two");
+    copy.insert(3, "three");
+
+    EXPECT_EQ(*cache.find(1), "one");
+    EXPECT_EQ(cache.find(3), nullptr);
+    EXPECT_EQ(copy.find(1), nullptr);
+    EXPECT_EQ(*copy.find(3), "three");
+}
+
+TEST(LruCacheTest, ClearTest) {
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.clear();
+
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.find(1), nullptr);
+
+    cache.insert(2, "two");
+    EXPECT_EQ(*cache.find(2), "two");
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include "../../src/utils/PersistentVector.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(PersistentVectorTest, AppendIndexAndIterate) {
+    PersistentVector<int, 4> values;
+    EXPECT_TRUE(values.empty());
+
+    for (int i = 0; i < 10; ++i) {
+        values.push_back(i);
+    }
+
+    ASSERT_EQ(values.size(), 10u);
+    EXPECT_EQ(values.front(), 0);
+    EXPECT_EQ(values.back(), 9);
+    EXPECT_EQ(values[5], 5);
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 45);
+    EXPECT_EQ(values.end() - values.begin(), 10);
+    EXPECT_EQ(values.toVector(), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(PersistentVectorTest, CopiesShareUntilWritten) {
+    PersistentVector<int, 4> original;
+    for (int i = 0; i < 10; ++i) {
+        original.push_back(i);
+    }
+
+    PersistentVector<int, 4> branch = original;
+    EXPECT_TRUE(branch.sharesChunkWith(original, 0));
+    EXPECT_TRUE(branch.sharesChunkWith(original, 9));
+
+    branch.push_back(10);
+    branch.mutate(1) = 100;
+
+    EXPECT_EQ(original.size(), 10u);
+    EXPECT_EQ(original[1], 1);
+    EXPECT_EQ(branch.size(), 11u);
+    EXPECT_EQ(branch[1], 100);
+
+    // Only the chunks that were written diverge.
+    EXPECT_FALSE(branch.sharesChunkWith(original, 1));
+    EXPECT_TRUE(branch.sharesChunkWith(original, 4));
+    EXPECT_FALSE(branch.sharesChunkWith(original, 9));
+
+    original.push_back(-1);
+    EXPECT_EQ(original[10], -1);
+    EXPECT_EQ(branch[10], 10);
+}
+
+TEST(PersistentVectorTest, DropFrontKeepsOrder) {
+    PersistentVector<int, 4> values({1, 2, 3, 4, 5, 6, 7, 8, 9});
+    PersistentVector<int, 4> snapshot = values;
+
+    values.dropFront(5);
+    ASSERT_EQ(values.size(), 4u);
+    EXPECT_EQ(values.front(), 6);
+    values.push_back(10);
+    EXPECT_EQ(values.toVector(), std::vector<int>({6, 7, 8, 9, 10}));
+    EXPECT_EQ(snapshot.size(), 9u);
+    EXPECT_EQ(snapshot.front(), 1);
+
+    values.dropFront(100);
+    EXPECT_TRUE(values.empty());
+    values.push_back(42);
+    EXPECT_EQ(values[0], 42);
+}
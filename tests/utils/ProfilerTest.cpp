@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../../src/utils/Profiler.hpp"
+
+using namespace StockMarketSimulator;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Profiler::reset();
+    }
+
+    void TearDown() override {
+        Profiler::reset();
+    }
+};
+
+TEST_F(ProfilerTest, HistogramTracksDistribution) {
+    TimingHistogram histogram;
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(1000);
+    }
+    histogram.record(1000000);
+
+    EXPECT_EQ(histogram.count, 100u);
+    EXPECT_EQ(histogram.minNanoseconds, 1000u);
+    EXPECT_EQ(histogram.maxNanoseconds, 1000000u);
+    EXPECT_NEAR(histogram.getMeanNanoseconds(), (99 * 1000.0 + 1000000.0) / 100.0, 1e-9);
+
+    // 1000 ns falls in the [512, 1024) bucket
+    EXPECT_EQ(histogram.getPercentileNanoseconds(0.5), 1023u);
+    EXPECT_EQ(histogram.getPercentileNanoseconds(0.995), 1000000u);
+}
+
+TEST_F(ProfilerTest, RecordsNamedStages) {
+    Profiler::record("stage.a", 500);
+    Profiler::record("stage.a", 1500);
+    Profiler::record("stage.b", 10);
+
+    auto snapshot = Profiler::snapshot();
+    ASSERT_EQ(snapshot.size(), 2u);
+    EXPECT_EQ(snapshot["stage.a"].count, 2u);
+    EXPECT_EQ(snapshot["stage.a"].totalNanoseconds, 2000u);
+
+    nlohmann::json json = Profiler::toJson();
+    EXPECT_EQ(json["stage.b"]["count"], 1);
+    EXPECT_TRUE(json["stage.a"].contains("p99_ns"));
+
+    EXPECT_NE(Profiler::report().find("stage.b"), std::string::npos);
+}
+
+TEST_F(ProfilerTest, ScopedTimerRecordsElapsedTime) {
+    {
+        ScopedTimer timer("scoped");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    auto snapshot = Profiler::snapshot();
+    ASSERT_EQ(snapshot.count("scoped"), 1u);
+    EXPECT_GE(snapshot["scoped"].totalNanoseconds, 2000000u);
+}
+
+TEST_F(ProfilerTest, ProfileScopeIsASingleDeclaration) {
+    bool profiled = true;
+    if (profiled)
+        SMP_PROFILE_SCOPE("single.statement");
+
+    {
+        ProfileScope scope("profile.scope", AllocationTracker::UNTAGGED);
+    }
+
+    auto snapshot = Profiler::snapshot();
+#ifdef SMP_PROFILING
+    EXPECT_EQ(snapshot.count("profile.scope"), 1u);
+#else
+    EXPECT_EQ(snapshot.count("profile.scope"), 0u);
+#endif
+}
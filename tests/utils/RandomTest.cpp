@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../../src/utils/Random.hpp"
+#include <thread>
 
 using namespace StockMarketSimulator;
 
@@ -146,4 +147,24 @@ TEST(RandomTest, ShuffleTest) {
     }
 
     ASSERT_TRUE(orderChanged);
-}
\ No newline at end of file
+}
+TEST(RandomTest, ScopedGeneratorTest) {
+    Random::initialize(42);
+    int expected = Random::getInt(0, 1000000);
+
+    Random::initialize(42);
+    std::vector<int> fromThreads(2);
+    std::thread worker([&fromThreads] {
+        Random::ScopedGenerator generator(7);
+        fromThreads[0] = Random::getInt(0, 1000000);
+    });
+    worker.join();
+    {
+        Random::ScopedGenerator generator(7);
+        fromThreads[1] = Random::getInt(0, 1000000);
+    }
+
+    // The scoped draws are reproducible and leave the shared generator untouched.
+    EXPECT_EQ(fromThreads[0], fromThreads[1]);
+    EXPECT_EQ(Random::getInt(0, 1000000), expected);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "../../src/utils/SectionedJsonFile.hpp"
+#include "../../src/utils/FileIO.hpp"
+
+using namespace StockMarketSimulator;
+
+class SectionedJsonFileTest : public ::testing::Test {
+protected:
+    std::string filePath = "sectioned_test.json";
+
+    void TearDown() override {
+        std::remove(filePath.c_str());
+    }
+
+    void writeSample() {
+        SectionedJsonWriter writer;
+        writer.addSection("version", 2);
+        writer.addSection("meta", {{"name", "sample \"quoted\""}, {"days", 12}});
+        writer.beginArray("series");
+        writer.addElement("A", {{"id", "A"}, {"values", {1.5, 2.5}}});
+        writer.addElement("B", {{"id", "B"}, {"values", nlohmann::json::array()}});
+        writer.endArray();
+        FileIO::writeTextFile(filePath, writer.finish());
+    }
+};
+
+TEST_F(SectionedJsonFileTest, FileIsPlainJsonWithAddressableSections) {
+    writeSample();
+
+    nlohmann::json whole = FileIO::readJsonFile(filePath);
+    EXPECT_EQ(whole["version"], 2);
+    EXPECT_EQ(whole["series"].size(), 2u);
+    EXPECT_TRUE(whole.contains("section_toc"));
+
+    SectionedJsonReader reader;
+    ASSERT_TRUE(reader.open(filePath)) << reader.getLastError();
+    EXPECT_TRUE(reader.hasSection("series/B"));
+    EXPECT_FALSE(reader.hasSection("missing"));
+
+    nlohmann::json value;
+    ASSERT_TRUE(reader.readSection("meta", value));
+    EXPECT_EQ(value, whole["meta"]);
+    ASSERT_TRUE(reader.readSection("series/A", value));
+    EXPECT_EQ(value["values"][1], 2.5);
+    ASSERT_TRUE(reader.readSection("series", value));
+    EXPECT_EQ(value, whole["series"]);
+    EXPECT_FALSE(reader.readSection("missing", value));
+}
+
+TEST_F(SectionedJsonFileTest, RejectsPlainAndTruncatedFiles) {
+    FileIO::writeJsonFile(filePath, {{"version", 1}}, false);
+    EXPECT_FALSE(SectionedJsonReader::isSectioned(filePath));
+
+    SectionedJsonReader reader;
+    EXPECT_FALSE(reader.open(filePath));
+
+    writeSample();
+    EXPECT_TRUE(SectionedJsonReader::isSectioned(filePath));
+    std::string text = FileIO::readTextFile(filePath);
+    FileIO::writeTextFile(filePath, text.substr(0, text.size() / 2));
+    EXPECT_FALSE(reader.open(filePath));
+    EXPECT_FALSE(reader.getLastError().empty());
+
+    EXPECT_FALSE(reader.open("missing/sectioned.json"));
+}
+
+TEST_F(SectionedJsonFileTest, KeepsReadingTheFileItOpened) {
+    writeSample();
+
+    SectionedJsonReader reader;
+    ASSERT_TRUE(reader.open(filePath)) << reader.getLastError();
+
+    FileIO::writeFileAtomically(filePath, "{\"replaced\":true}");
+    nlohmann::json value;
+    ASSERT_TRUE(reader.readSection("series/A", value));
+    EXPECT_EQ(value["values"][1], 2.5);
+
+    std::remove(filePath.c_str());
+    ASSERT_TRUE(reader.readSection("meta", value));
+    EXPECT_EQ(value["days"], 12);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "../../src/utils/TaskGraph.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(TaskGraphTest, DependenciesRunInOrder) {
+    WorkStealingPool pool(4);
+    TaskGraph graph;
+
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(name);
+        };
+    };
+
+    size_t a = graph.addTask("a", record("a"));
+    size_t b = graph.addTask("b", record("b"));
+    size_t c = graph.addTask("c", record("c"), {a, b});
+    graph.addTask("d", record("d"), {c});
+
+    graph.run(pool);
+
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[2], "c");
+    EXPECT_EQ(order[3], "d");
+}
+
+TEST(TaskGraphTest, RecordsTimingsPerStage) {
+    TaskGraph graph;
+    graph.addTask("first", [] {});
+    graph.addTask("second", [] {}, {0});
+
+    graph.runSequential();
+
+    const auto& timings = graph.getTimings();
+    ASSERT_EQ(timings.size(), 2u);
+    EXPECT_EQ(timings[0].name, "first");
+    EXPECT_EQ(timings[1].name, "second");
+    EXPECT_GE(timings[1].milliseconds, 0.0);
+}
+
+TEST(TaskGraphTest, IndependentTasksRunConcurrently) {
+    WorkStealingPool pool(2);
+    TaskGraph graph;
+
+    std::atomic<int> arrived(0);
+    auto rendezvous = [&] {
+        arrived++;
+        while (arrived < 2) {
+            std::this_thread::yield();
+        }
+    };
+
+    graph.addTask("left", rendezvous);
+    graph.addTask("right", rendezvous);
+
+    graph.run(pool);
+    EXPECT_EQ(arrived.load(), 2);
+}
+
+TEST(TaskGraphTest, FailureSkipsDependentsAndRethrows) {
+    WorkStealingPool pool(2);
+    TaskGraph graph;
+    bool dependentRan = false;
+
+    size_t failing = graph.addTask("failing", [] { throw std::runtime_error("stage failed"); });
+    graph.addTask("dependent", [&] { dependentRan = true; }, {failing});
+
+    EXPECT_THROW(graph.run(pool), std::runtime_error);
+    EXPECT_FALSE(dependentRan);
+}
+
+TEST(TaskGraphTest, RejectsUnknownDependencies) {
+    TaskGraph graph;
+    EXPECT_THROW(graph.addTask("orphan", [] {}, {3}), std::invalid_argument);
+}
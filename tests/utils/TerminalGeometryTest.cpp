@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <unistd.h>
+#include "../../src/utils/TerminalGeometry.hpp"
+#include "../../src/utils/EventLoop.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(TerminalGeometryTest, CachesSizeUntilRefreshed) {
+    TerminalGeometry::setSize(120, 40);
+    EXPECT_EQ(TerminalGeometry::getSize(), std::make_pair(120, 40));
+
+    TerminalGeometry::setSize(0, -5);
+    EXPECT_EQ(TerminalGeometry::getSize(),
+              std::make_pair(TerminalGeometry::DEFAULT_COLUMNS, TerminalGeometry::DEFAULT_ROWS));
+
+    TerminalGeometry::refresh();
+    auto size = TerminalGeometry::getSize();
+    EXPECT_GT(size.first, 0);
+    EXPECT_GT(size.second, 0);
+}
+
+TEST(TerminalGeometryTest, ResizeSignalWakesRunningLoopOnce) {
+    TerminalGeometry::installResizeHandler();
+    TerminalGeometry::consumeResize();
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    EventLoop loop(fds[0]);
+    int resizes = 0;
+    loop.setWakeHandler([&loop, &resizes]() {
+        if (TerminalGeometry::consumeResize()) {
+            ++resizes;
+        }
+        loop.stop();
+    });
+    loop.post([]() {
+        raise(SIGWINCH);
+        raise(SIGWINCH);
+    });
+    loop.run([](int) { return true; });
+
+    EXPECT_EQ(resizes, 1);
+    EXPECT_FALSE(TerminalGeometry::consumeResize());
+
+    close(fds[0]);
+    close(fds[1]);
+}
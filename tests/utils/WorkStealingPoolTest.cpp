@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "../../src/utils/WorkStealingPool.hpp"
+#include "../../src/utils/RandomStream.hpp"
+
+using namespace StockMarketSimulator;
+
+TEST(WorkStealingPoolTest, ParallelForVisitsEveryIndexOnce) {
+    WorkStealingPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    pool.parallelFor(0, visits.size(), 7, [&](size_t i) {
+        visits[i]++;
+    });
+
+    for (const auto& count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(WorkStealingPoolTest, NestedParallelForCompletes) {
+    WorkStealingPool pool(2);
+    std::atomic<int> total(0);
+
+    pool.parallelFor(0, 8, 1, [&](size_t) {
+        pool.parallelFor(0, 100, 10, [&](size_t) {
+            total++;
+        });
+    });
+
+    EXPECT_EQ(total.load(), 800);
+}
+
+TEST(WorkStealingPoolTest, CallerRunsTasksWithoutWorkers) {
+    WorkStealingPool pool(0);
+    int sum = 0;
+
+    pool.parallelFor(0, 10, 3, [&](size_t i) {
+        sum += static_cast<int>(i);
+    });
+
+    EXPECT_EQ(pool.getThreadCount(), 0);
+    EXPECT_EQ(sum, 45);
+}
+
+TEST(WorkStealingPoolTest, ParallelForRethrowsExceptions) {
+    WorkStealingPool pool(3);
+
+    EXPECT_THROW(pool.parallelFor(0, 50, 5, [](size_t i) {
+        if (i == 17) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(WorkStealingPoolTest, DerivedStreamsAreReproducible) {
+    RandomStream first = RandomStream::derive(42, 10, RandomStream::keyFor("TCH"), 1);
+    RandomStream second = RandomStream::derive(42, 10, RandomStream::keyFor("TCH"), 1);
+    RandomStream otherDay = RandomStream::derive(42, 11, RandomStream::keyFor("TCH"), 1);
+
+    uint64_t value = first();
+    EXPECT_EQ(value, second());
+    EXPECT_NE(value, otherDay());
+    EXPECT_DOUBLE_EQ(first.getNormal(0.0, 1.0), second.getNormal(0.0, 1.0));
+}